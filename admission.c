@@ -0,0 +1,187 @@
+#include <stdlib.h>
+#include "admission.h"
+#include "schema.h"
+
+/**
+ * @brief Returns non-zero if the policy can turn any process away.
+ */
+int admissionEnabled(const AdmissionPolicy *policy) {
+    return policy->max_in_system > 0 || policy->max_wait > 0 || policy->deadlines;
+}
+
+/**
+ * @brief Round Robin state shared by the admission checks.
+ */
+typedef struct {
+    int *queue, front, rear, size;  ///< Ready queue (ring of n slots).
+    int *deferred, dfront, dsize;   ///< Deferred processes in arrival order (ring of n slots).
+    int in_system;                  ///< Admitted processes not finished yet.
+    long long backlog;              ///< Remaining work of those processes.
+    int n;
+} AdmissionState;
+
+/**
+ * @brief Admits process i if the cap and the wait threshold allow it.  O(1).
+ *
+ * @return 1 if admitted, 0 if the cap or the threshold was hit, -1 if dropped for its deadline.
+ */
+static int tryAdmit(AdmissionState *s, Process processes[], int i, int now, const AdmissionPolicy *policy) {
+    Process *p = &processes[i];
+    if (policy->deadlines && p->deadline != NO_DEADLINE && now + s->backlog + p->burst > p->deadline)
+        return -1;
+    if (policy->max_in_system > 0 && s->in_system >= policy->max_in_system)
+        return 0;
+    if (policy->max_wait > 0 && s->backlog > policy->max_wait)
+        return 0;
+
+    s->rear = (s->rear + 1) % s->n;
+    s->queue[s->rear] = i;
+    s->size++;
+    s->in_system++;
+    s->backlog += p->burst;
+    return 1;
+}
+
+/**
+ * @brief Offers a process at time now, then defers or drops it if it is not admitted.
+ */
+static void offer(AdmissionState *s, Process processes[], int i, int now, const AdmissionPolicy *policy,
+                  AdmissionStats *stats) {
+    // Later arrivals queue behind deferred processes so deferral stays first come, first served.
+    int outcome = s->dsize > 0 ? 0 : tryAdmit(s, processes, i, now, policy);
+    if (outcome == 1)
+        return;
+    if (outcome == 0 && policy->action == ADMIT_DEFER) {
+        s->deferred[(s->dfront + s->dsize++) % s->n] = i;
+        return;
+    }
+
+    if (outcome < 0)
+        stats->rejected_deadline++;
+    else if (policy->max_in_system > 0 && s->in_system >= policy->max_in_system)
+        stats->rejected_queue++;
+    else
+        stats->rejected_wait++;
+}
+
+/**
+ * @brief Retries deferred processes in arrival order until one does not fit.
+ */
+static void admitDeferred(AdmissionState *s, Process processes[], int now, const AdmissionPolicy *policy,
+                          AdmissionStats *stats) {
+    while (s->dsize > 0) {
+        int i = s->deferred[s->dfront];
+        int outcome = tryAdmit(s, processes, i, now, policy);
+        if (outcome == 0)
+            return;
+        s->dfront = (s->dfront + 1) % s->n;
+        s->dsize--;
+        if (outcome > 0)
+            stats->deferred++;
+        else
+            stats->rejected_deadline++;
+    }
+}
+
+/**
+ * @brief Round Robin that admits, defers or drops each process when it arrives.
+ *
+ * @param processes An array of Process structures sorted by arrival.
+ * @param n The number of processes in the array.
+ * @param quantum The time quantum for the RR algorithm.
+ * @param policy The admission rules.
+ * @param stats Receives the admission outcome.
+ *
+ * @details
+ * The queue discipline is that of computeRR.  A process is checked when the
+ * scheduler first sees it, at the end of the slice during which it arrived.
+ * The predicted wait of a newcomer is the work still owed to the processes
+ * already admitted, which Round Robin must interleave with it; that sum and
+ * the number of admitted processes are maintained as processes are admitted
+ * and run, so each check is O(1).  With deadlines, a process is dropped when
+ * the check time plus that wait plus its own burst is past its deadline.
+ * Rejected processes keep start_time and finish_time at -1.
+ */
+void computeRRAdmission(Process processes[], int n, int quantum, const AdmissionPolicy *policy,
+                        AdmissionStats *stats) {
+    AdmissionState s = {0};
+    s.n = n;
+    s.rear = -1;
+    s.queue = malloc(n * sizeof(int));
+    s.deferred = malloc(n * sizeof(int));
+    int *remaining = malloc(n * sizeof(int));
+    if (n > 0 && (!s.queue || !s.deferred || !remaining)) {
+        perror("Error allocating RR state");
+        exit(EXIT_FAILURE);
+    }
+    for (int i = 0; i < n; i++) {
+        remaining[i] = processes[i].burst;
+        processes[i].start_time = -1;
+        processes[i].finish_time = -1;
+    }
+
+    *stats = (AdmissionStats){0};
+    stats->offered = n;
+    int current_time = 0, idx = 0;
+
+    for (;;) {
+        admitDeferred(&s, processes, current_time, policy, stats);
+        while (idx < n && processes[idx].arrival <= current_time)
+            offer(&s, processes, idx++, current_time, policy, stats);
+        if (s.size == 0) {
+            if (idx == n)
+                break;
+            current_time = processes[idx].arrival;
+            continue;
+        }
+
+        int proc_idx = s.queue[s.front];
+        s.front = (s.front + 1) % n;
+        s.size--;
+
+        if (processes[proc_idx].start_time == -1)
+            processes[proc_idx].start_time = current_time;
+        int exec_time = remaining[proc_idx] < quantum ? remaining[proc_idx] : quantum;
+        remaining[proc_idx] -= exec_time;
+        current_time += exec_time;
+        s.backlog -= exec_time;
+        if (remaining[proc_idx] == 0)
+            s.in_system--; // Finished now, so not counted by the checks at the end of its slice.
+
+        admitDeferred(&s, processes, current_time, policy, stats);
+        while (idx < n && processes[idx].arrival <= current_time)
+            offer(&s, processes, idx++, current_time, policy, stats);
+
+        if (remaining[proc_idx] > 0) {
+            s.rear = (s.rear + 1) % n;
+            s.queue[s.rear] = proc_idx;
+            s.size++;
+        } else {
+            Process *p = &processes[proc_idx];
+            p->finish_time = current_time;
+            stats->admitted++;
+            stats->on_time += p->deadline == NO_DEADLINE || p->finish_time <= p->deadline;
+            if (current_time > stats->makespan)
+                stats->makespan = current_time;
+        }
+    }
+
+    free(remaining);
+    free(s.deferred);
+    free(s.queue);
+}
+
+/**
+ * @brief Prints the admission outcome.
+ */
+void printAdmissionStats(const AdmissionStats *stats, FILE *out) {
+    int rejected = stats->rejected_queue + stats->rejected_wait + stats->rejected_deadline;
+    fprintf(out, "\nAdmission Control:\n");
+    fprintf(out, "Offered: %d, Admitted: %d (%d after deferral), Rejected: %d\n", stats->offered,
+            stats->admitted, stats->deferred, rejected);
+    fprintf(out, "Rejected by queue cap: %d, by predicted wait: %d, by deadline: %d\n",
+            stats->rejected_queue, stats->rejected_wait, stats->rejected_deadline);
+    fprintf(out, "Rejection Rate: %.2f%%\n", stats->offered ? 100.0 * rejected / stats->offered : 0.0);
+    fprintf(out, "Goodput: %.2f processes/ut (%d on time)\n",
+            stats->makespan ? (double)stats->on_time / stats->makespan : 0.0, stats->on_time);
+}
@@ -0,0 +1,44 @@
+#ifndef ADMISSION_H
+#define ADMISSION_H
+
+#include <stdio.h>
+#include "process.h"
+
+/**
+ * @brief What happens to a process turned away by the queue cap or the wait threshold.
+ */
+typedef enum {
+    ADMIT_DROP,  ///< It is rejected for good.
+    ADMIT_DEFER  ///< It waits outside the system and is retried in arrival order.
+} AdmissionAction;
+
+/**
+ * @brief Admission rules applied when a process arrives; 0 disables a limit.
+ */
+typedef struct {
+    int max_in_system;      ///< Cap on admitted, unfinished processes.
+    long long max_wait;     ///< Cap on the predicted wait (admitted unfinished work).
+    int deadlines;          ///< Non-zero to drop processes predicted to miss their deadline.
+    AdmissionAction action; ///< Fate of processes over the cap or the threshold.
+} AdmissionPolicy;
+
+/**
+ * @brief Outcome of a run under admission control.
+ */
+typedef struct {
+    int offered;            ///< Processes in the trace.
+    int admitted;           ///< Processes that ran.
+    int rejected_queue;     ///< Dropped by the cap on processes in the system.
+    int rejected_wait;      ///< Dropped by the predicted-wait threshold.
+    int rejected_deadline;  ///< Dropped because their deadline could not be met.
+    int deferred;           ///< Admitted only after waiting outside the system.
+    int on_time;            ///< Admitted processes that finished by their deadline (or had none).
+    int makespan;           ///< Finish time of the last admitted process.
+} AdmissionStats;
+
+int admissionEnabled(const AdmissionPolicy *policy);
+void computeRRAdmission(Process processes[], int n, int quantum, const AdmissionPolicy *policy,
+                        AdmissionStats *stats);
+void printAdmissionStats(const AdmissionStats *stats, FILE *out);
+
+#endif
@@ -0,0 +1,310 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "arrow.h"
+
+/*
+ * Apache Arrow IPC stream writer.
+ *
+ * A stream is a Schema message, any number of RecordBatch messages and an
+ * end-of-stream marker.  Each message is a continuation marker (0xFFFFFFFF), the
+ * padded size of its metadata, the metadata as a flatbuffer and the body.  The
+ * few flatbuffer tables needed are laid out by hand front to back: every object
+ * is written after the one referring to it, so all offsets point forward, and
+ * every vtable precedes its table.
+ */
+
+enum {
+    ARROW_METADATA_V5 = 4,     ///< MetadataVersion.V5.
+    ARROW_HEADER_SCHEMA = 1,   ///< MessageHeader.Schema.
+    ARROW_HEADER_BATCH = 3,    ///< MessageHeader.RecordBatch.
+    ARROW_TYPE_INT = 2,        ///< Type.Int.
+    ARROW_TYPE_UTF8 = 5        ///< Type.Utf8.
+};
+
+/**
+ * @brief The columns of the per-process results; all but the first are int32.
+ */
+static const char *const column_names[] = {"algorithm", "id", "arrival", "burst", "start",
+                                           "finish", "turnaround", "response", "wait"};
+#define ARROW_COLUMNS ((int)(sizeof(column_names) / sizeof(column_names[0])))
+#define ARROW_INT_COLUMNS (ARROW_COLUMNS - 1)
+
+/**
+ * @brief A flatbuffer under construction.
+ */
+typedef struct {
+    unsigned char data[ARROW_METADATA_MAX];
+    size_t len;
+} FlatBuilder;
+
+/**
+ * @brief Reserves size zeroed bytes at the first position p after the end with
+ *        p + skew aligned to align.
+ */
+static size_t fbAlloc(FlatBuilder *fb, size_t size, size_t align, size_t skew) {
+    size_t pos = (fb->len + skew + align - 1) / align * align - skew;
+    if (pos + size > sizeof(fb->data)) {
+        fprintf(stderr, "Arrow message header exceeds %d bytes\n", ARROW_METADATA_MAX);
+        exit(EXIT_FAILURE);
+    }
+    memset(fb->data + fb->len, 0, pos + size - fb->len);
+    fb->len = pos + size;
+    return pos;
+}
+
+static void fbPut(FlatBuilder *fb, size_t pos, const void *value, size_t size) {
+    memcpy(fb->data + pos, value, size);
+}
+
+/**
+ * @brief Stores at position at the forward offset to the object at target.
+ */
+static void fbLink(FlatBuilder *fb, size_t at, size_t target) {
+    uint32_t offset = (uint32_t)(target - at);
+    fbPut(fb, at, &offset, sizeof(offset));
+}
+
+/**
+ * @brief Writes a vtable and a table whose field i is sizes[i] bytes wide (0 if absent).
+ *
+ * @return The position of the table; field i is stored at field_pos[i].
+ */
+static size_t fbTable(FlatBuilder *fb, int count, const int sizes[], size_t field_pos[]) {
+    uint16_t vtable[2 + 8];
+    size_t inline_size = 4;
+    for (int i = 0; i < count; i++) {
+        vtable[2 + i] = 0;
+        if (sizes[i] == 0)
+            continue;
+        inline_size = (inline_size + sizes[i] - 1) / sizes[i] * sizes[i];
+        vtable[2 + i] = (uint16_t)inline_size;
+        inline_size += sizes[i];
+    }
+    vtable[0] = (uint16_t)((2 + count) * sizeof(uint16_t));
+    vtable[1] = (uint16_t)inline_size;
+
+    size_t vtable_pos = fbAlloc(fb, vtable[0], 2, 0);
+    fbPut(fb, vtable_pos, vtable, vtable[0]);
+    size_t table = fbAlloc(fb, inline_size, 8, 0);
+    int32_t soffset = (int32_t)(table - vtable_pos);
+    fbPut(fb, table, &soffset, sizeof(soffset));
+    for (int i = 0; i < count; i++)
+        field_pos[i] = table + vtable[2 + i];
+    return table;
+}
+
+/**
+ * @brief Writes the length of a vector of count elements.
+ *
+ * @return The position of the vector; its elements start 4 bytes later.
+ */
+static size_t fbVector(FlatBuilder *fb, uint32_t count, size_t elem_size, size_t align) {
+    size_t pos = fbAlloc(fb, 4 + count * elem_size, align < 4 ? 4 : align, 4);
+    fbPut(fb, pos, &count, sizeof(count));
+    return pos;
+}
+
+static size_t fbString(FlatBuilder *fb, const char *text) {
+    size_t len = strlen(text);
+    uint32_t count = (uint32_t)len;
+    size_t pos = fbVector(fb, count + 1, 1, 4); // Room for the NUL, which is not counted.
+    fbPut(fb, pos, &count, sizeof(count));
+    fbPut(fb, pos + 4, text, len);
+    return pos;
+}
+
+/**
+ * @brief Starts a Message: root offset and the Message table.
+ *
+ * @return The position of the header field, to be linked to the header table.
+ */
+static size_t fbMessage(FlatBuilder *fb, uint8_t header_type, int64_t body_length) {
+    static const int sizes[] = {2, 1, 4, 8}; // version, header_type, header, bodyLength
+    size_t field[4];
+    int16_t version = ARROW_METADATA_V5;
+
+    fb->len = 0;
+    size_t root = fbAlloc(fb, 4, 4, 0);
+    fbLink(fb, root, fbTable(fb, 4, sizes, field));
+    fbPut(fb, field[0], &version, sizeof(version));
+    fbPut(fb, field[1], &header_type, sizeof(header_type));
+    fbPut(fb, field[3], &body_length, sizeof(body_length));
+    return field[2];
+}
+
+/**
+ * @brief Writes the encapsulated metadata of a message, padded to ARROW_ALIGNMENT.
+ */
+static void putMetadata(BufferedWriter *writer, FlatBuilder *fb) {
+    static const char zeros[ARROW_ALIGNMENT] = {0};
+    uint32_t marker = 0xFFFFFFFFu;
+    int32_t size = (int32_t)((fb->len + ARROW_ALIGNMENT - 1) / ARROW_ALIGNMENT * ARROW_ALIGNMENT);
+    writerPutBytes(writer, &marker, sizeof(marker));
+    writerPutBytes(writer, &size, sizeof(size));
+    writerPutBytes(writer, fb->data, fb->len);
+    writerPutBytes(writer, zeros, (size_t)size - fb->len);
+}
+
+/**
+ * @brief Writes the Schema message of the per-process results.
+ *
+ * @details
+ * Every column is non-nullable: "algorithm" is utf8 and the others are signed
+ * 32-bit integers.  Buffers are in host byte order and the schema says which.
+ */
+void arrowWriteSchema(BufferedWriter *writer) {
+    static const int schema_sizes[] = {2, 4};             // endianness, fields
+    static const int field_sizes[] = {4, 1, 1, 4, 0, 4};  // name, nullable, type_type, type, dictionary, children
+    static const int int_sizes[] = {4, 1};                // bitWidth, is_signed
+    const uint16_t probe = 1;
+    int16_t endianness = *(const uint8_t *)&probe ? 0 : 1;
+    FlatBuilder fb;
+    size_t field[6];
+
+    size_t header = fbMessage(&fb, ARROW_HEADER_SCHEMA, 0);
+    size_t schema = fbTable(&fb, 2, schema_sizes, field);
+    fbLink(&fb, header, schema);
+    fbPut(&fb, field[0], &endianness, sizeof(endianness));
+    size_t fields_at = field[1];
+    size_t fields = fbVector(&fb, ARROW_COLUMNS, 4, 4);
+    fbLink(&fb, fields_at, fields);
+
+    for (int c = 0; c < ARROW_COLUMNS; c++) {
+        uint8_t type_type = c == 0 ? ARROW_TYPE_UTF8 : ARROW_TYPE_INT;
+        fbLink(&fb, fields + 4 + 4 * c, fbTable(&fb, 6, field_sizes, field));
+        fbPut(&fb, field[2], &type_type, sizeof(type_type));
+        size_t name_at = field[0], type_at = field[3], children_at = field[5];
+
+        fbLink(&fb, name_at, fbString(&fb, column_names[c]));
+        if (c == 0) {
+            fbLink(&fb, type_at, fbTable(&fb, 0, NULL, field));
+        } else {
+            int32_t bit_width = 32;
+            uint8_t is_signed = 1;
+            fbLink(&fb, type_at, fbTable(&fb, 2, int_sizes, field));
+            fbPut(&fb, field[0], &bit_width, sizeof(bit_width));
+            fbPut(&fb, field[1], &is_signed, sizeof(is_signed));
+        }
+        fbLink(&fb, children_at, fbVector(&fb, 0, 4, 4));
+    }
+
+    putMetadata(writer, &fb);
+}
+
+/**
+ * @brief Writes the results of one schedule as record batches of ARROW_BATCH_ROWS rows.
+ *
+ * @param writer The buffered writer of the dump.
+ * @param algorithm Short algorithm name stored in the "algorithm" column.
+ * @param processes An array of Process structures with start and finish times set.
+ * @param n The number of processes in the array.
+ *
+ * @details
+ * Each column of a batch is gathered from the process table into its own
+ * contiguous buffer in one tight loop and written out with a single copy, so
+ * the body is exactly the memory layout a reader maps.  Validity buffers are
+ * empty since nothing is null.
+ */
+void arrowWriteBatches(BufferedWriter *writer, const char *algorithm, const Process processes[], int n) {
+    static const int batch_sizes[] = {8, 4, 4}; // length, nodes, buffers
+    static const char zeros[ARROW_ALIGNMENT] = {0};
+    enum { BUFFERS = 3 + 2 * ARROW_INT_COLUMNS };
+    size_t name_len = strlen(algorithm);
+    int32_t *offsets = malloc((ARROW_BATCH_ROWS + 1) * sizeof(int32_t));
+    char *names = malloc(ARROW_BATCH_ROWS * name_len + 1);
+    int32_t *columns = malloc((size_t)ARROW_INT_COLUMNS * ARROW_BATCH_ROWS * sizeof(int32_t));
+    if (!offsets || !names || !columns) {
+        perror("Error allocating Arrow batch");
+        exit(EXIT_FAILURE);
+    }
+
+    for (int first = 0; first < n; first += ARROW_BATCH_ROWS) {
+        int rows = n - first < ARROW_BATCH_ROWS ? n - first : ARROW_BATCH_ROWS;
+        const Process *p = processes + first;
+        int32_t *id = columns, *arrival = id + rows, *burst = arrival + rows, *start = burst + rows;
+        int32_t *finish = start + rows, *tat = finish + rows, *rt = tat + rows, *wait = rt + rows;
+
+        for (int i = 0; i <= rows; i++)
+            offsets[i] = (int32_t)(i * name_len);
+        for (int i = 0; i < rows; i++)
+            memcpy(names + i * name_len, algorithm, name_len);
+        for (int i = 0; i < rows; i++)
+            id[i] = p[i].id;
+        for (int i = 0; i < rows; i++)
+            arrival[i] = p[i].arrival;
+        for (int i = 0; i < rows; i++)
+            burst[i] = p[i].burst;
+        for (int i = 0; i < rows; i++)
+            start[i] = p[i].start_time;
+        for (int i = 0; i < rows; i++)
+            finish[i] = p[i].finish_time;
+        for (int i = 0; i < rows; i++)
+            tat[i] = finish[i] - arrival[i];
+        for (int i = 0; i < rows; i++)
+            rt[i] = start[i] - arrival[i];
+        for (int i = 0; i < rows; i++)
+            wait[i] = tat[i] - burst[i];
+
+        // Body buffers in schema order: validity, offsets, data, then validity and data per int column.
+        const void *data[BUFFERS];
+        int64_t length[BUFFERS], offset[BUFFERS], body = 0;
+        data[0] = NULL;
+        length[0] = 0;
+        data[1] = offsets;
+        length[1] = (int64_t)(rows + 1) * sizeof(int32_t);
+        data[2] = names;
+        length[2] = (int64_t)rows * name_len;
+        for (int c = 0; c < ARROW_INT_COLUMNS; c++) {
+            data[3 + 2 * c] = NULL;
+            length[3 + 2 * c] = 0;
+            data[4 + 2 * c] = columns + (size_t)c * rows;
+            length[4 + 2 * c] = (int64_t)rows * sizeof(int32_t);
+        }
+        for (int b = 0; b < BUFFERS; b++) {
+            offset[b] = body;
+            body += (length[b] + ARROW_ALIGNMENT - 1) / ARROW_ALIGNMENT * ARROW_ALIGNMENT;
+        }
+
+        FlatBuilder fb;
+        size_t field[3];
+        int64_t row_count = rows, null_count = 0;
+        size_t header = fbMessage(&fb, ARROW_HEADER_BATCH, body);
+        fbLink(&fb, header, fbTable(&fb, 3, batch_sizes, field));
+        fbPut(&fb, field[0], &row_count, sizeof(row_count));
+        size_t nodes_at = field[1], buffers_at = field[2];
+
+        size_t nodes = fbVector(&fb, ARROW_COLUMNS, 16, 8);
+        fbLink(&fb, nodes_at, nodes);
+        for (int c = 0; c < ARROW_COLUMNS; c++) {
+            fbPut(&fb, nodes + 4 + 16 * c, &row_count, sizeof(row_count));
+            fbPut(&fb, nodes + 12 + 16 * c, &null_count, sizeof(null_count));
+        }
+        size_t buffers = fbVector(&fb, BUFFERS, 16, 8);
+        fbLink(&fb, buffers_at, buffers);
+        for (int b = 0; b < BUFFERS; b++) {
+            fbPut(&fb, buffers + 4 + 16 * b, &offset[b], sizeof(offset[b]));
+            fbPut(&fb, buffers + 12 + 16 * b, &length[b], sizeof(length[b]));
+        }
+        putMetadata(writer, &fb);
+
+        for (int b = 0; b < BUFFERS; b++) {
+            if (length[b] > 0)
+                writerPutBytes(writer, data[b], (size_t)length[b]);
+            writerPutBytes(writer, zeros, (size_t)(-length[b] & (ARROW_ALIGNMENT - 1)));
+        }
+    }
+
+    free(columns);
+    free(names);
+    free(offsets);
+}
+
+/**
+ * @brief Writes the end-of-stream marker.
+ */
+void arrowWriteEnd(BufferedWriter *writer) {
+    static const uint32_t end_of_stream[2] = {0xFFFFFFFFu, 0};
+    writerPutBytes(writer, end_of_stream, sizeof(end_of_stream));
+}
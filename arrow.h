@@ -0,0 +1,14 @@
+#ifndef ARROW_H
+#define ARROW_H
+
+#include "output.h"
+
+#define ARROW_BATCH_ROWS 65536    ///< Rows per record batch.
+#define ARROW_METADATA_MAX 4096   ///< Largest flatbuffer message header written.
+#define ARROW_ALIGNMENT 8         ///< Alignment of messages and body buffers.
+
+void arrowWriteSchema(BufferedWriter *writer);
+void arrowWriteBatches(BufferedWriter *writer, const char *algorithm, const Process processes[], int n);
+void arrowWriteEnd(BufferedWriter *writer);
+
+#endif
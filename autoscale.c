@@ -0,0 +1,176 @@
+#include <stdlib.h>
+#include "autoscale.h"
+#include "heap.h"
+
+enum {
+    EVENT_ONLINE = -2, ///< A requested CPU comes online.
+    EVENT_TIMER = -1   ///< The cooldown of a blocked scaling action is over.
+};
+
+/**
+ * @brief Round Robin on a shared queue whose CPU count follows the queue length.
+ *
+ * @param processes An array of Process structures sorted by arrival.
+ * @param n The number of processes in the array.
+ * @param quantum The time quantum; one larger than every burst gives FCFS.
+ * @param policy The scaling policy.
+ * @param stats Receives the cost of the run.
+ *
+ * @details
+ * The scheduling is that of computeMultiRR.  Slice ends, CPUs coming online
+ * and cooldown timers share one event heap keyed by time, so every event costs
+ * O(log max_cpus) and idle time is skipped.  After the events of a time are
+ * handled and idle CPUs have taken work, at most one scaling action is taken:
+ * a CPU is requested if more than scale_up_queue processes wait, or an idle CPU
+ * is released if at most scale_down_queue wait.  An action within the cooldown
+ * of the previous one is postponed to the end of the cooldown.  CPUs are paid
+ * for from the moment they are requested until they are released or the last
+ * process finishes.
+ */
+void computeAutoscaledRR(Process processes[], int n, int quantum, const AutoscalePolicy *policy,
+                         AutoscaleStats *stats) {
+    int max_cpus = policy->max_cpus;
+    int *remaining = malloc(n * sizeof(int));
+    int *queue = malloc(n * sizeof(int));
+    int *running = malloc(max_cpus * sizeof(int));
+    int *idle = malloc(max_cpus * sizeof(int));
+    int *spare = malloc(max_cpus * sizeof(int));
+    if ((n > 0 && (!remaining || !queue)) || !running || !idle || !spare) {
+        perror("Error allocating autoscaling state");
+        exit(EXIT_FAILURE);
+    }
+    for (int i = 0; i < n; i++) {
+        remaining[i] = processes[i].burst;
+        processes[i].start_time = -1;
+        processes[i].finish_time = -1;
+    }
+
+    int online = policy->min_cpus, pending = 0, idle_count = 0, spare_count = 0;
+    for (int c = max_cpus - 1; c >= policy->min_cpus; c--)
+        spare[spare_count++] = c;
+    for (int c = policy->min_cpus - 1; c >= 0; c--)
+        idle[idle_count++] = c;
+
+    *stats = (AutoscaleStats){0};
+    stats->peak_cpus = online;
+    MinHeap events;
+    heapInit(&events, max_cpus + 2);
+    int front = 0, rear = -1, size = 0, idx = 0, completed = 0, timer_set = 0;
+    long long now = 0, billed_since = 0, last_action = -(long long)policy->cooldown;
+
+    while (completed < n) {
+        long long next = events.size > 0 ? events.items[0].key : processes[idx].arrival;
+        if (idx < n && processes[idx].arrival < next)
+            next = processes[idx].arrival;
+        stats->cpu_time += (long long)(online + pending) * (next - billed_since);
+        billed_since = now = next;
+
+        while (idx < n && processes[idx].arrival <= now) {
+            rear = (rear + 1) % n;
+            queue[rear] = idx++;
+            size++;
+        }
+        while (events.size > 0 && events.items[0].key == now) {
+            int event = heapPop(&events).value;
+            if (event == EVENT_TIMER) {
+                timer_set = 0;
+            } else if (event == EVENT_ONLINE) {
+                pending--;
+                online++;
+                idle[idle_count++] = spare[--spare_count];
+            } else {
+                int proc_idx = running[event];
+                if (remaining[proc_idx] > 0) {
+                    rear = (rear + 1) % n;
+                    queue[rear] = proc_idx;
+                    size++;
+                } else {
+                    processes[proc_idx].finish_time = (int)now;
+                    completed++;
+                }
+                idle[idle_count++] = event;
+            }
+        }
+
+        while (idle_count > 0 && size > 0) {
+            int cpu = idle[--idle_count];
+            int proc_idx = queue[front];
+            front = (front + 1) % n;
+            size--;
+            if (processes[proc_idx].start_time == -1)
+                processes[proc_idx].start_time = (int)now;
+            int exec_time = remaining[proc_idx] < quantum ? remaining[proc_idx] : quantum;
+            remaining[proc_idx] -= exec_time;
+            running[cpu] = proc_idx;
+            heapPush(&events, now + exec_time, cpu);
+        }
+
+        int scale_up = size > policy->scale_up_queue && online + pending < max_cpus;
+        int scale_down = !scale_up && size <= policy->scale_down_queue && idle_count > 0 &&
+                         online > policy->min_cpus && completed < n;
+        if ((scale_up || scale_down) && now < last_action + policy->cooldown) {
+            if (!timer_set) {
+                heapPush(&events, last_action + policy->cooldown, EVENT_TIMER);
+                timer_set = 1;
+            }
+        } else if (scale_up) {
+            pending++;
+            stats->scale_ups++;
+            last_action = now;
+            heapPush(&events, now + policy->provision_delay, EVENT_ONLINE);
+        } else if (scale_down) {
+            spare[spare_count++] = idle[--idle_count];
+            online--;
+            stats->scale_downs++;
+            last_action = now;
+        }
+        if (online + pending > stats->peak_cpus)
+            stats->peak_cpus = online + pending;
+    }
+
+    stats->makespan = (int)now;
+    heapFree(&events);
+    free(spare);
+    free(idle);
+    free(running);
+    free(queue);
+    free(remaining);
+}
+
+static int compareInt(const void *a, const void *b) {
+    int x = *(const int *)a, y = *(const int *)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Prints the cost of an autoscaled run next to its latency percentiles.
+ */
+void printAutoscaleStats(const Process processes[], int n, const AutoscalePolicy *policy,
+                         const AutoscaleStats *stats, FILE *out) {
+    int *rt = malloc((n > 0 ? n : 1) * sizeof(int));
+    int *tat = malloc((n > 0 ? n : 1) * sizeof(int));
+    if (!rt || !tat) {
+        perror("Error allocating latency table");
+        exit(EXIT_FAILURE);
+    }
+    for (int i = 0; i < n; i++) {
+        rt[i] = processes[i].start_time - processes[i].arrival;
+        tat[i] = processes[i].finish_time - processes[i].arrival;
+    }
+    qsort(rt, n, sizeof(int), compareInt);
+    qsort(tat, n, sizeof(int), compareInt);
+    int p50 = n > 0 ? (n - 1) / 2 : 0, p99 = n > 0 ? (int)(0.99 * n + 0.999999) - 1 : 0;
+
+    fprintf(out, "\nAutoscaling (%d-%d CPUs, up above %d waiting, down at %d, delay %d, cooldown %d):\n",
+            policy->min_cpus, policy->max_cpus, policy->scale_up_queue, policy->scale_down_queue,
+            policy->provision_delay, policy->cooldown);
+    fprintf(out, "CPU Time: %lld cpu-ut (mean %.2f CPUs over %d ut, peak %d)\n", stats->cpu_time,
+            stats->makespan ? (double)stats->cpu_time / stats->makespan : 0.0, stats->makespan, stats->peak_cpus);
+    fprintf(out, "Cost per Process: %.2f cpu-ut\n", n ? (double)stats->cpu_time / n : 0.0);
+    fprintf(out, "Scaling Actions: %d up, %d down\n", stats->scale_ups, stats->scale_downs);
+    if (n > 0)
+        fprintf(out, "Response Time: p50 %d, p99 %d; Turnaround Time: p50 %d, p99 %d\n", rt[p50], rt[p99],
+                tat[p50], tat[p99]);
+    free(tat);
+    free(rt);
+}
@@ -0,0 +1,40 @@
+#ifndef AUTOSCALE_H
+#define AUTOSCALE_H
+
+#include <stdio.h>
+#include "process.h"
+
+#define AUTOSCALE_SCALE_UP 4     ///< Default: request a CPU while more processes than this wait.
+#define AUTOSCALE_SCALE_DOWN 0   ///< Default: release an idle CPU while at most this many wait.
+#define AUTOSCALE_DELAY 10       ///< Default time for a requested CPU to come online.
+#define AUTOSCALE_COOLDOWN 10    ///< Default minimum time between two scaling actions.
+
+/**
+ * @brief Threshold policy on the length of the shared ready queue.
+ */
+typedef struct {
+    int min_cpus;          ///< CPUs online from time 0 and never released.
+    int max_cpus;          ///< Most CPUs online or being provisioned.
+    int scale_up_queue;    ///< Request a CPU while more processes than this wait.
+    int scale_down_queue;  ///< Release an idle CPU while at most this many wait.
+    int provision_delay;   ///< Time between requesting a CPU and running on it.
+    int cooldown;          ///< Minimum time between two scaling actions.
+} AutoscalePolicy;
+
+/**
+ * @brief Cost of an autoscaled run.
+ */
+typedef struct {
+    long long cpu_time;  ///< CPUs paid for (online or provisioning) integrated over time.
+    int makespan;        ///< Finish time of the last process.
+    int peak_cpus;       ///< Most CPUs paid for at once.
+    int scale_ups;       ///< CPUs requested.
+    int scale_downs;     ///< CPUs released.
+} AutoscaleStats;
+
+void computeAutoscaledRR(Process processes[], int n, int quantum, const AutoscalePolicy *policy,
+                         AutoscaleStats *stats);
+void printAutoscaleStats(const Process processes[], int n, const AutoscalePolicy *policy,
+                         const AutoscaleStats *stats, FILE *out);
+
+#endif
@@ -0,0 +1,331 @@
+#include <stdlib.h>
+#include <limits.h>
+#include "backfill.h"
+#include "treap.h"
+
+/**
+ * @brief Availability profile: the running processes ordered by finish time.
+ *
+ * An IndexTreap over process indices, so nothing is allocated per process.
+ * Each node also holds the cores of its subtree, which lets the earliest time
+ * a number of cores is free be found in one descent from the root.
+ */
+typedef struct {
+    IndexTreap tree;          ///< Running processes by finish time, then index.
+    int *cores;               ///< Cores of each subtree.
+    long long *end;           ///< Finish time of each process.
+    const Process *processes; ///< The trace, for the cores of each process.
+} Profile;
+
+static int subtreeCores(const Profile *profile, int t) {
+    return t < 0 ? 0 : profile->cores[t];
+}
+
+static void pullCores(void *context, int t) {
+    Profile *profile = context;
+    const TreapLink *link = &profile->tree.links[t];
+    profile->cores[t] = profile->processes[t].cores + subtreeCores(profile, link->left) +
+                        subtreeCores(profile, link->right);
+}
+
+/**
+ * @brief Profile order: by finish time, then by index.
+ */
+static int endsBefore(const void *context, int a, int b) {
+    const Profile *profile = context;
+    return profile->end[a] < profile->end[b] || (profile->end[a] == profile->end[b] && a < b);
+}
+
+static void profileInsert(Profile *profile, int i, long long end) {
+    profile->end[i] = end;
+    treapInsert(&profile->tree, (TreapOps){endsBefore, pullCores, profile}, i);
+}
+
+/**
+ * @brief Returns the earliest time at which `need` more cores than are free now
+ *        will have been released.  The profile must hold at least that many.
+ */
+static long long profileShadow(const Profile *profile, int need) {
+    const TreapLink *links = profile->tree.links;
+    int t = profile->tree.root, released = 0;
+    for (;;) {
+        int on_left = subtreeCores(profile, links[t].left);
+        if (released + on_left >= need) {
+            t = links[t].left;
+            continue;
+        }
+        released += on_left + profile->processes[t].cores;
+        if (released >= need)
+            return profile->end[t];
+        t = links[t].right;
+    }
+}
+
+/**
+ * @brief Returns the cores released at or before time `until`.
+ */
+static int profileReleased(const Profile *profile, long long until) {
+    const TreapLink *links = profile->tree.links;
+    int t = profile->tree.root, released = 0;
+    while (t >= 0) {
+        if (profile->end[t] <= until) {
+            released += subtreeCores(profile, links[t].left) + profile->processes[t].cores;
+            t = links[t].right;
+        } else {
+            t = links[t].left;
+        }
+    }
+    return released;
+}
+
+static int compareInt(const void *a, const void *b) {
+    int x = *(const int *)a, y = *(const int *)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief The waiting processes, split by the number of cores they need.
+ *
+ * Each distinct width (core count) has a min segment tree over the bursts of
+ * its processes in arrival order; leaves of processes that are not waiting
+ * hold LLONG_MAX.  All trees share one array, tree w occupying the nodes
+ * [2 * first[w], 2 * (first[w] + leaves[w])).
+ */
+typedef struct {
+    int widths;       ///< Distinct widths in the trace.
+    int *width;       ///< The widths, ascending.
+    int *leaves;      ///< Leaves of each width's tree, a power of two.
+    int *first;       ///< Leaves of the trees before each width's tree.
+    int *member;      ///< Process of each leaf, at first[w] + leaf.
+    int *of;          ///< Width index of each process.
+    int *slot;        ///< Leaf of each process in its width's tree.
+    long long *burst; ///< Nodes of every tree.
+} WaitQueue;
+
+static void waitQueueInit(WaitQueue *queue, const Process processes[], int n) {
+    int *sorted = malloc((n ? n : 1) * sizeof(int));
+    queue->of = malloc((n ? n : 1) * sizeof(int));
+    queue->slot = malloc((n ? n : 1) * sizeof(int));
+    if (!sorted || !queue->of || !queue->slot) {
+        perror("Error allocating backfilling queues");
+        exit(EXIT_FAILURE);
+    }
+    for (int i = 0; i < n; i++)
+        sorted[i] = processes[i].cores;
+    qsort(sorted, n, sizeof(int), compareInt);
+    queue->widths = 0;
+    for (int i = 0; i < n; i++)
+        if (i == 0 || sorted[i] != sorted[i - 1])
+            sorted[queue->widths++] = sorted[i];
+
+    int widths = queue->widths ? queue->widths : 1;
+    queue->width = realloc(sorted, widths * sizeof(int));
+    queue->leaves = calloc(widths, sizeof(int));
+    queue->first = malloc(widths * sizeof(int));
+    if (!queue->width || !queue->leaves || !queue->first) {
+        perror("Error allocating backfilling queues");
+        exit(EXIT_FAILURE);
+    }
+    for (int i = 0; i < n; i++) {
+        int lo = 0, hi = queue->widths - 1;
+        while (lo < hi) {
+            int mid = (lo + hi) / 2;
+            if (queue->width[mid] < processes[i].cores)
+                lo = mid + 1;
+            else
+                hi = mid;
+        }
+        queue->of[i] = lo;
+        queue->slot[i] = queue->leaves[lo]++;
+    }
+
+    int total = 0;
+    for (int w = 0; w < queue->widths; w++) {
+        int count = queue->leaves[w];
+        for (queue->leaves[w] = 1; queue->leaves[w] < count;)
+            queue->leaves[w] *= 2;
+        queue->first[w] = total;
+        total += queue->leaves[w];
+    }
+    queue->member = malloc((total ? total : 1) * sizeof(int));
+    queue->burst = malloc((2 * (size_t)total + 1) * sizeof(long long));
+    if (!queue->member || !queue->burst) {
+        perror("Error allocating backfilling queues");
+        exit(EXIT_FAILURE);
+    }
+    for (int i = 0; i < n; i++)
+        queue->member[queue->first[queue->of[i]] + queue->slot[i]] = i;
+    for (size_t k = 0; k < 2 * (size_t)total + 1; k++)
+        queue->burst[k] = LLONG_MAX;
+}
+
+static void waitQueueFree(WaitQueue *queue) {
+    free(queue->burst);
+    free(queue->member);
+    free(queue->first);
+    free(queue->leaves);
+    free(queue->width);
+    free(queue->slot);
+    free(queue->of);
+}
+
+/**
+ * @brief Sets the leaf of process i: its burst while it waits, LLONG_MAX otherwise.
+ */
+static void waitSet(WaitQueue *queue, int i, long long burst) {
+    int w = queue->of[i];
+    long long *tree = queue->burst + 2 * (size_t)queue->first[w];
+    int k = queue->leaves[w] + queue->slot[i];
+    tree[k] = burst;
+    for (k /= 2; k > 0; k /= 2)
+        tree[k] = tree[2 * k] < tree[2 * k + 1] ? tree[2 * k] : tree[2 * k + 1];
+}
+
+/**
+ * @brief Finds the first waiting process, in arrival order, that may be backfilled.
+ *
+ * @param queue The waiting processes.
+ * @param idle The cores free now.
+ * @param extra The cores the reservation leaves over.
+ * @param window Time left until the reservation.
+ * @return The index of the process, or -1.
+ *
+ * @details
+ * A process qualifies if it fits in the idle cores and either finishes by the
+ * reservation or fits in the extra cores.  The earliest qualifying process of
+ * each width is one descent of its tree, so the search costs O(d log n) for
+ * the d widths no larger than idle, however long the queue.  The head of the
+ * queue needs more than idle cores and is never considered.
+ */
+static int findBackfill(const WaitQueue *queue, int idle, int extra, long long window) {
+    int best = -1;
+    for (int w = 0; w < queue->widths && queue->width[w] <= idle; w++) {
+        const long long *tree = queue->burst + 2 * (size_t)queue->first[w];
+        long long limit = queue->width[w] <= extra ? LLONG_MAX - 1 : window;
+        if (tree[1] > limit)
+            continue;
+        int k = 1;
+        while (k < queue->leaves[w])
+            k = tree[2 * k] <= limit ? 2 * k : 2 * k + 1;
+        int i = queue->member[queue->first[w] + k - queue->leaves[w]];
+        if (best < 0 || i < best)
+            best = i;
+    }
+    return best;
+}
+
+static void startProcess(Process processes[], int i, long long now, Profile *profile, WaitQueue *queue, int *idle,
+                         BackfillStats *stats) {
+    processes[i].start_time = (int)now;
+    profileInsert(profile, i, now + processes[i].burst);
+    waitSet(queue, i, LLONG_MAX);
+    *idle -= processes[i].cores;
+    stats->core_time += (long long)processes[i].cores * processes[i].burst;
+    if (now - processes[i].arrival > stats->max_wait)
+        stats->max_wait = (int)(now - processes[i].arrival);
+}
+
+/**
+ * @brief Computes FCFS with EASY backfilling on a machine with several cores.
+ *
+ * @param processes An array of Process structures sorted by arrival.
+ * @param n The number of processes in the array.
+ * @param cores The cores of the machine.
+ * @param stats Receives the backfilling statistics.
+ *
+ * @details
+ * Processes start in arrival order while their cores are free.  When the head
+ * of the queue does not fit, it gets a reservation at the shadow time, the
+ * earliest time enough running processes have finished, and later processes
+ * may jump ahead if they finish by then or only use the cores the head leaves
+ * over.  Bursts are exact, so a reservation holds until the head starts and is
+ * computed once per head.
+ *
+ * The running processes form a profile ordered by finish time with the cores
+ * of each subtree, so the shadow time is one O(log n) descent.  The waiting
+ * processes sit in one segment tree per width (see findBackfill), so a pass
+ * costs O(d log n) per process it starts, d the distinct widths that fit,
+ * instead of a scan of the queue.
+ */
+void computeEASY(Process processes[], int n, int cores, BackfillStats *stats) {
+    for (int i = 0; i < n; i++) {
+        if (processes[i].cores < 1 || processes[i].cores > cores) {
+            fprintf(stderr, "Invalid trace: process %d needs %d cores, the machine has %d\n", processes[i].id,
+                    processes[i].cores, cores);
+            exit(EXIT_FAILURE);
+        }
+        processes[i].start_time = -1;
+        processes[i].finish_time = -1;
+    }
+
+    Profile profile = {.cores = malloc(n * sizeof(int)), .end = malloc(n * sizeof(long long)),
+                       .processes = processes};
+    treapInit(&profile.tree, n);
+    if (n > 0 && (!profile.cores || !profile.end)) {
+        perror("Error allocating backfilling queues");
+        exit(EXIT_FAILURE);
+    }
+    WaitQueue queue;
+    waitQueueInit(&queue, processes, n);
+
+    *stats = (BackfillStats){0};
+    int idx = 0, head = 0, completed = 0, idle = cores, reserved = -1, extra = 0;
+    long long now = 0, shadow = 0;
+
+    while (completed < n) {
+        int first = treapFirst(&profile.tree);
+        now = idx < n ? processes[idx].arrival : LLONG_MAX;
+        if (first >= 0 && profile.end[first] < now)
+            now = profile.end[first];
+
+        while ((first = treapFirst(&profile.tree)) >= 0 && profile.end[first] == now) {
+            treapRemoveFirst(&profile.tree, (TreapOps){endsBefore, pullCores, &profile});
+            idle += processes[first].cores;
+            processes[first].finish_time = (int)now;
+            completed++;
+        }
+        for (; idx < n && processes[idx].arrival <= now; idx++)
+            waitSet(&queue, idx, processes[idx].burst);
+
+        for (;;) {
+            while (head < idx && processes[head].start_time != -1)
+                head++;
+            if (head == idx)
+                break;
+            if (processes[head].cores <= idle) {
+                startProcess(processes, head, now, &profile, &queue, &idle, stats);
+                continue;
+            }
+            if (reserved != head) {
+                reserved = head;
+                shadow = profileShadow(&profile, processes[head].cores - idle);
+                extra = idle + profileReleased(&profile, shadow) - processes[head].cores;
+            }
+            int i;
+            while ((i = findBackfill(&queue, idle, extra, shadow - now)) >= 0) {
+                startProcess(processes, i, now, &profile, &queue, &idle, stats);
+                stats->backfilled++;
+                if (now + processes[i].burst > shadow)
+                    extra -= processes[i].cores;
+            }
+            break;
+        }
+    }
+    stats->makespan = (int)now;
+
+    waitQueueFree(&queue);
+    treapFree(&profile.tree);
+    free(profile.end);
+    free(profile.cores);
+}
+
+/**
+ * @brief Prints how much EASY backfilling moved ahead and how busy it kept the machine.
+ */
+void printBackfillStats(int cores, int n, const BackfillStats *stats, FILE *out) {
+    fprintf(out, "\nEASY Backfilling (%d cores):\n", cores);
+    fprintf(out, "Backfilled Processes: %d (%.2f%%)\n", stats->backfilled, n ? 100.0 * stats->backfilled / n : 0.0);
+    fprintf(out, "Core Utilization: %.2f%%\n",
+            stats->makespan ? 100.0 * stats->core_time / ((double)stats->makespan * cores) : 0.0);
+    fprintf(out, "Longest Wait: %d\n", stats->max_wait);
+}
@@ -0,0 +1,20 @@
+#ifndef BACKFILL_H
+#define BACKFILL_H
+
+#include <stdio.h>
+#include "process.h"
+
+/**
+ * @brief Outcome of an EASY backfilling run.
+ */
+typedef struct {
+    int backfilled;      ///< Processes started ahead of the head of the queue.
+    long long core_time; ///< Cores times burst, summed over the processes.
+    int makespan;        ///< Finish time of the last process.
+    int max_wait;        ///< Longest time a process waited to start.
+} BackfillStats;
+
+void computeEASY(Process processes[], int n, int cores, BackfillStats *stats);
+void printBackfillStats(int cores, int n, const BackfillStats *stats, FILE *out);
+
+#endif
@@ -0,0 +1,394 @@
+#include <stdlib.h>
+#include "balance.h"
+#include "heap.h"
+
+/**
+ * @brief Idlest and busiest CPU of every range, in two segment trees.
+ *
+ * The CPUs of each domain are a contiguous range, so the idlest and busiest
+ * CPU of any domain is one O(log cpus) query.  Ties go to the lowest CPU.
+ */
+typedef struct {
+    int leaves;      ///< Power of two >= cpus.
+    int *best[2];    ///< Idlest ([0]) and busiest ([1]) CPU of each node, -1 for padding.
+    const int *load; ///< Runnable processes of each CPU.
+} CpuLoads;
+
+static int pick(const CpuLoads *tree, int a, int b, int busiest) {
+    if (a < 0)
+        return b;
+    if (b < 0)
+        return a;
+    if (tree->load[a] != tree->load[b])
+        return (tree->load[a] > tree->load[b]) == busiest ? a : b;
+    return a < b ? a : b;
+}
+
+static void loadsUpdate(CpuLoads *tree, int cpu) {
+    for (int k = (tree->leaves + cpu) / 2; k > 0; k /= 2)
+        for (int m = 0; m < 2; m++)
+            tree->best[m][k] = pick(tree, tree->best[m][2 * k], tree->best[m][2 * k + 1], m);
+}
+
+/**
+ * @brief Returns the idlest or busiest CPU of [lo, hi).
+ */
+static int loadsQuery(const CpuLoads *tree, int lo, int hi, int busiest) {
+    int best = -1;
+    for (int l = lo + tree->leaves, r = hi + tree->leaves; l < r; l /= 2, r /= 2) {
+        if (l & 1)
+            best = pick(tree, best, tree->best[busiest][l++], busiest);
+        if (r & 1)
+            best = pick(tree, best, tree->best[busiest][--r], busiest);
+    }
+    return best;
+}
+
+/**
+ * @brief Per-CPU run queues and the load aggregates kept up to date with them.
+ */
+typedef struct {
+    const Topology *topology;
+    int cpus;
+    int *load;               ///< Runnable processes of each CPU, the running one included.
+    int *llc_load;           ///< Sum of load over each LLC domain.
+    int *socket_load;        ///< Sum of load over each socket.
+    CpuLoads tree;           ///< Idlest and busiest CPU of each range.
+    int *idle, *idle_where;  ///< Sparse set of the CPUs with no load.
+    int idle_count;          ///< CPUs with no load.
+    int overloaded;          ///< CPUs with a waiting process (load >= 2).
+    int total;               ///< Runnable processes.
+    int *head, *tail;        ///< Run queue of each CPU, -1 if empty.
+    int *next, *prev;        ///< Run queue links of each process.
+    int *running;            ///< Process on each CPU, -1 if none.
+    int *pending;            ///< CPUs that may have to start a slice.
+    char *is_pending;        ///< Whether each CPU is in pending.
+    int pending_count;
+} RunQueues;
+
+/**
+ * @brief Changes the load of a CPU by delta and updates every aggregate: O(log cpus).
+ */
+static void addLoad(RunQueues *rq, int cpu, int delta) {
+    int before = rq->load[cpu], after = before + delta;
+    int llc = cpu / rq->topology->cores;
+    rq->load[cpu] = after;
+    rq->llc_load[llc] += delta;
+    rq->socket_load[llc / rq->topology->llcs] += delta;
+    rq->total += delta;
+    rq->overloaded += (after >= 2) - (before >= 2);
+    if (before == 0) {
+        int last = rq->idle[--rq->idle_count];
+        rq->idle[rq->idle_where[cpu]] = last;
+        rq->idle_where[last] = rq->idle_where[cpu];
+    } else if (after == 0) {
+        rq->idle_where[cpu] = rq->idle_count;
+        rq->idle[rq->idle_count++] = cpu;
+    }
+    loadsUpdate(&rq->tree, cpu);
+}
+
+static void markPending(RunQueues *rq, int cpu) {
+    if (!rq->is_pending[cpu]) {
+        rq->is_pending[cpu] = 1;
+        rq->pending[rq->pending_count++] = cpu;
+    }
+}
+
+static void linkTail(RunQueues *rq, int cpu, int i) {
+    rq->next[i] = -1;
+    rq->prev[i] = rq->tail[cpu];
+    if (rq->tail[cpu] >= 0)
+        rq->next[rq->tail[cpu]] = i;
+    else
+        rq->head[cpu] = i;
+    rq->tail[cpu] = i;
+}
+
+static void unlinkProcess(RunQueues *rq, int cpu, int i) {
+    if (rq->prev[i] >= 0)
+        rq->next[rq->prev[i]] = rq->next[i];
+    else
+        rq->head[cpu] = rq->next[i];
+    if (rq->next[i] >= 0)
+        rq->prev[rq->next[i]] = rq->prev[i];
+    else
+        rq->tail[cpu] = rq->prev[i];
+}
+
+/**
+ * @brief Moves the last waiting process of src to the tail of dst.
+ */
+static void moveWaiting(RunQueues *rq, int src, int dst) {
+    int i = rq->tail[src];
+    unlinkProcess(rq, src, i);
+    addLoad(rq, src, -1);
+    linkTail(rq, dst, i);
+    addLoad(rq, dst, 1);
+    markPending(rq, dst);
+}
+
+/**
+ * @brief Balances domain d of a level: its busiest child group against its idlest.
+ *
+ * @details
+ * Domains of MIGRATE_CORE are LLC domains whose groups are cores, domains of
+ * MIGRATE_LLC are sockets whose groups are LLC domains, and the one domain of
+ * MIGRATE_SOCKET is the machine, whose groups are sockets.  A domain whose
+ * CPU loads differ by less than two is skipped on the segment trees alone.
+ * Otherwise, if the busiest group's load exceeds imbalance_pct percent of the
+ * idlest's, the busiest CPU of the busiest group gives half the difference to
+ * the idlest CPU of the idlest group, taking waiting processes from the tail.
+ */
+static void balanceDomain(RunQueues *rq, MigrationLevel level, int d, BalanceStats *stats) {
+    const Topology *t = rq->topology;
+    int width = level == MIGRATE_CORE ? 1 : level == MIGRATE_LLC ? t->cores : t->llcs * t->cores;
+    int groups = level == MIGRATE_CORE ? t->cores : level == MIGRATE_LLC ? t->llcs : t->sockets;
+    const int *group_load = level == MIGRATE_CORE ? rq->load + d * t->cores :
+                            level == MIGRATE_LLC ? rq->llc_load + d * t->llcs : rq->socket_load;
+    int lo = d * groups * width, hi = lo + groups * width;
+    if (rq->load[loadsQuery(&rq->tree, lo, hi, 1)] - rq->load[loadsQuery(&rq->tree, lo, hi, 0)] < 2)
+        return;
+
+    int busiest = 0, idlest = 0;
+    for (int g = 1; g < groups; g++) {
+        if (group_load[g] > group_load[busiest])
+            busiest = g;
+        if (group_load[g] < group_load[idlest])
+            idlest = g;
+    }
+    if ((long long)group_load[busiest] * 100 <= (long long)group_load[idlest] * t->imbalance_pct)
+        return;
+
+    int src = loadsQuery(&rq->tree, lo + busiest * width, lo + (busiest + 1) * width, 1);
+    int dst = loadsQuery(&rq->tree, lo + idlest * width, lo + (idlest + 1) * width, 0);
+    int moved = 0;
+    for (int move = (rq->load[src] - rq->load[dst]) / 2; move > 0 && rq->tail[src] >= 0; move--, moved++)
+        moveWaiting(rq, src, dst);
+    if (moved > 0) {
+        stats->pulls++;
+        stats->moved += moved;
+    }
+}
+
+/**
+ * @brief Lets idle CPUs steal while other CPUs have waiting processes.
+ *
+ * @details
+ * Each idle CPU takes one waiting process from the busiest CPU of its LLC
+ * domain, else of its socket, else of the machine.  While some CPU has a
+ * waiting process the machine-wide search always succeeds, so every
+ * iteration moves a process.
+ */
+static void stealWork(RunQueues *rq, BalanceStats *stats) {
+    const Topology *t = rq->topology;
+    while (rq->overloaded > 0 && rq->idle_count > 0) {
+        int cpu = rq->idle[rq->idle_count - 1];
+        int llc = cpu / t->cores, socket = llc / t->llcs;
+        int ranges[MIGRATE_LEVELS][2] = {{llc * t->cores, (llc + 1) * t->cores},
+                                         {socket * t->llcs * t->cores, (socket + 1) * t->llcs * t->cores},
+                                         {0, rq->cpus}};
+        for (int l = 0; l < MIGRATE_LEVELS; l++) {
+            int victim = loadsQuery(&rq->tree, ranges[l][0], ranges[l][1], 1);
+            if (rq->load[victim] >= 2 && rq->tail[victim] >= 0) {
+                moveWaiting(rq, victim, cpu);
+                stats->pulls++;
+                stats->moved++;
+                break;
+            }
+        }
+    }
+}
+
+/**
+ * @brief Round Robin on per-CPU run queues with periodic balancing or stealing.
+ *
+ * @param processes An array of Process structures sorted by arrival.
+ * @param n The number of processes in the array.
+ * @param quantum The time quantum.
+ * @param topology The machine, its migration penalties and balancing parameters.
+ * @param mode Periodic balancing or idle-time stealing.
+ * @param stats Receives the balancing work and the migrations per level.
+ *
+ * @details
+ * Every CPU runs Round Robin on its own queue.  An arriving process joins
+ * the idlest CPU.  With periodic balancing, each level has a timer of period
+ * interval[level], armed while there are runnable processes, that balances
+ * every domain of the level (see balanceDomain).  With stealing, a CPU that
+ * runs out of work takes a process from the nearest busy one (see stealWork).
+ * A process resuming on another core pays the migration penalty of the level.
+ *
+ * Loads live in aggregates updated with each change (CPU loads, LLC and
+ * socket sums, the idlest and busiest CPU of every range, the idle and
+ * overloaded counts), so no decision rescans the queues: a balancing pass
+ * costs O(log cpus) per domain, plus the group scan of imbalanced domains.
+ */
+void computeBalancedRR(Process processes[], int n, int quantum, const Topology *topology, BalanceMode mode,
+                       BalanceStats *stats) {
+    int cpus = topologyCpus(topology), llcs = topology->sockets * topology->llcs;
+    RunQueues rq = {0};
+    rq.topology = topology;
+    rq.cpus = cpus;
+    rq.load = calloc(cpus, sizeof(int));
+    rq.llc_load = calloc(llcs, sizeof(int));
+    rq.socket_load = calloc(topology->sockets, sizeof(int));
+    for (rq.tree.leaves = 1; rq.tree.leaves < cpus;)
+        rq.tree.leaves *= 2;
+    rq.tree.best[0] = malloc(2 * rq.tree.leaves * sizeof(int));
+    rq.tree.best[1] = malloc(2 * rq.tree.leaves * sizeof(int));
+    rq.tree.load = rq.load;
+    rq.idle = malloc(cpus * sizeof(int));
+    rq.idle_where = malloc(cpus * sizeof(int));
+    rq.head = malloc(cpus * sizeof(int));
+    rq.tail = malloc(cpus * sizeof(int));
+    rq.running = malloc(cpus * sizeof(int));
+    rq.pending = malloc(cpus * sizeof(int));
+    rq.is_pending = calloc(cpus, 1);
+    rq.next = malloc((n ? n : 1) * sizeof(int));
+    rq.prev = malloc((n ? n : 1) * sizeof(int));
+    int *remaining = malloc((n ? n : 1) * sizeof(int));
+    int *last = malloc((n ? n : 1) * sizeof(int));
+    if (!rq.load || !rq.llc_load || !rq.socket_load || !rq.tree.best[0] || !rq.tree.best[1] || !rq.idle ||
+        !rq.idle_where || !rq.head || !rq.tail || !rq.running || !rq.pending || !rq.is_pending || !rq.next ||
+        !rq.prev || !remaining || !last) {
+        perror("Error allocating run queues");
+        exit(EXIT_FAILURE);
+    }
+    for (int k = 0; k < rq.tree.leaves; k++)
+        rq.tree.best[0][rq.tree.leaves + k] = rq.tree.best[1][rq.tree.leaves + k] = k < cpus ? k : -1;
+    for (int k = rq.tree.leaves - 1; k > 0; k--)
+        for (int m = 0; m < 2; m++)
+            rq.tree.best[m][k] = pick(&rq.tree, rq.tree.best[m][2 * k], rq.tree.best[m][2 * k + 1], m);
+    for (int c = 0; c < cpus; c++) {
+        rq.idle[c] = cpus - 1 - c;
+        rq.idle_where[cpus - 1 - c] = c;
+        rq.head[c] = rq.tail[c] = rq.running[c] = -1;
+    }
+    rq.idle_count = cpus;
+    for (int i = 0; i < n; i++) {
+        remaining[i] = processes[i].burst;
+        last[i] = -1;
+        processes[i].start_time = -1;
+        processes[i].finish_time = -1;
+    }
+
+    *stats = (BalanceStats){0};
+    MinHeap events;
+    heapInit(&events, cpus + MIGRATE_LEVELS);
+    int armed[MIGRATE_LEVELS] = {0}, idx = 0, completed = 0;
+    long long now = 0;
+
+    while (completed < n) {
+        long long next = events.size > 0 ? events.items[0].key : processes[idx].arrival;
+        if (idx < n && processes[idx].arrival < next)
+            next = processes[idx].arrival;
+        if (rq.overloaded > 0)
+            stats->idle_while_queued += (next - now) * rq.idle_count;
+        now = next;
+
+        for (; idx < n && processes[idx].arrival <= now; idx++) {
+            int cpu = loadsQuery(&rq.tree, 0, cpus, 0);
+            linkTail(&rq, cpu, idx);
+            addLoad(&rq, cpu, 1);
+            markPending(&rq, cpu);
+        }
+
+        int fired[MIGRATE_LEVELS] = {0};
+        while (events.size > 0 && events.items[0].key == now) {
+            int value = heapPop(&events).value;
+            if (value < 0) {
+                fired[-1 - value] = 1;
+                armed[-1 - value] = 0;
+                continue;
+            }
+            int i = rq.running[value];
+            rq.running[value] = -1;
+            if (remaining[i] > 0) {
+                linkTail(&rq, value, i);
+            } else {
+                processes[i].finish_time = (int)now;
+                completed++;
+                addLoad(&rq, value, -1);
+            }
+            markPending(&rq, value);
+        }
+
+        if (mode == BALANCE_PERIODIC) {
+            for (int l = 0; l < MIGRATE_LEVELS; l++) {
+                if (!fired[l] || rq.total == 0)
+                    continue;
+                int domains = l == MIGRATE_CORE ? llcs : l == MIGRATE_LLC ? topology->sockets : 1;
+                for (int d = 0; d < domains; d++)
+                    balanceDomain(&rq, (MigrationLevel)l, d, stats);
+            }
+            for (int l = 0; l < MIGRATE_LEVELS; l++) {
+                if (!armed[l] && rq.total > 0) {
+                    armed[l] = 1;
+                    heapPush(&events, (now / topology->interval[l] + 1) * topology->interval[l], -1 - l);
+                }
+            }
+        } else {
+            stealWork(&rq, stats);
+        }
+
+        while (rq.pending_count > 0) {
+            int cpu = rq.pending[--rq.pending_count];
+            rq.is_pending[cpu] = 0;
+            int i = rq.head[cpu];
+            if (rq.running[cpu] >= 0 || i < 0)
+                continue;
+            unlinkProcess(&rq, cpu, i);
+            rq.running[cpu] = i;
+
+            long long penalty = 0;
+            if (last[i] >= 0 && last[i] != cpu) {
+                MigrationLevel level = migrationLevel(topology, last[i], cpu);
+                stats->migrations[level]++;
+                penalty = topology->penalty[level];
+                stats->penalty_time += penalty;
+            }
+            last[i] = cpu;
+            if (processes[i].start_time == -1)
+                processes[i].start_time = (int)now;
+            int exec_time = remaining[i] < quantum ? remaining[i] : quantum;
+            remaining[i] -= exec_time;
+            heapPush(&events, now + penalty + exec_time, cpu);
+        }
+    }
+    stats->makespan = (int)now;
+
+    heapFree(&events);
+    free(last);
+    free(remaining);
+    free(rq.prev);
+    free(rq.next);
+    free(rq.is_pending);
+    free(rq.pending);
+    free(rq.running);
+    free(rq.tail);
+    free(rq.head);
+    free(rq.idle_where);
+    free(rq.idle);
+    free(rq.tree.best[1]);
+    free(rq.tree.best[0]);
+    free(rq.socket_load);
+    free(rq.llc_load);
+    free(rq.load);
+}
+
+/**
+ * @brief Prints the balancing work and migrations of both modes side by side.
+ */
+void printBalanceStats(const Topology *topology, const BalanceStats *periodic, const BalanceStats *steal,
+                       FILE *out) {
+    const BalanceStats *runs[2] = {periodic, steal};
+    const char *names[2] = {"periodic", "steal"};
+    fprintf(out, "\nLoad Balancing (intervals %d/%d/%d, imbalance %d%%):\n", topology->interval[MIGRATE_CORE],
+            topology->interval[MIGRATE_LLC], topology->interval[MIGRATE_SOCKET], topology->imbalance_pct);
+    fprintf(out, "%-10s %10s %10s %10s %10s %10s %14s %18s\n", "Mode", "Pulls", "Moved", "Core", "LLC", "Socket",
+            "Penalty Time", "Idle While Queued");
+    for (int r = 0; r < 2; r++)
+        fprintf(out, "%-10s %10lld %10lld %10lld %10lld %10lld %14lld %18lld\n", names[r], runs[r]->pulls,
+                runs[r]->moved, runs[r]->migrations[MIGRATE_CORE], runs[r]->migrations[MIGRATE_LLC],
+                runs[r]->migrations[MIGRATE_SOCKET], runs[r]->penalty_time, runs[r]->idle_while_queued);
+}
@@ -0,0 +1,33 @@
+#ifndef BALANCE_H
+#define BALANCE_H
+
+#include <stdio.h>
+#include "process.h"
+#include "topology.h"
+
+/**
+ * @brief How work moves between the per-CPU run queues.
+ */
+typedef enum {
+    BALANCE_PERIODIC, ///< Every domain level is balanced on its own period.
+    BALANCE_STEAL     ///< An idle CPU pulls a waiting process from the nearest busy one.
+} BalanceMode;
+
+/**
+ * @brief Outcome of a run on per-CPU run queues.
+ */
+typedef struct {
+    long long pulls;                      ///< Balancing or stealing operations that moved work.
+    long long moved;                      ///< Waiting processes moved to another run queue.
+    long long migrations[MIGRATE_LEVELS]; ///< Resumes on another core, by distance.
+    long long penalty_time;               ///< Time lost to migration penalties.
+    long long idle_while_queued;          ///< Idle CPU time while processes waited on other CPUs.
+    int makespan;                         ///< Finish time of the last process.
+} BalanceStats;
+
+void computeBalancedRR(Process processes[], int n, int quantum, const Topology *topology, BalanceMode mode,
+                       BalanceStats *stats);
+void printBalanceStats(const Topology *topology, const BalanceStats *periodic, const BalanceStats *steal,
+                       FILE *out);
+
+#endif
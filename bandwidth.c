@@ -0,0 +1,441 @@
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include "bandwidth.h"
+#include "heap.h"
+
+#define FAIR_WEIGHT_SCALE 1024 ///< Virtual time units per unit of service at weight 1.
+
+static int compareInt(const void *a, const void *b) {
+    int x = *(const int *)a, y = *(const int *)b;
+    return (x > y) - (x < y);
+}
+
+static int compareLimits(const void *a, const void *b) {
+    return compareInt(&((const GroupLimit *)a)->group, &((const GroupLimit *)b)->group);
+}
+
+/**
+ * @brief Reads a bandwidth file.
+ *
+ * @param filename The file to read.
+ * @param config Receives the limits; the policy and quantum are left alone.
+ *
+ * @details
+ * One "group quota period" line per limited group, '#' starting a comment: the
+ * group may run quota time units in every period.  A "default quota period"
+ * line limits every group that is not listed; without one they are not
+ * limited.  A malformed line or a group listed twice is a fatal error.
+ */
+void loadBandwidth(const char *filename, BandwidthConfig *config) {
+    FILE *file = fopen(filename, "r");
+    if (!file) {
+        perror("Error opening bandwidth file");
+        exit(EXIT_FAILURE);
+    }
+
+    config->limits = NULL;
+    config->count = 0;
+    config->fallback = (GroupLimit){0, 0, 1};
+    int capacity = 0, line_number = 0;
+    char line[256], key[32];
+    while (fgets(line, sizeof(line), file)) {
+        line_number++;
+        line[strcspn(line, "#\r\n")] = '\0';
+        if (sscanf(line, "%31s", key) != 1)
+            continue;
+
+        GroupLimit limit;
+        char *end;
+        int valid = sscanf(line, "%*s %d %d", &limit.quota, &limit.period) == 2 && limit.quota >= 1 &&
+                    limit.period >= 1;
+        if (valid && strcmp(key, "default") == 0) {
+            limit.group = 0;
+            config->fallback = limit;
+        } else if (valid && (limit.group = (int)strtol(key, &end, 10), *end == '\0')) {
+            if (config->count == capacity) {
+                capacity = capacity ? 2 * capacity : 16;
+                config->limits = realloc(config->limits, capacity * sizeof(GroupLimit));
+                if (!config->limits) {
+                    perror("Error allocating bandwidth limits");
+                    exit(EXIT_FAILURE);
+                }
+            }
+            config->limits[config->count++] = limit;
+        } else {
+            fprintf(stderr, "Invalid bandwidth file %s, line %d: %s\n", filename, line_number, line);
+            exit(EXIT_FAILURE);
+        }
+    }
+    fclose(file);
+
+    qsort(config->limits, config->count, sizeof(GroupLimit), compareLimits);
+    for (int l = 1; l < config->count; l++) {
+        if (config->limits[l].group == config->limits[l - 1].group) {
+            fprintf(stderr, "Invalid bandwidth file %s: group %d is listed twice\n", filename,
+                    config->limits[l].group);
+            exit(EXIT_FAILURE);
+        }
+    }
+}
+
+/**
+ * @brief Releases the limits read by loadBandwidth.
+ */
+void freeBandwidth(BandwidthConfig *config) {
+    free(config->limits);
+    config->limits = NULL;
+    config->count = 0;
+}
+
+/**
+ * @brief Returns the limit of a group id: its own line, else the default one.
+ */
+GroupLimit groupLimit(const BandwidthConfig *config, int group) {
+    const GroupLimit key = {group, 0, 0};
+    const GroupLimit *found = config->count ? bsearch(&key, config->limits, config->count, sizeof(GroupLimit),
+                                                      compareLimits) : NULL;
+    return found ? *found : config->fallback;
+}
+
+typedef enum { GROUP_IDLE, GROUP_QUEUED, GROUP_RUNNING, GROUP_THROTTLED } GroupStateKind;
+
+/**
+ * @brief Bandwidth account and run queue of one group.
+ */
+typedef struct {
+    long long runtime;        ///< Runtime left in the current period.
+    long long period_index;   ///< Period the runtime belongs to, -1 before the first.
+    long long throttled_at;   ///< Start of the current throttling.
+    long long throttled_time; ///< Total time spent throttled.
+    long long vclock;         ///< GROUP_FAIR: virtual time new processes join at.
+    int quota, period;        ///< Bandwidth limit, quota 0 for none.
+    int id;                   ///< Group id, as in the group column.
+    GroupStateKind state;     ///< Where the group is.
+    int waiting;              ///< Processes of the group waiting for a turn.
+    int head, tail;           ///< GROUP_RR: waiting processes, linked through next.
+    int next_group;           ///< Next group of the rotation.
+    MinHeap fair;             ///< GROUP_FAIR: waiting processes by virtual time.
+} GroupState;
+
+/**
+ * @brief State of a bandwidth-controlled run.
+ */
+typedef struct {
+    const BandwidthConfig *config;
+    Process *processes;
+    GroupState *groups;
+    int *group_of;            ///< Dense group of each process.
+    int *next;                ///< GROUP_RR: next waiting process of the same group.
+    long long *vruntime;      ///< GROUP_FAIR: virtual time of each process.
+    int first, last;          ///< Rotation of the groups with work and quota left.
+    int throttled;            ///< Groups currently throttled.
+    MinHeap unthrottle;       ///< End of the period of each throttled group.
+    BandwidthStats *stats;
+} GroupScheduler;
+
+/**
+ * @brief Refills a limited group's runtime if a new period has started by `now`.
+ *
+ * Periods are aligned to multiples of the period from time 0, like a
+ * free-running period timer.
+ */
+static void refreshRuntime(GroupState *g, long long now) {
+    if (g->quota == 0 || now / g->period == g->period_index)
+        return;
+    g->period_index = now / g->period;
+    g->runtime = g->quota;
+}
+
+static void rotationAppend(GroupScheduler *s, int g) {
+    s->groups[g].state = GROUP_QUEUED;
+    s->groups[g].next_group = -1;
+    if (s->first < 0)
+        s->first = g;
+    else
+        s->groups[s->last].next_group = g;
+    s->last = g;
+}
+
+/**
+ * @brief Puts a group with work back in the rotation, or throttles it until
+ *        its next period if its quota is spent.
+ */
+static void requeueGroup(GroupScheduler *s, int g, long long now) {
+    GroupState *group = &s->groups[g];
+    refreshRuntime(group, now);
+    if (group->quota == 0 || group->runtime > 0) {
+        rotationAppend(s, g);
+        return;
+    }
+    group->state = GROUP_THROTTLED;
+    group->throttled_at = now;
+    s->throttled++;
+    s->stats->throttles++;
+    heapPush(&s->unthrottle, (group->period_index + 1) * group->period, g);
+}
+
+/**
+ * @brief Adds a process to the waiting processes of its group.
+ */
+static void pushProcess(GroupScheduler *s, int i) {
+    GroupState *group = &s->groups[s->group_of[i]];
+    group->waiting++;
+    if (s->config->policy == GROUP_FAIR) {
+        heapPush(&group->fair, s->vruntime[i], i);
+        return;
+    }
+    s->next[i] = -1;
+    if (group->head < 0)
+        group->head = i;
+    else
+        s->next[group->tail] = i;
+    group->tail = i;
+}
+
+/**
+ * @brief Removes and returns the process whose turn it is in a group.
+ */
+static int popProcess(GroupScheduler *s, GroupState *group) {
+    group->waiting--;
+    if (s->config->policy == GROUP_FAIR) {
+        return heapPop(&group->fair).value;
+    }
+    int i = group->head;
+    group->head = s->next[i];
+    return i;
+}
+
+/**
+ * @brief Advances the virtual time of a process after a run and the clock of its group.
+ *
+ * @details
+ * A run of several turns is charged turn by turn, so batching does not change
+ * the rounding.  The group clock, where new processes join, follows the least
+ * virtual time among the group's processes and never goes back, like the
+ * min_vruntime of a CFS run queue.
+ */
+static void chargeFair(GroupScheduler *s, GroupState *group, int i, long long run) {
+    long long quantum = s->config->quantum, weight = s->processes[i].weight;
+    s->vruntime[i] += run / quantum * (quantum * FAIR_WEIGHT_SCALE / weight) +
+                      run % quantum * FAIR_WEIGHT_SCALE / weight;
+    long long least = s->processes[i].remaining > 0 ? s->vruntime[i] : LLONG_MAX;
+    if (group->fair.size > 0 && group->fair.items[0].key < least)
+        least = group->fair.items[0].key;
+    if (least != LLONG_MAX && least > group->vclock)
+        group->vclock = least;
+}
+
+/**
+ * @brief Maps every process's group id to a dense index and sets up the groups.
+ */
+static void initGroups(GroupScheduler *s, int n) {
+    int *ids = malloc((n > 0 ? n : 1) * sizeof(int));
+    if (!ids) {
+        perror("Error allocating groups");
+        exit(EXIT_FAILURE);
+    }
+    for (int i = 0; i < n; i++)
+        ids[i] = s->processes[i].group;
+    qsort(ids, n, sizeof(int), compareInt);
+    int count = 0;
+    for (int i = 0; i < n; i++)
+        if (i == 0 || ids[i] != ids[i - 1])
+            ids[count++] = ids[i];
+
+    s->groups = malloc((count ? count : 1) * sizeof(GroupState));
+    if (!s->groups) {
+        perror("Error allocating groups");
+        exit(EXIT_FAILURE);
+    }
+    s->stats->groups = count;
+    for (int g = 0; g < count; g++) {
+        GroupLimit limit = groupLimit(s->config, ids[g]);
+        s->groups[g] = (GroupState){0, -1, 0, 0, 0, limit.quota, limit.period, ids[g], GROUP_IDLE, 0, -1, -1, -1,
+                                    {NULL, 0, 0}};
+        if (s->config->policy == GROUP_FAIR)
+            heapInit(&s->groups[g].fair, 1);
+        s->stats->limited += limit.quota > 0;
+    }
+    for (int i = 0; i < n; i++) {
+        const int *found = bsearch(&s->processes[i].group, ids, count, sizeof(int), compareInt);
+        s->group_of[i] = (int)(found - ids);
+    }
+    free(ids);
+}
+
+/**
+ * @brief Computes round robin among groups under per-group CPU bandwidth limits.
+ *
+ * @param processes An array of Process structures sorted by arrival, each
+ *                  belonging to the group of its group column (default 0).
+ * @param n The number of processes in the array.
+ * @param config The limits of the groups, the policy within each group and the
+ *               length of a turn.
+ * @param stats Receives the throttling statistics.
+ *
+ * @details
+ * The groups with waiting processes and quota left take turns of one quantum
+ * in a rotation, and each turn goes to the group's next process: the longest
+ * waiting one under GROUP_RR, the one with the least service per unit of
+ * weight under GROUP_FAIR.  A limited group's turn is also cut at the runtime
+ * left in its period, and the whole turn is charged to the period it started
+ * in, as the kernel charges the runtime a CPU has already pulled from the
+ * group's pool.  A group whose quota runs out while it still has work is
+ * throttled: it leaves the rotation and an unthrottle event at the start of
+ * its next period goes on the event queue.  Arrivals and unthrottle events up
+ * to the end of a turn join the rotation before the group that just ran.
+ *
+ * Each turn costs O(1) plus O(log g) per throttle event, g the throttled
+ * groups, so thousands of groups cost no more than a few.  While a single
+ * process is runnable, its turns up to the next event run as one.
+ */
+void computeBandwidth(Process processes[], int n, const BandwidthConfig *config, BandwidthStats *stats) {
+    int quantum = config->quantum;
+    GroupScheduler s = {config, processes, NULL, malloc((n ? n : 1) * sizeof(int)),
+                        malloc((n ? n : 1) * sizeof(int)), calloc(n ? n : 1, sizeof(long long)), -1, -1, 0,
+                        {NULL, 0, 0}, stats};
+    if (!s.group_of || !s.next || !s.vruntime) {
+        perror("Error allocating group run queues");
+        exit(EXIT_FAILURE);
+    }
+    for (int i = 0; i < n; i++) {
+        if (config->policy == GROUP_FAIR && processes[i].weight < 1) {
+            fprintf(stderr, "Invalid trace: process %d has weight %d, fair share needs at least 1\n",
+                    processes[i].id, processes[i].weight);
+            exit(EXIT_FAILURE);
+        }
+        processes[i].remaining = processes[i].burst;
+        processes[i].start_time = -1;
+        processes[i].finish_time = -1;
+    }
+    *stats = (BandwidthStats){0};
+    stats->max_throttled_group = -1;
+    initGroups(&s, n);
+    heapInit(&s.unthrottle, 16);
+
+    int idx = 0, completed = 0, current = -1;
+    long long now = 0;
+
+    while (completed < n) {
+        while (s.unthrottle.size > 0 && s.unthrottle.items[0].key <= now) {
+            HeapItem event = heapPop(&s.unthrottle);
+            GroupState *group = &s.groups[event.value];
+            group->throttled_time += event.key - group->throttled_at;
+            s.throttled--;
+            refreshRuntime(group, event.key);
+            rotationAppend(&s, event.value);
+        }
+        for (; idx < n && processes[idx].arrival <= now; idx++) {
+            int g = s.group_of[idx];
+            if (config->policy == GROUP_FAIR)
+                s.vruntime[idx] = s.groups[g].vclock;
+            pushProcess(&s, idx);
+            if (s.groups[g].state == GROUP_IDLE)
+                requeueGroup(&s, g, now);
+        }
+        if (current >= 0) {
+            int g = s.group_of[current];
+            if (processes[current].remaining > 0)
+                pushProcess(&s, current);
+            if (s.groups[g].waiting > 0)
+                requeueGroup(&s, g, now);
+            else
+                s.groups[g].state = GROUP_IDLE;
+            current = -1;
+        }
+
+        if (s.first < 0) {
+            long long next = idx < n ? processes[idx].arrival : LLONG_MAX;
+            if (s.unthrottle.size > 0 && s.unthrottle.items[0].key < next)
+                next = s.unthrottle.items[0].key;
+            if (s.throttled > 0)
+                stats->idle_throttled += next - now;
+            now = next;
+            continue;
+        }
+
+        int g = s.first;
+        GroupState *group = &s.groups[g];
+        s.first = group->next_group;
+        group->state = GROUP_RUNNING;
+        refreshRuntime(group, now);
+        int i = popProcess(&s, group);
+
+        long long run = processes[i].remaining < quantum ? processes[i].remaining : quantum;
+        if (group->quota > 0 && group->runtime < run)
+            run = group->runtime;
+        if (s.first < 0 && group->waiting == 0 && run == quantum) {
+            // Alone on the CPU: the next turns are its own until something happens.
+            long long horizon = idx < n ? processes[idx].arrival : LLONG_MAX;
+            if (s.unthrottle.size > 0 && s.unthrottle.items[0].key < horizon)
+                horizon = s.unthrottle.items[0].key;
+            if (group->quota > 0 && (group->period_index + 1) * group->period < horizon)
+                horizon = (group->period_index + 1) * group->period;
+            long long turns = horizon == LLONG_MAX ? LLONG_MAX : (horizon - now + quantum - 1) / quantum;
+            if (turns > 1) {
+                run = processes[i].remaining;
+                if (group->quota > 0 && group->runtime < run)
+                    run = group->runtime;
+                if (turns < (run + quantum - 1) / quantum)
+                    run = turns * quantum;
+            }
+        }
+
+        if (processes[i].start_time == -1)
+            processes[i].start_time = (int)now;
+        now += run;
+        processes[i].remaining -= (int)run;
+        if (group->quota > 0)
+            group->runtime -= run;
+        if (processes[i].remaining == 0) {
+            processes[i].finish_time = (int)now;
+            completed++;
+        }
+        if (config->policy == GROUP_FAIR)
+            chargeFair(&s, group, i, run);
+        current = i;
+        stats->decisions++;
+    }
+    stats->makespan = (int)now;
+
+    for (int g = 0; g < stats->groups; g++) {
+        GroupState *group = &s.groups[g];
+        stats->throttled_time += group->throttled_time;
+        stats->throttled_groups += group->throttled_time > 0;
+        if (group->throttled_time > stats->max_throttled) {
+            stats->max_throttled = group->throttled_time;
+            stats->max_throttled_group = group->id;
+        }
+        if (config->policy == GROUP_FAIR)
+            heapFree(&group->fair);
+    }
+
+    heapFree(&s.unthrottle);
+    free(s.groups);
+    free(s.vruntime);
+    free(s.next);
+    free(s.group_of);
+}
+
+/**
+ * @brief Prints how much the bandwidth limits throttled the groups and what it did to latency.
+ */
+void printBandwidthStats(const BandwidthConfig *config, const BandwidthStats *stats, const LatencySummary *unlimited,
+                         const LatencySummary *limited, FILE *out) {
+    static const char *const names[] = {"groups", "bandwidth"};
+    LatencySummary summaries[2] = {*unlimited, *limited};
+    fprintf(out, "\nCPU Bandwidth (%d groups, %d limited, %s within groups):\n", stats->groups, stats->limited,
+            config->policy == GROUP_FAIR ? "fair share" : "round robin");
+    fprintf(out, "Throttle Events: %lld (%d groups throttled)\n", stats->throttles, stats->throttled_groups);
+    fprintf(out, "Throttled Time: %lld", stats->throttled_time);
+    if (stats->max_throttled > 0)
+        fprintf(out, " (longest %lld, group %d)", stats->max_throttled, stats->max_throttled_group);
+    fprintf(out, "\n");
+    fprintf(out, "CPU Idle While Throttled: %lld (%.2f%% of the makespan)\n", stats->idle_throttled,
+            stats->makespan ? 100.0 * stats->idle_throttled / stats->makespan : 0.0);
+    fprintf(out, "p99 Response Time: %d without limits, %d with limits (%+d)\n", unlimited->rt_p99,
+            limited->rt_p99, limited->rt_p99 - unlimited->rt_p99);
+    fprintf(out, "\nLatency Distribution:\n");
+    printLatencyTable(names, summaries, 2, out);
+}
@@ -0,0 +1,59 @@
+#ifndef BANDWIDTH_H
+#define BANDWIDTH_H
+
+#include <stdio.h>
+#include "process.h"
+#include "groupby.h"
+
+/**
+ * @brief How the processes of a group share the group's turns.
+ */
+typedef enum {
+    GROUP_RR,  ///< Round robin in arrival order.
+    GROUP_FAIR ///< The process with the least service per unit of weight first.
+} GroupPolicy;
+
+/**
+ * @brief CPU bandwidth limit of a group: quota time units in every period.
+ */
+typedef struct {
+    int group;  ///< Group id, as in the group column.
+    int quota;  ///< Runtime allowed per period, 0 for no limit.
+    int period; ///< Length of a period.
+} GroupLimit;
+
+/**
+ * @brief Groups, limits and scheduling of a bandwidth-controlled run.
+ */
+typedef struct {
+    GroupLimit *limits;  ///< Limits of the listed groups, sorted by group.
+    int count;           ///< Listed groups.
+    GroupLimit fallback; ///< Limit of the groups not listed (quota 0 for none).
+    GroupPolicy policy;  ///< Scheduling within each group.
+    int quantum;         ///< Length of a turn.
+} BandwidthConfig;
+
+/**
+ * @brief Throttling of a bandwidth-controlled run.
+ */
+typedef struct {
+    int groups;                ///< Distinct groups in the trace.
+    int limited;               ///< Groups with a quota.
+    int throttled_groups;      ///< Groups throttled at least once.
+    long long throttles;       ///< Times a group ran out of quota with work left.
+    long long throttled_time;  ///< Time groups spent throttled, summed over groups.
+    long long max_throttled;   ///< Longest total throttled time of a group.
+    int max_throttled_group;   ///< Group id of the longest total throttled time.
+    long long idle_throttled;  ///< CPU idle time while only throttled groups had work.
+    long long decisions;       ///< Turns handed out.
+    int makespan;              ///< Finish time of the last process.
+} BandwidthStats;
+
+void loadBandwidth(const char *filename, BandwidthConfig *config);
+void freeBandwidth(BandwidthConfig *config);
+GroupLimit groupLimit(const BandwidthConfig *config, int group);
+void computeBandwidth(Process processes[], int n, const BandwidthConfig *config, BandwidthStats *stats);
+void printBandwidthStats(const BandwidthConfig *config, const BandwidthStats *stats, const LatencySummary *unlimited,
+                         const LatencySummary *limited, FILE *out);
+
+#endif
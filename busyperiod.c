@@ -0,0 +1,271 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <limits.h>
+#include <stdatomic.h>
+#include <pthread.h>
+#include "busyperiod.h"
+
+/**
+ * @brief A max-plus affine map f(x) = max(x + shift, top).
+ *
+ * The FCFS completion recurrence C_i = max(C_{i-1}, arrival_i) + burst_i is the
+ * map (top = arrival_i + burst_i, shift = burst_i) applied to C_{i-1}.  These
+ * maps are closed under composition, which is associative, so the completion
+ * times of a whole trace are a prefix scan that can be split across threads.
+ */
+typedef struct {
+    long long top;
+    long long shift;
+} MaxPlus;
+
+#define MAXPLUS_NEG_INF (LLONG_MIN / 4)
+
+/**
+ * @brief Returns the map "apply f, then g".
+ */
+static MaxPlus composeMaxPlus(MaxPlus f, MaxPlus g) {
+    MaxPlus h;
+    long long through = f.top == MAXPLUS_NEG_INF ? MAXPLUS_NEG_INF : f.top + g.shift;
+    h.top = through > g.top ? through : g.top;
+    h.shift = f.shift + g.shift;
+    return h;
+}
+
+typedef struct {
+    const Process *processes;
+    int begin, end;        ///< Slice [begin, end) of the trace.
+    MaxPlus composite;     ///< Phase 1: map of the whole slice.
+    long long completion;  ///< Completion time of the work before the slice.
+    int count;             ///< Phase 2: busy periods starting in the slice.
+    int *starts;           ///< Phase 3: where to write the slice's period starts.
+} ScanTask;
+
+typedef enum { SCAN_COMPOSE, SCAN_COUNT, SCAN_FILL } ScanPhase;
+
+typedef struct {
+    ScanTask *task;
+    ScanPhase phase;
+} ScanJob;
+
+/**
+ * @brief Runs one phase of the busy-period scan over a slice.
+ *
+ * @details
+ * A process starts a busy period when it arrives after all earlier work has
+ * completed.  The first process always starts one.
+ */
+static void *scanSlice(void *arg) {
+    ScanJob *job = arg;
+    ScanTask *task = job->task;
+    const Process *p = task->processes;
+
+    if (job->phase == SCAN_COMPOSE) {
+        MaxPlus acc = {MAXPLUS_NEG_INF, 0};
+        for (int i = task->begin; i < task->end; i++) {
+            MaxPlus step = {(long long)p[i].arrival + p[i].burst, p[i].burst};
+            acc = composeMaxPlus(acc, step);
+        }
+        task->composite = acc;
+        return NULL;
+    }
+
+    long long completion = task->completion;
+    int count = 0;
+    for (int i = task->begin; i < task->end; i++) {
+        if (i == 0 || p[i].arrival > completion) {
+            if (job->phase == SCAN_FILL)
+                task->starts[count] = i;
+            count++;
+        }
+        completion = (p[i].arrival > completion ? p[i].arrival : completion) + p[i].burst;
+    }
+    task->count = count;
+    return NULL;
+}
+
+/**
+ * @brief Runs a scan phase on every task, one thread per task.
+ */
+static void runScanPhase(ScanTask tasks[], int threads, ScanPhase phase) {
+    pthread_t *workers = malloc(threads * sizeof(pthread_t));
+    ScanJob *jobs = malloc(threads * sizeof(ScanJob));
+    if (!workers || !jobs) {
+        perror("Error allocating scan threads");
+        exit(EXIT_FAILURE);
+    }
+    for (int t = 0; t < threads; t++) {
+        jobs[t].task = &tasks[t];
+        jobs[t].phase = phase;
+        if (t > 0 && pthread_create(&workers[t], NULL, scanSlice, &jobs[t]) != 0) {
+            perror("Error creating worker thread");
+            exit(EXIT_FAILURE);
+        }
+    }
+    scanSlice(&jobs[0]);
+    for (int t = 1; t < threads; t++)
+        pthread_join(workers[t], NULL);
+    free(jobs);
+    free(workers);
+}
+
+/**
+ * @brief Splits a trace sorted by arrival into independent busy periods.
+ *
+ * @param processes An array of Process structures sorted by arrival.
+ * @param n The number of processes in the array.
+ * @param threads The number of threads for the scan.
+ * @param starts Receives a heap-allocated array with the first process index of
+ *               every busy period, followed by n.  The caller releases it with free().
+ * @return The number of busy periods.
+ *
+ * @details
+ * Three parallel passes over equal slices: compose each slice's max-plus map,
+ * count the period starts once the completion time entering each slice is known
+ * from an exclusive scan of the slice maps, then write them at their offsets.
+ */
+int findBusyPeriods(const Process processes[], int n, int threads, int **starts) {
+    if (threads < 1)
+        threads = 1;
+    if (threads > n)
+        threads = n > 0 ? n : 1;
+
+    ScanTask *tasks = malloc(threads * sizeof(ScanTask));
+    if (!tasks) {
+        perror("Error allocating scan slices");
+        exit(EXIT_FAILURE);
+    }
+    for (int t = 0; t < threads; t++) {
+        tasks[t].processes = processes;
+        tasks[t].begin = (int)((long long)n * t / threads);
+        tasks[t].end = (int)((long long)n * (t + 1) / threads);
+    }
+
+    runScanPhase(tasks, threads, SCAN_COMPOSE);
+    MaxPlus prefix = {MAXPLUS_NEG_INF, 0};
+    for (int t = 0; t < threads; t++) {
+        long long from_zero = prefix.shift; // The CPU is free from time 0.
+        tasks[t].completion = prefix.top > from_zero ? prefix.top : from_zero;
+        prefix = composeMaxPlus(prefix, tasks[t].composite);
+    }
+
+    runScanPhase(tasks, threads, SCAN_COUNT);
+    int total = 0;
+    for (int t = 0; t < threads; t++)
+        total += tasks[t].count;
+
+    *starts = malloc((total + 1) * sizeof(int));
+    if (!*starts) {
+        perror("Error allocating busy periods");
+        exit(EXIT_FAILURE);
+    }
+    for (int t = 0, offset = 0; t < threads; t++) {
+        tasks[t].starts = *starts + offset;
+        offset += tasks[t].count;
+    }
+    runScanPhase(tasks, threads, SCAN_FILL);
+    (*starts)[total] = n;
+    free(tasks);
+    return total;
+}
+
+typedef struct {
+    Process *processes;
+    const int *starts;
+    const int *order;      ///< Period indices, largest period first.
+    int periods;
+    int quantum;
+    ScheduleEngine engine;
+    atomic_int next;       ///< Next position of order to hand out.
+} PeriodPool;
+
+/**
+ * @brief Worker loop: schedules busy periods until none are left.
+ *
+ * @details
+ * Each period is shifted to start at time 0 before it is handed to the engine
+ * and shifted back afterwards, so engines that step through idle time from 0
+ * pay nothing for the time before the period.
+ */
+static void *runPeriods(void *arg) {
+    PeriodPool *pool = arg;
+    for (;;) {
+        int k = atomic_fetch_add(&pool->next, 1);
+        if (k >= pool->periods)
+            return NULL;
+
+        int period = pool->order[k];
+        Process *p = pool->processes + pool->starts[period];
+        int len = pool->starts[period + 1] - pool->starts[period];
+        int base = p[0].arrival;
+
+        for (int i = 0; i < len; i++)
+            p[i].arrival -= base;
+        pool->engine(p, len, pool->quantum);
+        for (int i = 0; i < len; i++) {
+            p[i].arrival += base;
+            p[i].start_time += base;
+            p[i].finish_time += base;
+        }
+    }
+}
+
+static const int *sort_starts;
+
+static int compareBySizeDesc(const void *a, const void *b) {
+    int x = *(const int *)a, y = *(const int *)b;
+    int size_x = sort_starts[x + 1] - sort_starts[x], size_y = sort_starts[y + 1] - sort_starts[y];
+    return (size_y > size_x) - (size_y < size_x);
+}
+
+/**
+ * @brief Schedules a trace by running an engine on each busy period concurrently.
+ *
+ * @param processes An array of Process structures sorted by arrival.
+ * @param n The number of processes in the array.
+ * @param quantum The time quantum passed to the engine.
+ * @param threads The number of worker threads.
+ * @param engine The single-CPU engine to run on every busy period.
+ * @return The number of busy periods.
+ *
+ * @details
+ * Under a work-conserving single-CPU policy the CPU is idle exactly between busy
+ * periods, and nothing carries over an idle gap, so scheduling each period on its
+ * own gives exactly the schedule of the whole trace.  Periods are handed out
+ * largest first to keep the threads evenly loaded.
+ */
+int computeByBusyPeriods(Process processes[], int n, int quantum, int threads, ScheduleEngine engine) {
+    int *starts;
+    int periods = findBusyPeriods(processes, n, threads, &starts);
+    int *order = malloc(periods * sizeof(int));
+    if (!order) {
+        perror("Error allocating busy periods");
+        exit(EXIT_FAILURE);
+    }
+    for (int k = 0; k < periods; k++)
+        order[k] = k;
+    sort_starts = starts;
+    qsort(order, periods, sizeof(int), compareBySizeDesc);
+
+    PeriodPool pool = {processes, starts, order, periods, quantum, engine, 0};
+    if (threads > periods)
+        threads = periods > 0 ? periods : 1;
+    pthread_t *workers = malloc(threads * sizeof(pthread_t));
+    if (!workers) {
+        perror("Error allocating worker threads");
+        exit(EXIT_FAILURE);
+    }
+    for (int t = 1; t < threads; t++) {
+        if (pthread_create(&workers[t], NULL, runPeriods, &pool) != 0) {
+            perror("Error creating worker thread");
+            exit(EXIT_FAILURE);
+        }
+    }
+    runPeriods(&pool);
+    for (int t = 1; t < threads; t++)
+        pthread_join(workers[t], NULL);
+
+    free(workers);
+    free(order);
+    free(starts);
+    return periods;
+}
@@ -0,0 +1,14 @@
+#ifndef BUSYPERIOD_H
+#define BUSYPERIOD_H
+
+#include "process.h"
+
+/**
+ * @brief A single-CPU scheduling engine that fills start and finish times in place.
+ */
+typedef void (*ScheduleEngine)(Process processes[], int n, int quantum);
+
+int findBusyPeriods(const Process processes[], int n, int threads, int **starts);
+int computeByBusyPeriods(Process processes[], int n, int quantum, int threads, ScheduleEngine engine);
+
+#endif
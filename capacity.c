@@ -0,0 +1,229 @@
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include "capacity.h"
+
+/**
+ * @brief Result of simulating one CPU count.
+ */
+typedef struct {
+    int cpus;          ///< CPU count simulated.
+    long long value;   ///< The percentile of the metric.
+    double avg_tat;    ///< Average turnaround time.
+    double avg_rt;     ///< Average response time.
+} Candidate;
+
+/**
+ * @brief Work of one thread: simulate a CPU count on a private copy of the trace.
+ */
+typedef struct {
+    const Process *processes;
+    int n;
+    const CapacityQuery *query;
+    Process *table;     ///< Private schedule, reused across rounds.
+    long long *values;  ///< Private metric values, reused across rounds.
+    Candidate result;
+} CapacityTask;
+
+static int compareCandidates(const void *a, const void *b) {
+    const Candidate *x = a, *y = b;
+    return (x->cpus > y->cpus) - (x->cpus < y->cpus);
+}
+
+/**
+ * @brief Returns the k-th smallest of values[0, n) in expected O(n), reordering them.
+ */
+static long long selectKth(long long values[], int n, int k) {
+    int lo = 0, hi = n - 1;
+    unsigned seed = 12345;
+    while (lo < hi) {
+        seed = seed * 1103515245u + 12345u;
+        long long pivot = values[lo + (int)(seed % (unsigned)(hi - lo + 1))];
+        int i = lo, lt = lo, gt = hi;
+        while (i <= gt) {
+            if (values[i] < pivot) {
+                long long t = values[i]; values[i++] = values[lt]; values[lt++] = t;
+            } else if (values[i] > pivot) {
+                long long t = values[i]; values[i] = values[gt]; values[gt--] = t;
+            } else {
+                i++;
+            }
+        }
+        if (k < lt)
+            hi = lt - 1;
+        else if (k > gt)
+            lo = gt + 1;
+        else
+            return pivot;
+    }
+    return values[lo];
+}
+
+static void *simulateCandidate(void *arg) {
+    CapacityTask *task = arg;
+    const CapacityQuery *query = task->query;
+    int n = task->n;
+
+    memcpy(task->table, task->processes, n * sizeof(Process));
+    computeMulti(task->table, n, task->result.cpus, query->policy, query->quantum);
+
+    double total_tat = 0, total_rt = 0;
+    for (int i = 0; i < n; i++) {
+        long long tat = task->table[i].finish_time - task->table[i].arrival;
+        long long rt = task->table[i].start_time - task->table[i].arrival;
+        total_tat += tat;
+        total_rt += rt;
+        task->values[i] = query->turnaround ? tat : rt;
+    }
+    // Nearest-rank percentile.
+    int rank = (int)((query->percentile / 100.0) * n + 0.999999) - 1;
+    rank = rank < 0 ? 0 : rank >= n ? n - 1 : rank;
+    task->result.value = selectKth(task->values, n, rank);
+    task->result.avg_tat = total_tat / n;
+    task->result.avg_rt = total_rt / n;
+    return NULL;
+}
+
+static int compareLongLong(const void *a, const void *b) {
+    long long x = *(const long long *)a, y = *(const long long *)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Returns the most processes ever in the system if nobody waited.
+ *
+ * @details
+ * With that many CPUs every process starts on arrival under either policy, so
+ * more CPUs cannot lower any latency.  Sweep over the sorted arrivals and the
+ * sorted finish times of the wait-free schedule.
+ */
+static int maxOverlap(const Process processes[], int n) {
+    long long *ends = malloc(n * sizeof(long long));
+    if (n > 0 && !ends) {
+        perror("Error allocating capacity plan");
+        exit(EXIT_FAILURE);
+    }
+    for (int i = 0; i < n; i++)
+        ends[i] = (long long)processes[i].arrival + (processes[i].burst > 0 ? processes[i].burst : 1);
+    qsort(ends, n, sizeof(long long), compareLongLong);
+
+    int in_system = 0, most = 0;
+    for (int i = 0, j = 0; i < n; i++) {
+        for (; j < n && ends[j] <= processes[i].arrival; j++)
+            in_system--;
+        if (++in_system > most)
+            most = in_system;
+    }
+    free(ends);
+    return most;
+}
+
+/**
+ * @brief Finds the fewest CPUs that keep a latency percentile below an objective.
+ *
+ * @param processes An array of Process structures sorted by arrival (not modified).
+ * @param n The number of processes in the array.
+ * @param query The objective and the system.
+ * @param out Where to print the plan.
+ * @return The minimum CPU count, or -1 if no CPU count meets the objective.
+ *
+ * @details
+ * The search interval starts at (0, m], where m is the most processes ever
+ * in the system with no waiting; m CPUs give the best latency any CPU count can.
+ * Each round simulates up to query->threads CPU counts spread evenly over the
+ * interval, one per thread, each on its own copy of the trace, and keeps the
+ * gap between the largest failing count and the smallest passing one.  So the
+ * interval shrinks by a factor of threads + 1 per round, and with one thread
+ * this is a binary search.  Latency is assumed not to grow with more CPUs.
+ */
+int planCapacity(const Process processes[], int n, const CapacityQuery *query, FILE *out) {
+    int threads = query->threads;
+    CapacityTask *tasks = calloc(threads, sizeof(CapacityTask));
+    pthread_t *workers = malloc(threads * sizeof(pthread_t));
+    Candidate *evaluated = NULL;
+    int evaluated_count = 0, rounds = 0;
+    if (!tasks || !workers) {
+        perror("Error allocating capacity plan");
+        exit(EXIT_FAILURE);
+    }
+    for (int t = 0; t < threads; t++) {
+        tasks[t].processes = processes;
+        tasks[t].n = n;
+        tasks[t].query = query;
+        tasks[t].table = malloc((n > 0 ? n : 1) * sizeof(Process));
+        tasks[t].values = malloc((n > 0 ? n : 1) * sizeof(long long));
+        if (!tasks[t].table || !tasks[t].values) {
+            perror("Error allocating capacity plan");
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    // The answer lies in (lo, hi]; hi is only known to pass after the first round.
+    int lo = 0, hi = maxOverlap(processes, n), hi_known = 0, best = n > 0 ? -1 : 0;
+    if (hi < 1)
+        hi = 1;
+    while (n > 0 && (!hi_known || hi - lo > 1)) {
+        // The first round includes hi itself; later rounds split the open gap (lo, hi).
+        int gap = hi_known ? hi - lo - 1 : hi - lo;
+        int k = gap < threads ? gap : threads;
+        for (int t = 0; t < k; t++) {
+            tasks[t].result.cpus = hi_known ? lo + (int)((long long)(hi - lo) * (t + 1) / (k + 1))
+                                            : lo + (int)((long long)(hi - lo) * (t + 1) / k);
+            if (k > 1 && pthread_create(&workers[t], NULL, simulateCandidate, &tasks[t]) != 0) {
+                perror("Error creating capacity worker");
+                exit(EXIT_FAILURE);
+            }
+        }
+        if (k == 1)
+            simulateCandidate(&tasks[0]);
+        else
+            for (int t = 0; t < k; t++)
+                pthread_join(workers[t], NULL);
+        rounds++;
+
+        evaluated = realloc(evaluated, (evaluated_count + k) * sizeof(Candidate));
+        if (!evaluated) {
+            perror("Error allocating capacity plan");
+            exit(EXIT_FAILURE);
+        }
+        int passing = hi_known ? hi : -1;
+        for (int t = 0; t < k; t++) {
+            evaluated[evaluated_count++] = tasks[t].result;
+            if (tasks[t].result.value < query->slo && (passing < 0 || tasks[t].result.cpus < passing))
+                passing = tasks[t].result.cpus;
+        }
+        if (passing < 0)
+            break; // Even the no-waiting CPU count misses the objective.
+        for (int t = 0; t < k; t++)
+            if (tasks[t].result.value >= query->slo && tasks[t].result.cpus < passing && tasks[t].result.cpus > lo)
+                lo = tasks[t].result.cpus;
+        hi = passing;
+        hi_known = 1;
+        best = hi;
+    }
+
+    qsort(evaluated, evaluated_count, sizeof(Candidate), compareCandidates);
+    const char *metric = query->turnaround ? "turnaround" : "response";
+    fprintf(out, "Capacity Plan: p%g %s < %lld under %s", query->percentile, metric, query->slo,
+            multiPolicyName(query->policy));
+    if (query->policy == MULTI_RR)
+        fprintf(out, " (Quantum=%d)", query->quantum);
+    fprintf(out, "\n%6s %14s %14s %14s\n", "CPUs", metric, "avg tat", "avg rt");
+    for (int i = 0; i < evaluated_count; i++)
+        fprintf(out, "%6d %14lld %14.2f %14.2f%s\n", evaluated[i].cpus, evaluated[i].value,
+                evaluated[i].avg_tat, evaluated[i].avg_rt, evaluated[i].cpus == best ? "  <-" : "");
+    if (best >= 0)
+        fprintf(out, "Minimum CPUs: %d\n", best);
+    else
+        fprintf(out, "Minimum CPUs: none, the objective is missed even when no process waits\n");
+    fprintf(out, "Simulated %d CPU counts in %d rounds on %d threads\n", evaluated_count, rounds, threads);
+
+    for (int t = 0; t < threads; t++) {
+        free(tasks[t].table);
+        free(tasks[t].values);
+    }
+    free(evaluated);
+    free(workers);
+    free(tasks);
+    return best;
+}
@@ -0,0 +1,22 @@
+#ifndef CAPACITY_H
+#define CAPACITY_H
+
+#include <stdio.h>
+#include "process.h"
+#include "multicpu.h"
+
+/**
+ * @brief A latency objective and the system it is planned for.
+ */
+typedef struct {
+    long long slo;       ///< The percentile must stay strictly below this.
+    double percentile;   ///< Percentile of the per-process metric, in (0, 100].
+    int turnaround;      ///< Non-zero for turnaround time, zero for response time.
+    MultiPolicy policy;  ///< Discipline of the shared queue.
+    int quantum;         ///< RR time quantum.
+    int threads;         ///< Candidate CPU counts simulated at once.
+} CapacityQuery;
+
+int planCapacity(const Process processes[], int n, const CapacityQuery *query, FILE *out);
+
+#endif
@@ -0,0 +1,289 @@
+#include <stdlib.h>
+#include <limits.h>
+#include "cbs.h"
+#include "heap.h"
+
+/**
+ * @brief A constant bandwidth server: a budget, a deadline and a FIFO of jobs.
+ */
+typedef struct {
+    long long budget;   ///< Budget left, c_s.
+    long long deadline; ///< Current scheduling deadline, d_s.
+    int quota, period;  ///< Maximum budget Q_s and period T_s.
+    int head, tail;     ///< Pending jobs, linked through next.
+    int pending;        ///< Jobs not finished.
+} Server;
+
+static int compareInt(const void *a, const void *b) {
+    int x = *(const int *)a, y = *(const int *)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Gives every process the server of its group, or -1 for best effort.
+ *
+ * @return The servers, one per distinct group with a limit.
+ */
+static Server *initServers(const Process processes[], int n, const BandwidthConfig *config, int *server_of,
+                           CBSStats *stats) {
+    int *ids = malloc((n > 0 ? n : 1) * sizeof(int));
+    if (!ids) {
+        perror("Error allocating servers");
+        exit(EXIT_FAILURE);
+    }
+    for (int i = 0; i < n; i++)
+        ids[i] = processes[i].group;
+    qsort(ids, n, sizeof(int), compareInt);
+    int groups = 0;
+    for (int i = 0; i < n; i++)
+        if (i == 0 || ids[i] != ids[i - 1])
+            ids[groups++] = ids[i];
+
+    Server *servers = malloc((groups ? groups : 1) * sizeof(Server));
+    int *server_of_group = malloc((groups ? groups : 1) * sizeof(int));
+    if (!servers || !server_of_group) {
+        perror("Error allocating servers");
+        exit(EXIT_FAILURE);
+    }
+    for (int g = 0; g < groups; g++) {
+        GroupLimit limit = groupLimit(config, ids[g]);
+        server_of_group[g] = -1;
+        if (limit.quota == 0)
+            continue;
+        server_of_group[g] = stats->servers;
+        servers[stats->servers++] = (Server){0, 0, limit.quota, limit.period, -1, -1, 0};
+        stats->bandwidth += (double)limit.quota / limit.period;
+    }
+    for (int i = 0; i < n; i++) {
+        const int *found = bsearch(&processes[i].group, ids, groups, sizeof(int), compareInt);
+        server_of[i] = server_of_group[found - ids];
+    }
+    free(server_of_group);
+    free(ids);
+    return servers;
+}
+
+/**
+ * @brief Returns non-zero if server a has priority over server b under EDF
+ *        (earlier deadline, then lower index).
+ */
+static int edfBefore(const Server *servers, int a, int b) {
+    return servers[a].deadline < servers[b].deadline || (servers[a].deadline == servers[b].deadline && a < b);
+}
+
+/**
+ * @brief Computes constant bandwidth servers under EDF, with best-effort RR in the background.
+ *
+ * @param processes An array of Process structures sorted by arrival.  A process
+ *                  whose group has a limit in `servers` is a reserved job of
+ *                  that group's server; the others are best effort.
+ * @param n The number of processes in the array.
+ * @param servers Budget (quota) and period of each group's server, and the RR
+ *                quantum of the best-effort processes.
+ * @param stats Receives the server statistics.
+ *
+ * @details
+ * Each server serves its jobs in arrival order.  A job arriving at an idle
+ * server keeps the server's budget and deadline if they still fit the
+ * server's bandwidth, c_s < (d_s - t) * Q_s / T_s, and otherwise resets them
+ * to Q_s and t + T_s.  Running drains the budget; when it hits zero it is
+ * recharged to Q_s and the deadline postponed by T_s, so an overrunning
+ * server keeps running at a later deadline instead of stealing bandwidth.
+ * The ready server of earliest deadline runs, preempting a server of later
+ * deadline when a job arrives, and best-effort processes share whatever time
+ * the servers leave, in RR slices of the quantum.  A best-effort process
+ * preempted by a server resumes first, with a new slice, once the servers are
+ * idle.
+ *
+ * Time jumps from event to event (arrival, completion, budget exhaustion,
+ * slice end), and the ready servers sit in a MinHeap by deadline, so an event
+ * costs O(log s) for s servers.
+ */
+void computeCBS(Process processes[], int n, const BandwidthConfig *servers, CBSStats *stats) {
+    int quantum = servers->quantum;
+    int *server_of = malloc((n > 0 ? n : 1) * sizeof(int));
+    int *next = malloc((n > 0 ? n : 1) * sizeof(int));
+    int *queue = malloc((n > 0 ? n : 1) * sizeof(int));
+    if (!server_of || !next || !queue) {
+        perror("Error allocating servers");
+        exit(EXIT_FAILURE);
+    }
+    for (int i = 0; i < n; i++) {
+        processes[i].remaining = processes[i].burst;
+        processes[i].start_time = -1;
+        processes[i].finish_time = -1;
+    }
+    *stats = (CBSStats){0};
+    Server *server = initServers(processes, n, servers, server_of, stats);
+    MinHeap ready;
+    heapInit(&ready, stats->servers);
+
+    int idx = 0, completed = 0, running = -1, best_effort = -1, slice = 0;
+    int front = 0, size = 0; // Best-effort queue: a ring of n slots.
+    long long now = 0;
+
+    while (completed < n) {
+        if (running < 0 && best_effort < 0 && ready.size == 0 && size == 0 && processes[idx].arrival > now)
+            now = processes[idx].arrival;
+
+        for (; idx < n && processes[idx].arrival <= now; idx++) {
+            int s = server_of[idx];
+            if (s < 0) {
+                queue[(front + size++) % n] = idx;
+                continue;
+            }
+            Server *srv = &server[s];
+            if (srv->pending == 0 && s != running) {
+                if (srv->budget * srv->period >= (srv->deadline - now) * srv->quota) {
+                    srv->budget = srv->quota;
+                    srv->deadline = now + srv->period;
+                    stats->replenishments++;
+                }
+                heapPush(&ready, srv->deadline, s);
+            }
+            next[idx] = -1;
+            if (srv->head < 0)
+                srv->head = idx;
+            else
+                next[srv->tail] = idx;
+            srv->tail = idx;
+            srv->pending++;
+        }
+
+        // A best-effort slice ends after the arrivals of its last instant, as in RR.
+        if (best_effort >= 0 && slice == 0) {
+            queue[(front + size++) % n] = best_effort;
+            best_effort = -1;
+        }
+        if (ready.size > 0) {
+            if (running >= 0 && edfBefore(server, ready.items[0].value, running)) {
+                heapPush(&ready, server[running].deadline, running);
+                running = -1;
+                stats->preemptions++;
+            }
+            if (best_effort >= 0) {
+                front = (front + n - 1) % n;
+                queue[front] = best_effort;
+                size++;
+                best_effort = -1;
+                stats->preemptions++;
+            }
+        }
+        if (running < 0 && best_effort < 0) {
+            if (ready.size > 0) {
+                running = heapPop(&ready).value;
+            } else if (size > 0) {
+                best_effort = queue[front];
+                front = (front + 1) % n;
+                size--;
+                slice = quantum;
+            } else {
+                continue;
+            }
+        }
+
+        long long horizon = idx < n ? processes[idx].arrival - now : LLONG_MAX;
+        if (running >= 0) {
+            Server *srv = &server[running];
+            int i = srv->head;
+            long long run = processes[i].remaining < srv->budget ? processes[i].remaining : srv->budget;
+            if (horizon < run)
+                run = horizon;
+            if (processes[i].start_time == -1)
+                processes[i].start_time = (int)now;
+            now += run;
+            processes[i].remaining -= (int)run;
+            srv->budget -= run;
+            stats->reserved_time += run;
+            if (processes[i].remaining == 0) {
+                processes[i].finish_time = (int)now;
+                completed++;
+                srv->head = next[i];
+                srv->pending--;
+            }
+            if (srv->budget == 0) {
+                srv->budget = srv->quota;
+                srv->deadline += srv->period;
+                stats->postponements++;
+                if (srv->pending > 0)
+                    heapPush(&ready, srv->deadline, running);
+                running = -1;
+            } else if (srv->pending == 0) {
+                running = -1;
+            }
+        } else {
+            int i = best_effort;
+            long long run = processes[i].remaining < slice ? processes[i].remaining : slice;
+            if (horizon < run)
+                run = horizon;
+            if (processes[i].start_time == -1)
+                processes[i].start_time = (int)now;
+            now += run;
+            processes[i].remaining -= (int)run;
+            slice -= (int)run;
+            if (processes[i].remaining == 0) {
+                processes[i].finish_time = (int)now;
+                completed++;
+                best_effort = -1;
+            }
+        }
+    }
+    stats->makespan = (int)now;
+
+    heapFree(&ready);
+    free(server);
+    free(queue);
+    free(next);
+    free(server_of);
+}
+
+/**
+ * @brief Averages and latency percentiles of the reserved or the best-effort processes.
+ */
+static int summarizeClass(Process processes[], int n, const BandwidthConfig *servers, int reserved,
+                          float *tat, float *rt, LatencySummary *latency) {
+    Process *subset = malloc((n > 0 ? n : 1) * sizeof(Process));
+    if (!subset) {
+        perror("Error allocating CBS metrics");
+        exit(EXIT_FAILURE);
+    }
+    int count = 0;
+    float throughput;
+    for (int i = 0; i < n; i++)
+        if ((groupLimit(servers, processes[i].group).quota > 0) == reserved)
+            subset[count++] = processes[i];
+    *tat = *rt = 0;
+    if (count > 0)
+        calculateMetrics(subset, count, tat, rt, &throughput);
+    summarizeLatency(subset, count, latency);
+    free(subset);
+    return count;
+}
+
+/**
+ * @brief Prints the server statistics and the metrics of reserved and best-effort processes apart.
+ */
+void printCBSStats(Process processes[], int n, const BandwidthConfig *servers, const CBSStats *stats, FILE *out) {
+    static const char *const names[] = {"reserved", "best-effort"};
+    LatencySummary latency[2];
+    float tat[2], rt[2];
+    int count[2];
+    for (int c = 0; c < 2; c++)
+        count[c] = summarizeClass(processes, n, servers, c == 0, &tat[c], &rt[c], &latency[c]);
+
+    fprintf(out, "\nConstant Bandwidth Servers (%d servers, %.2f%% of the CPU reserved):\n", stats->servers,
+            100.0 * stats->bandwidth);
+    if (stats->bandwidth > 1.0)
+        fprintf(out, "Warning: the servers reserve more than the whole CPU, so EDF cannot keep their deadlines\n");
+    fprintf(out, "Deadline Resets on Arrival: %lld\n", stats->replenishments);
+    fprintf(out, "Budget Exhaustions: %lld (deadline postponed by a period)\n", stats->postponements);
+    fprintf(out, "Preemptions: %lld\n", stats->preemptions);
+    fprintf(out, "Reserved CPU Time: %lld (%.2f%% of the makespan)\n", stats->reserved_time,
+            stats->makespan ? 100.0 * stats->reserved_time / stats->makespan : 0.0);
+    fprintf(out, "Reserved Jobs: %d (Average Turnaround Time %.2f, Average Response Time %.2f)\n", count[0],
+            tat[0], rt[0]);
+    fprintf(out, "Best-Effort Jobs: %d (Average Turnaround Time %.2f, Average Response Time %.2f)\n", count[1],
+            tat[1], rt[1]);
+    fprintf(out, "\nLatency Distribution:\n");
+    printLatencyTable(names, latency, 2, out);
+}
@@ -0,0 +1,24 @@
+#ifndef CBS_H
+#define CBS_H
+
+#include <stdio.h>
+#include "process.h"
+#include "bandwidth.h"
+
+/**
+ * @brief Outcome of a run of constant bandwidth servers over best-effort RR.
+ */
+typedef struct {
+    int servers;              ///< Groups with a server.
+    double bandwidth;         ///< Sum of budget / period over the servers.
+    long long replenishments; ///< Arrivals that found an idle server and gave it a new deadline.
+    long long postponements;  ///< Budgets used up, each recharged with the deadline one period later.
+    long long preemptions;    ///< Running jobs preempted by a server of earlier deadline.
+    long long reserved_time;  ///< CPU time given to the servers.
+    int makespan;             ///< Finish time of the last process.
+} CBSStats;
+
+void computeCBS(Process processes[], int n, const BandwidthConfig *servers, CBSStats *stats);
+void printCBSStats(Process processes[], int n, const BandwidthConfig *servers, const CBSStats *stats, FILE *out);
+
+#endif
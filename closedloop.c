@@ -0,0 +1,193 @@
+#include <stdlib.h>
+#include <limits.h>
+#include <math.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include "closedloop.h"
+#include "heap.h"
+#include "rng.h"
+#include "engines.h"
+
+/**
+ * @brief Samples an exponential think time of the given mean, rounded to whole time units.
+ */
+static long long sampleThink(unsigned long long *state, double mean) {
+    double u = ((nextRandom(state) >> 11) + 1) * 0x1.0p-53; // Uniform in (0, 1].
+    return (long long)(-mean * log(u) + 0.5);
+}
+
+/**
+ * @brief Simulates a population of users submitting jobs to an RR CPU in a closed loop.
+ *
+ * @param processes The trace whose bursts are the service demands (not modified).
+ * @param n The number of processes in the trace, at least 1.
+ * @param users The population N.
+ * @param config Think time, run length, quantum and seed.
+ * @param point Receives the throughput and response time of the run.
+ *
+ * @details
+ * Every user starts thinking at time 0.  When a think time ends the user
+ * submits a job and waits for it; when the job finishes the user thinks again.
+ * The k-th job submitted takes the burst of process k mod n, so all
+ * populations replay the same demands, and think times are exponential with
+ * mean config->think.  The run stops at the config->jobs-th completion.
+ *
+ * Pending think ends sit in a MinHeap, as arrivals do in the event engines,
+ * and the CPU runs RR over the submitted jobs with the RRQueue and the steps
+ * of computeRREvent (rrEventRun): time jumps to the next think end when
+ * nothing is queued, jobs submitted by the end of a slice queue ahead of the
+ * preempted job, and the slices of a lone job run in one step up to the next
+ * submission.
+ */
+void simulateClosedLoop(const Process processes[], int n, int users, const ClosedLoopConfig *config,
+                        ClosedLoopPoint *point) {
+    int *remaining = malloc(users * sizeof(int));
+    long long *submitted = malloc(users * sizeof(long long));
+    if (!remaining || !submitted) {
+        perror("Error allocating closed-loop users");
+        exit(EXIT_FAILURE);
+    }
+    // One stream per population, so the curve does not depend on the thread count.
+    unsigned long long state = config->seed + (unsigned long long)users * 0x9E3779B97F4A7C15ULL;
+    if (state == 0)
+        state = 1;
+
+    MinHeap thinking;
+    heapInit(&thinking, users);
+    for (int u = 0; u < users; u++)
+        heapPush(&thinking, sampleThink(&state, config->think), u);
+    RRQueue queue;
+    rrQueueInit(&queue, users);
+
+    int running = -1;
+    long long now = 0, jobs = 0, completed = 0, busy = 0, response = 0;
+
+    while (completed < config->jobs) {
+        if (queue.size == 0 && running < 0 && thinking.items[0].key > now)
+            now = thinking.items[0].key;
+        while (thinking.size > 0 && thinking.items[0].key <= now) {
+            HeapItem item = heapPop(&thinking);
+            remaining[item.value] = processes[jobs++ % n].burst;
+            submitted[item.value] = item.key;
+            rrQueuePush(&queue, item.value);
+        }
+        if (running >= 0) {
+            rrQueuePush(&queue, running);
+            running = -1;
+        }
+
+        int u = rrQueuePop(&queue);
+        long long until = thinking.size > 0 ? thinking.items[0].key - now : LLONG_MAX;
+        long long run = rrEventRun(remaining[u], config->quantum, queue.size == 0, until);
+        now += run;
+        busy += run;
+        remaining[u] -= (int)run;
+        if (remaining[u] == 0) {
+            completed++;
+            response += now - submitted[u];
+            heapPush(&thinking, now + sampleThink(&state, config->think), u);
+        } else {
+            running = u;
+        }
+    }
+
+    point->users = users;
+    point->completed = completed;
+    point->elapsed = now;
+    point->busy = busy;
+    point->throughput = now > 0 ? (double)completed / now : 0.0;
+    point->response = completed > 0 ? (double)response / completed : 0.0;
+
+    rrQueueFree(&queue);
+    heapFree(&thinking);
+    free(submitted);
+    free(remaining);
+}
+
+typedef struct {
+    const Process *processes;
+    int n;
+    const ClosedLoopConfig *config;
+    ClosedLoopPoint *points;
+    int count;
+    atomic_int next;  ///< Next point to hand out, largest population first.
+} ClosedLoopPool;
+
+static void *runPopulations(void *arg) {
+    ClosedLoopPool *pool = arg;
+    for (;;) {
+        int k = atomic_fetch_add(&pool->next, 1);
+        if (k >= pool->count)
+            return NULL;
+        int point = pool->count - 1 - k;
+        int users = pool->config->min_users + point * pool->config->step;
+        simulateClosedLoop(pool->processes, pool->n, users, pool->config, &pool->points[point]);
+    }
+}
+
+/**
+ * @brief Prints the throughput and response time of a closed loop for each population.
+ *
+ * @param processes The trace whose bursts are the service demands (not modified).
+ * @param n The number of processes in the trace.
+ * @param config The populations, think time, run length, quantum, threads and seed.
+ * @param out Where to print the curve.
+ *
+ * @details
+ * Each population is an independent run of simulateClosedLoop; the threads
+ * take populations from a shared counter, largest first since those runs are
+ * the longest.  Next to each point go the asymptotic bound on throughput,
+ * min(N / (D + Z), 1 / D) for mean demand D and mean think time Z, and the
+ * response time the interactive response time law R = N / X - Z gives from
+ * the measured throughput, which should track the measured one.
+ */
+void sweepClosedLoop(const Process processes[], int n, const ClosedLoopConfig *config, FILE *out) {
+    if (n == 0) {
+        fprintf(out, "Closed Loop: the trace has no processes to take demands from\n");
+        return;
+    }
+    int count = (config->max_users - config->min_users) / config->step + 1;
+    ClosedLoopPoint *points = malloc(count * sizeof(ClosedLoopPoint));
+    if (!points) {
+        perror("Error allocating closed-loop curve");
+        exit(EXIT_FAILURE);
+    }
+    ClosedLoopPool pool = {processes, n, config, points, count, 0};
+    int threads = config->threads < count ? config->threads : count;
+    pthread_t *workers = malloc(threads * sizeof(pthread_t));
+    if (!workers) {
+        perror("Error allocating worker threads");
+        exit(EXIT_FAILURE);
+    }
+    for (int t = 1; t < threads; t++) {
+        if (pthread_create(&workers[t], NULL, runPopulations, &pool) != 0) {
+            perror("Error creating worker thread");
+            exit(EXIT_FAILURE);
+        }
+    }
+    runPopulations(&pool);
+    for (int t = 1; t < threads; t++)
+        pthread_join(workers[t], NULL);
+    free(workers);
+
+    double demand = 0;
+    for (int i = 0; i < n; i++)
+        demand += processes[i].burst;
+    demand /= n;
+
+    fprintf(out, "Closed Loop over Round Robin (Quantum=%d, mean think time %.2f, %lld jobs per run)\n",
+            config->quantum, config->think, config->jobs);
+    fprintf(out, "%6s %12s %12s %12s %12s %12s\n", "Users", "Throughput", "Bound", "Response", "N/X-Z", "Utilization");
+    for (int k = 0; k < count; k++) {
+        const ClosedLoopPoint *p = &points[k];
+        double bound = demand > 0 ? fmin(p->users / (demand + config->think), 1.0 / demand) : 0.0;
+        double law = p->throughput > 0 ? p->users / p->throughput - config->think : 0.0;
+        fprintf(out, "%6d %12.4f %12.4f %12.2f %12.2f %11.2f%%\n", p->users, p->throughput, bound, p->response,
+                law, p->elapsed ? 100.0 * p->busy / p->elapsed : 0.0);
+    }
+    if (demand > 0)
+        fprintf(out, "Mean Demand: %.2f, saturation at N* = (D + Z) / D = %.2f users\n", demand,
+                (demand + config->think) / demand);
+    fprintf(out, "Simulated %d populations on %d threads\n", count, threads);
+    free(points);
+}
@@ -0,0 +1,39 @@
+#ifndef CLOSEDLOOP_H
+#define CLOSEDLOOP_H
+
+#include <stdio.h>
+#include "process.h"
+
+#define CLOSED_THINK 10    ///< Default mean think time.
+#define CLOSED_JOBS 10000  ///< Default completions simulated per population.
+
+/**
+ * @brief A closed-loop workload: users that submit, wait, think and submit again.
+ */
+typedef struct {
+    int min_users, max_users; ///< Populations swept, inclusive.
+    int step;                 ///< Users added from one population to the next.
+    double think;             ///< Mean of the exponential think time.
+    long long jobs;           ///< Completions simulated per population.
+    int quantum;              ///< RR time quantum.
+    int threads;              ///< Populations simulated at once.
+    unsigned long long seed;  ///< Seed of the think times.
+} ClosedLoopConfig;
+
+/**
+ * @brief One point of the throughput curve.
+ */
+typedef struct {
+    int users;           ///< Population N.
+    long long completed; ///< Jobs finished.
+    long long elapsed;   ///< Finish time of the last job.
+    long long busy;      ///< CPU time spent on jobs.
+    double throughput;   ///< Jobs finished per time unit, X.
+    double response;     ///< Mean time from submission to completion, R.
+} ClosedLoopPoint;
+
+void simulateClosedLoop(const Process processes[], int n, int users, const ClosedLoopConfig *config,
+                        ClosedLoopPoint *point);
+void sweepClosedLoop(const Process processes[], int n, const ClosedLoopConfig *config, FILE *out);
+
+#endif
@@ -0,0 +1,261 @@
+#include <stdlib.h>
+#include <string.h>
+#include "dispatch.h"
+#include "heap.h"
+#include "rng.h"
+
+/**
+ * @brief Parses a dispatch policy ("random", "rr", "jsq" or "pod").
+ *
+ * @return 0 on success, -1 if the name is unknown.
+ */
+int parseDispatchPolicy(const char *name, DispatchPolicy *policy) {
+    for (int p = DISPATCH_RANDOM; p <= DISPATCH_POD; p++) {
+        if (strcmp(name, dispatchPolicyName((DispatchPolicy)p)) == 0) {
+            *policy = (DispatchPolicy)p;
+            return 0;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Returns the name of a dispatch policy.
+ */
+const char *dispatchPolicyName(DispatchPolicy policy) {
+    static const char *const names[] = {"random", "rr", "jsq", "pod"};
+    return names[policy];
+}
+
+/**
+ * @brief Min segment tree over the number of processes at each server.
+ *
+ * Node k holds the server with the fewest processes in its range, the lowest
+ * numbered one on ties, so the shortest queue is at the root.
+ */
+typedef struct {
+    int leaves;     ///< Power of two >= servers.
+    int *best;      ///< Server of each node, -1 for padding leaves.
+    const int *load; ///< Processes at each server.
+} LoadTree;
+
+static int lighter(const LoadTree *tree, int a, int b) {
+    if (a < 0)
+        return b;
+    if (b < 0)
+        return a;
+    return tree->load[b] < tree->load[a] ? b : a;
+}
+
+static void treeInit(LoadTree *tree, const int *load, int servers) {
+    tree->leaves = 1;
+    while (tree->leaves < servers)
+        tree->leaves *= 2;
+    tree->load = load;
+    tree->best = malloc(2 * tree->leaves * sizeof(int));
+    if (!tree->best) {
+        perror("Error allocating dispatcher");
+        exit(EXIT_FAILURE);
+    }
+    for (int i = 0; i < tree->leaves; i++)
+        tree->best[tree->leaves + i] = i < servers ? i : -1;
+    for (int k = tree->leaves - 1; k > 0; k--)
+        tree->best[k] = lighter(tree, tree->best[2 * k], tree->best[2 * k + 1]);
+}
+
+/**
+ * @brief Restores the tree after the load of one server changed.  O(log servers).
+ */
+static void treeUpdate(LoadTree *tree, int server) {
+    for (int k = (tree->leaves + server) / 2; k > 0; k /= 2)
+        tree->best[k] = lighter(tree, tree->best[2 * k], tree->best[2 * k + 1]);
+}
+
+/**
+ * @brief State of one simulated server.
+ */
+typedef struct {
+    int head, tail;   ///< Local FIFO, linked through the shared next array; -1 if empty.
+    int running;      ///< Process on the CPU, -1 if idle.
+    int jobs;         ///< Processes sent to the server so far.
+    long long busy;   ///< Time spent running processes.
+} Server;
+
+/**
+ * @brief Starts the next slice of server s at time now if it is idle and has work.
+ *
+ * @details
+ * As in computeRREvent, a process alone at its server runs slice after slice
+ * until one ends at or after the next arrival anywhere, in a single event.
+ */
+static void startSlice(Server *server, int s, int *next, int *remaining, Process processes[], long long now,
+                       long long next_arrival, const DispatchConfig *config, MinHeap *events) {
+    if (server->running >= 0 || server->head < 0)
+        return;
+    int i = server->head;
+    server->head = next[i];
+    if (server->head < 0)
+        server->tail = -1;
+    server->running = i;
+
+    if (processes[i].start_time == -1)
+        processes[i].start_time = (int)now;
+    long long exec_time = remaining[i];
+    if (config->local == MULTI_RR && remaining[i] > config->quantum) {
+        long long slices = 1;
+        if (server->head < 0) {
+            slices = (remaining[i] + config->quantum - 1) / config->quantum;
+            if (next_arrival >= 0) {
+                long long until_arrival = (next_arrival - now + config->quantum - 1) / config->quantum;
+                if (until_arrival < slices)
+                    slices = until_arrival > 0 ? until_arrival : 1;
+            }
+        }
+        exec_time = slices * config->quantum;
+        if (exec_time > remaining[i])
+            exec_time = remaining[i];
+    }
+    remaining[i] -= (int)exec_time;
+    server->busy += exec_time;
+    heapPush(events, now + exec_time, s);
+}
+
+static void enqueueLocal(Server *server, int *next, int i) {
+    next[i] = -1;
+    if (server->tail >= 0)
+        next[server->tail] = i;
+    else
+        server->head = i;
+    server->tail = i;
+}
+
+/**
+ * @brief Simulates a dispatcher in front of independent FCFS or RR servers.
+ *
+ * @param processes An array of Process structures sorted by arrival.
+ * @param n The number of processes in the array.
+ * @param config The servers and the dispatch policy.
+ * @param stats Receives the load spread.
+ *
+ * @details
+ * One event loop drives every server.  Each busy server has exactly one event
+ * in a heap keyed by time (ties by server number): the end of its current
+ * slice.  Arrivals are merged in from the sorted table and dispatched first
+ * when they coincide with a slice end, which is the queue order of computeRR.
+ * The local queues are FIFOs linked through one array indexed by process, and
+ * the number of processes at each server sits in a segment tree, so every
+ * event and every dispatch decision costs O(log servers) and the memory is
+ * O(n + servers).
+ */
+void computeDispatched(Process processes[], int n, const DispatchConfig *config, DispatchStats *stats) {
+    int servers = config->servers;
+    Server *server = malloc(servers * sizeof(Server));
+    int *load = calloc(servers, sizeof(int));
+    int *next = malloc(n * sizeof(int));
+    int *remaining = malloc(n * sizeof(int));
+    if (!server || !load || (n > 0 && (!next || !remaining))) {
+        perror("Error allocating dispatcher");
+        exit(EXIT_FAILURE);
+    }
+    for (int s = 0; s < servers; s++)
+        server[s] = (Server){-1, -1, -1, 0, 0};
+    for (int i = 0; i < n; i++) {
+        remaining[i] = processes[i].burst;
+        processes[i].start_time = -1;
+        processes[i].finish_time = -1;
+    }
+
+    LoadTree tree;
+    treeInit(&tree, load, servers);
+    MinHeap events;
+    heapInit(&events, servers);
+    unsigned long long rng = config->seed ? config->seed : DISPATCH_DEFAULT_SEED;
+    int idx = 0, completed = 0, turn = 0;
+    long long now = 0;
+
+    while (completed < n) {
+        if (idx < n && (events.size == 0 || processes[idx].arrival <= events.items[0].key)) {
+            now = processes[idx].arrival;
+            int s;
+            switch (config->policy) {
+            case DISPATCH_RANDOM:
+                s = (int)(nextRandom(&rng) % (unsigned long long)servers);
+                break;
+            case DISPATCH_RR:
+                s = turn;
+                turn = turn + 1 == servers ? 0 : turn + 1;
+                break;
+            case DISPATCH_JSQ:
+                s = tree.best[1];
+                break;
+            default:
+                s = (int)(nextRandom(&rng) % (unsigned long long)servers);
+                for (int d = 1; d < config->choices; d++) {
+                    int candidate = (int)(nextRandom(&rng) % (unsigned long long)servers);
+                    if (load[candidate] < load[s])
+                        s = candidate;
+                }
+                break;
+            }
+
+            enqueueLocal(&server[s], next, idx++);
+            server[s].jobs++;
+            load[s]++;
+            treeUpdate(&tree, s);
+            startSlice(&server[s], s, next, remaining, processes, now,
+                       idx < n ? processes[idx].arrival : -1, config, &events);
+            continue;
+        }
+
+        HeapItem event = heapPop(&events);
+        int s = event.value, i = server[s].running;
+        now = event.key;
+        server[s].running = -1;
+        if (remaining[i] > 0) {
+            enqueueLocal(&server[s], next, i);
+        } else {
+            processes[i].finish_time = (int)now;
+            completed++;
+            load[s]--;
+            treeUpdate(&tree, s);
+        }
+        startSlice(&server[s], s, next, remaining, processes, now, idx < n ? processes[idx].arrival : -1,
+                   config, &events);
+    }
+
+    *stats = (DispatchStats){0};
+    stats->processes = n;
+    stats->makespan = (int)now;
+    stats->min_jobs = servers > 0 ? server[0].jobs : 0;
+    for (int s = 0; s < servers; s++) {
+        if (server[s].jobs < stats->min_jobs)
+            stats->min_jobs = server[s].jobs;
+        if (server[s].jobs > stats->max_jobs)
+            stats->max_jobs = server[s].jobs;
+        if (server[s].busy > stats->max_busy)
+            stats->max_busy = server[s].busy;
+        stats->total_busy += server[s].busy;
+    }
+
+    heapFree(&events);
+    free(tree.best);
+    free(remaining);
+    free(next);
+    free(load);
+    free(server);
+}
+
+/**
+ * @brief Prints how evenly a dispatched run spread the load.
+ */
+void printDispatchStats(const DispatchConfig *config, const DispatchStats *stats, FILE *out) {
+    fprintf(out, "\nDispatch (%s", dispatchPolicyName(config->policy));
+    if (config->policy == DISPATCH_POD)
+        fprintf(out, ", d=%d", config->choices);
+    fprintf(out, ", %d %s servers):\n", config->servers, multiPolicyName(config->local));
+    fprintf(out, "Processes per Server: min %d, mean %.2f, max %d\n", stats->min_jobs,
+            (double)stats->processes / config->servers, stats->max_jobs);
+    fprintf(out, "Utilization: mean %.2f%%, busiest server %.2f%%\n",
+            stats->makespan ? 100.0 * stats->total_busy / ((double)stats->makespan * config->servers) : 0.0,
+            stats->makespan ? 100.0 * stats->max_busy / stats->makespan : 0.0);
+}
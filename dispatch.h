@@ -0,0 +1,49 @@
+#ifndef DISPATCH_H
+#define DISPATCH_H
+
+#include <stdio.h>
+#include "process.h"
+#include "multicpu.h"
+
+#define DISPATCH_DEFAULT_CHOICES 2 ///< Servers sampled by power-of-d-choices.
+#define DISPATCH_DEFAULT_SEED 1    ///< Seed of the random and power-of-d dispatchers.
+
+/**
+ * @brief How the front end picks a server for each arriving process.
+ */
+typedef enum {
+    DISPATCH_RANDOM,  ///< A uniformly random server.
+    DISPATCH_RR,      ///< Servers in turn.
+    DISPATCH_JSQ,     ///< The server with the fewest processes (lowest number on ties).
+    DISPATCH_POD      ///< The server with the fewest processes among d random ones.
+} DispatchPolicy;
+
+/**
+ * @brief A front end spreading the trace over independent servers.
+ */
+typedef struct {
+    int servers;              ///< Number of servers.
+    DispatchPolicy policy;    ///< Dispatch policy.
+    int choices;              ///< d of power-of-d-choices.
+    MultiPolicy local;        ///< Scheduling on each server.
+    int quantum;              ///< RR time quantum on each server.
+    unsigned long long seed;  ///< Random seed.
+} DispatchConfig;
+
+/**
+ * @brief Load spread of a dispatched run.
+ */
+typedef struct {
+    int processes;             ///< Processes dispatched.
+    int min_jobs, max_jobs;    ///< Fewest and most processes sent to one server.
+    long long max_busy;        ///< Busy time of the busiest server.
+    long long total_busy;      ///< Busy time summed over servers.
+    int makespan;              ///< Finish time of the last process.
+} DispatchStats;
+
+int parseDispatchPolicy(const char *name, DispatchPolicy *policy);
+const char *dispatchPolicyName(DispatchPolicy policy);
+void computeDispatched(Process processes[], int n, const DispatchConfig *config, DispatchStats *stats);
+void printDispatchStats(const DispatchConfig *config, const DispatchStats *stats, FILE *out);
+
+#endif
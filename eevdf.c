@@ -0,0 +1,247 @@
+#include <stdlib.h>
+#include <limits.h>
+#include "eevdf.h"
+#include "treap.h"
+
+/**
+ * @brief What the timeline keeps per process besides its treap links.
+ */
+typedef struct {
+    long long vruntime; ///< Virtual runtime of the process.
+    long long deadline; ///< Virtual deadline of its current request.
+    int best;           ///< Node of earliest virtual deadline in the subtree.
+} TimelineNode;
+
+/**
+ * @brief The runnable processes ordered by virtual runtime.
+ *
+ * An IndexTreap over process indices, so nothing is allocated per process.
+ * Each node also holds the node of earliest virtual deadline in its subtree,
+ * and the weighted sum of virtual runtimes is kept relative to a base that
+ * follows the average, so eligibility is checked without division or overflow.
+ */
+typedef struct {
+    IndexTreap tree;          ///< Runnable processes by virtual runtime, then index.
+    TimelineNode *nodes;      ///< Node of each process.
+    long long base;           ///< Reference point of the weighted sum, about V.
+    long long sum_weight;     ///< Total weight of the tree.
+    long long sum_offset;     ///< Sum of weight * (vruntime - base) over the tree.
+    const Process *processes; ///< The trace, for the weight of each process.
+} Timeline;
+
+/**
+ * @brief Returns whichever of two nodes has the earlier virtual deadline (then lower index).
+ */
+static int earlier(const TimelineNode *nodes, int a, int b) {
+    if (a < 0)
+        return b;
+    if (b < 0)
+        return a;
+    if (nodes[a].deadline != nodes[b].deadline)
+        return nodes[a].deadline < nodes[b].deadline ? a : b;
+    return a < b ? a : b;
+}
+
+static void pullBest(void *context, int t) {
+    Timeline *timeline = context;
+    TimelineNode *nodes = timeline->nodes;
+    const TreapLink *link = &timeline->tree.links[t];
+    int best = earlier(nodes, t, link->left < 0 ? -1 : nodes[link->left].best);
+    nodes[t].best = earlier(nodes, best, link->right < 0 ? -1 : nodes[link->right].best);
+}
+
+/**
+ * @brief Timeline order: by virtual runtime, then by index.
+ */
+static int runsBefore(const void *context, int a, int b) {
+    const TimelineNode *nodes = ((const Timeline *)context)->nodes;
+    return nodes[a].vruntime < nodes[b].vruntime || (nodes[a].vruntime == nodes[b].vruntime && a < b);
+}
+
+static void timelineInsert(Timeline *timeline, int i) {
+    long long weight = timeline->processes[i].weight;
+    treapInsert(&timeline->tree, (TreapOps){runsBefore, pullBest, timeline}, i);
+    timeline->sum_weight += weight;
+    timeline->sum_offset += weight * (timeline->nodes[i].vruntime - timeline->base);
+}
+
+static void timelineRemove(Timeline *timeline, int i) {
+    long long weight = timeline->processes[i].weight;
+    treapRemove(&timeline->tree, (TreapOps){runsBefore, pullBest, timeline}, i);
+    timeline->sum_weight -= weight;
+    timeline->sum_offset -= weight * (timeline->nodes[i].vruntime - timeline->base);
+}
+
+/**
+ * @brief Moves the base to the floor of the average virtual runtime V.
+ *
+ * Afterwards 0 <= sum_offset < sum_weight, which keeps the products of
+ * isEligible small however long the run.  An empty tree keeps its base, the
+ * V new processes join at.
+ */
+static void rebase(Timeline *timeline) {
+    if (timeline->sum_weight == 0)
+        return;
+    long long shift = timeline->sum_offset / timeline->sum_weight;
+    if (timeline->sum_offset % timeline->sum_weight < 0)
+        shift--;
+    timeline->base += shift;
+    timeline->sum_offset -= shift * timeline->sum_weight;
+}
+
+/**
+ * @brief Returns non-zero if a node's virtual runtime is at most the average V.
+ */
+static int isEligible(const Timeline *timeline, int t) {
+    return (timeline->nodes[t].vruntime - timeline->base) * timeline->sum_weight <= timeline->sum_offset;
+}
+
+/**
+ * @brief Returns the lag w * (V - v) of a process in the tree, in units of time.
+ */
+static double processLag(const Timeline *timeline, int i) {
+    double average = timeline->base + (double)timeline->sum_offset / timeline->sum_weight;
+    return timeline->processes[i].weight * (average - timeline->nodes[i].vruntime) / EEVDF_WEIGHT_SCALE;
+}
+
+/**
+ * @brief Returns the eligible node with the earliest virtual deadline.
+ *
+ * @details
+ * Eligibility is a prefix of the timeline, so one descent suffices: at an
+ * eligible node, the node and its whole left subtree are candidates and the
+ * search continues right; otherwise it continues left.  The tree is never
+ * empty here, and its first node is always eligible.
+ */
+static int pickEligible(const Timeline *timeline) {
+    const TimelineNode *nodes = timeline->nodes;
+    const TreapLink *links = timeline->tree.links;
+    int t = timeline->tree.root, pick = -1;
+    while (t >= 0) {
+        if (isEligible(timeline, t)) {
+            pick = earlier(nodes, pick, t);
+            if (links[t].left >= 0)
+                pick = earlier(nodes, pick, nodes[links[t].left].best);
+            t = links[t].right;
+        } else {
+            t = links[t].left;
+        }
+    }
+    return pick;
+}
+
+/**
+ * @brief Computes Earliest Eligible Virtual Deadline First scheduling.
+ *
+ * @param processes An array of Process structures sorted by arrival, each
+ *                  sharing the CPU in proportion to its weight column, from 1
+ *                  to quantum * EEVDF_WEIGHT_SCALE so that every slice moves
+ *                  the virtual runtime.
+ * @param n The number of processes in the array.
+ * @param quantum The base slice: the time every request asks for.
+ * @param stats Receives the number of decisions and the lag range.  Lag is
+ *              sampled when a process is picked, where it is never negative,
+ *              and when it is put back after a slice, where it is at its lowest.
+ *
+ * @details
+ * A process of weight w advances its virtual runtime v by the time it runs
+ * times EEVDF_WEIGHT_SCALE / w.  V is the weight-averaged v of the runnable
+ * processes, and a process is eligible while v <= V, that is while its lag
+ * w * (V - v) is not negative.  Each request of a slice gets the virtual
+ * deadline v + quantum * EEVDF_WEIGHT_SCALE / w, and the eligible process of
+ * earliest deadline runs for a slice.  Arrivals join at V, rounded down, with
+ * no lag, and a finished process leaves with whatever lag it had, as a
+ * process leaving for good does in Linux.  The process that is running is out
+ * of the tree and goes back in, with its new v and deadline, before the
+ * arrivals of its slice are placed.
+ *
+ * The tree is ordered by v and augmented with the earliest deadline of each
+ * subtree, so a decision costs O(log n) (see pickEligible).  While a single
+ * process is runnable, its slices up to the next arrival run as one.
+ */
+void computeEEVDF(Process processes[], int n, int quantum, EEVDFStats *stats) {
+    for (int i = 0; i < n; i++) {
+        if (processes[i].weight < 1) {
+            fprintf(stderr, "Invalid trace: process %d has weight %d, EEVDF needs at least 1\n", processes[i].id,
+                    processes[i].weight);
+            exit(EXIT_FAILURE);
+        }
+        // A heavier process would advance its virtual runtime by 0 per slice and never yield the CPU.
+        if (processes[i].weight > (long long)quantum * EEVDF_WEIGHT_SCALE) {
+            fprintf(stderr, "Invalid trace: process %d has weight %d, EEVDF with slice %d allows at most %lld\n",
+                    processes[i].id, processes[i].weight, quantum, (long long)quantum * EEVDF_WEIGHT_SCALE);
+            exit(EXIT_FAILURE);
+        }
+        processes[i].remaining = processes[i].burst;
+        processes[i].start_time = -1;
+        processes[i].finish_time = -1;
+    }
+
+    Timeline timeline = {.nodes = malloc((n > 0 ? n : 1) * sizeof(TimelineNode)), .processes = processes};
+    treapInit(&timeline.tree, n);
+    if (!timeline.nodes) {
+        perror("Error allocating EEVDF timeline");
+        exit(EXIT_FAILURE);
+    }
+    TimelineNode *nodes = timeline.nodes;
+
+    *stats = (EEVDFStats){0};
+    int idx = 0, completed = 0;
+    long long now = 0;
+
+    while (completed < n) {
+        if (timeline.tree.root < 0 && processes[idx].arrival > now)
+            now = processes[idx].arrival;
+        rebase(&timeline);
+        for (; idx < n && processes[idx].arrival <= now; idx++) {
+            nodes[idx].vruntime = timeline.base;
+            nodes[idx].deadline = timeline.base + quantum * (long long)EEVDF_WEIGHT_SCALE / processes[idx].weight;
+            timelineInsert(&timeline, idx);
+        }
+
+        int i = pickEligible(&timeline);
+        long long weight = processes[i].weight;
+        double lag = processLag(&timeline, i);
+        if (lag > stats->max_lag)
+            stats->max_lag = lag;
+        stats->decisions++;
+        timelineRemove(&timeline, i);
+
+        long long run = processes[i].remaining < quantum ? processes[i].remaining : quantum;
+        if (timeline.tree.root < 0 && run < processes[i].remaining) {
+            // Alone on the CPU: nothing can preempt it before the next arrival.
+            long long slices = idx < n ? (processes[idx].arrival - now + quantum - 1) / quantum : LLONG_MAX;
+            if (slices > 1)
+                run = slices >= (processes[i].remaining + quantum - 1) / quantum ? processes[i].remaining
+                                                                                : slices * quantum;
+        }
+        if (processes[i].start_time == -1)
+            processes[i].start_time = (int)now;
+        now += run;
+        processes[i].remaining -= (int)run;
+        if (processes[i].remaining == 0) {
+            processes[i].finish_time = (int)now;
+            completed++;
+            continue;
+        }
+        nodes[i].vruntime += run * EEVDF_WEIGHT_SCALE / weight;
+        nodes[i].deadline = nodes[i].vruntime + quantum * (long long)EEVDF_WEIGHT_SCALE / weight;
+        timelineInsert(&timeline, i);
+        lag = processLag(&timeline, i);
+        if (lag < stats->min_lag)
+            stats->min_lag = lag;
+    }
+    stats->makespan = (int)now;
+
+    treapFree(&timeline.tree);
+    free(timeline.nodes);
+}
+
+/**
+ * @brief Prints how many decisions an EEVDF run took and how far lag strayed from zero.
+ */
+void printEEVDFStats(int quantum, const EEVDFStats *stats, FILE *out) {
+    fprintf(out, "\nEEVDF (slice %d):\n", quantum);
+    fprintf(out, "Scheduling Decisions: %lld\n", stats->decisions);
+    fprintf(out, "Lag: max %.2f when picked, min %.2f after a slice\n", stats->max_lag, stats->min_lag);
+}
@@ -0,0 +1,25 @@
+#ifndef EEVDF_H
+#define EEVDF_H
+
+#include <stdio.h>
+#include "process.h"
+
+#define EEVDF_WEIGHT_SCALE 1024 ///< Virtual time units per unit of time at weight 1.
+
+/**
+ * @brief Outcome of an EEVDF run.
+ *
+ * Lag is w * (V - v) in units of time: positive for a process owed service,
+ * negative for one that ran ahead of its share.
+ */
+typedef struct {
+    long long decisions; ///< Slices handed out.
+    double max_lag;      ///< Highest lag of a process when it was picked.
+    double min_lag;      ///< Lowest lag of a process put back after a slice.
+    int makespan;        ///< Finish time of the last process.
+} EEVDFStats;
+
+void computeEEVDF(Process processes[], int n, int quantum, EEVDFStats *stats);
+void printEEVDFStats(int quantum, const EEVDFStats *stats, FILE *out);
+
+#endif
@@ -0,0 +1,309 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include "engines.h"
+
+/**
+ * @brief Allocates an empty RRQueue for up to capacity entries.
+ */
+void rrQueueInit(RRQueue *queue, int capacity) {
+    queue->capacity = capacity > 0 ? capacity : 1;
+    queue->items = malloc(queue->capacity * sizeof(int));
+    if (!queue->items) {
+        perror("Error allocating RR queue");
+        exit(EXIT_FAILURE);
+    }
+    queue->front = 0;
+    queue->size = 0;
+}
+
+/**
+ * @brief Releases the storage of an RRQueue.
+ */
+void rrQueueFree(RRQueue *queue) {
+    free(queue->items);
+    queue->items = NULL;
+    queue->size = 0;
+}
+
+/**
+ * @brief How long a job just taken from the queue runs before it goes back or finishes.
+ *
+ * @param remaining The service the job still needs, at least 1.
+ * @param quantum The time quantum.
+ * @param alone Non-zero if nothing else is queued.
+ * @param until_arrival Time until the next arrival, at least 1, or LLONG_MAX if none is due.
+ *
+ * @details
+ * One quantum, or less if the job needs less.  A job alone in the queue would
+ * be dequeued again after each of its slices until one ends at or after the
+ * next arrival, so all of those slices run in this one step.
+ */
+long long rrEventRun(long long remaining, int quantum, int alone, long long until_arrival) {
+    if (!alone || remaining <= quantum)
+        return remaining < quantum ? remaining : quantum;
+    long long slices = (remaining + quantum - 1) / quantum;
+    if (until_arrival < remaining) {
+        long long until_slices = (until_arrival + quantum - 1) / quantum;
+        if (until_slices < slices)
+            slices = until_slices;
+    }
+    long long run = slices * quantum;
+    return run < remaining ? run : remaining;
+}
+
+/**
+ * @brief Round Robin that skips idle time and batches the slices of a lone process.
+ *
+ * @param processes An array of Process structures sorted by arrival.
+ * @param n The number of processes in the array.
+ * @param quantum The time quantum for the RR algorithm.
+ *
+ * @details
+ * Same queue discipline as computeRR.  When the queue is empty the clock jumps
+ * straight to the next arrival instead of ticking.  When the dequeued process is
+ * the only runnable one, rrEventRun runs all of its slices up to the next
+ * arrival in one step.
+ */
+void computeRREvent(Process processes[], int n, int quantum) {
+    computeRREventCounted(processes, n, quantum, NULL);
+}
+
+/**
+ * @brief computeRREvent that also counts its scheduling decisions.
+ *
+ * @param decisions If not NULL, receives the number of times a process was
+ *                  taken from the queue.
+ */
+void computeRREventCounted(Process processes[], int n, int quantum, long long *decisions) {
+    int *remaining = malloc(n * sizeof(int));
+    if (n > 0 && !remaining) {
+        perror("Error allocating RR state");
+        exit(EXIT_FAILURE);
+    }
+    RRQueue queue;
+    rrQueueInit(&queue, n);
+
+    for (int i = 0; i < n; i++) {
+        remaining[i] = processes[i].burst;
+        processes[i].start_time = -1;
+        processes[i].finish_time = -1;
+    }
+
+    int current_time = 0, idx = 0, completed = 0;
+    long long dequeued = 0;
+
+    while (completed < n) {
+        if (queue.size == 0 && idx < n && processes[idx].arrival > current_time)
+            current_time = processes[idx].arrival;
+        while (idx < n && processes[idx].arrival <= current_time)
+            rrQueuePush(&queue, idx++);
+
+        int proc_idx = rrQueuePop(&queue);
+        dequeued++;
+
+        if (processes[proc_idx].start_time == -1)
+            processes[proc_idx].start_time = current_time;
+
+        long long until_arrival = idx < n ? (long long)processes[idx].arrival - current_time : LLONG_MAX;
+        long long exec_time = rrEventRun(remaining[proc_idx], quantum, queue.size == 0, until_arrival);
+        remaining[proc_idx] -= (int)exec_time;
+        current_time += (int)exec_time;
+
+        while (idx < n && processes[idx].arrival <= current_time)
+            rrQueuePush(&queue, idx++);
+
+        if (remaining[proc_idx] > 0) {
+            rrQueuePush(&queue, proc_idx);
+        } else {
+            processes[proc_idx].finish_time = current_time;
+            completed++;
+        }
+    }
+
+    if (decisions)
+        *decisions = dequeued;
+    rrQueueFree(&queue);
+    free(remaining);
+}
+
+static int compareInt(const void *a, const void *b) {
+    int x = *(const int *)a, y = *(const int *)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Returns how many of the m sorted values are <= x.
+ */
+static int countAtMost(const int sorted[], int m, long long x) {
+    int lo = 0, hi = m;
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (sorted[mid] <= x)
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return lo;
+}
+
+/**
+ * @brief Round Robin in closed form for processes that all arrive at the same time.
+ *
+ * @param processes An array of Process structures with a common arrival time.
+ * @param n The number of processes in the array.
+ * @param quantum The time quantum for the RR algorithm.
+ *
+ * @details
+ * With no later arrivals the queue just cycles in table order.  Process i needs
+ * r_i = max(1, ceil(burst_i / quantum)) rounds, and by the end of its last slice
+ * every process j has run min(burst_j, r_i * quantum) if j <= i, or
+ * min(burst_j, (r_i - 1) * quantum) if j > i.  The first sum over all processes
+ * comes from prefix sums of the sorted bursts; the correction for j > i comes from
+ * Fenwick trees (count and sum of bursts) filled from the end of the table.
+ * O(n log n) regardless of how many rounds the schedule has.
+ */
+void computeRRClosedForm(Process processes[], int n, int quantum) {
+    if (n == 0)
+        return;
+    int base = processes[0].arrival;
+    int *sorted = malloc(n * sizeof(int));
+    long long *prefix = malloc((n + 1) * sizeof(long long));
+    long long *fen_count = calloc(n + 1, sizeof(long long));
+    long long *fen_sum = calloc(n + 1, sizeof(long long));
+    if (!sorted || !prefix || !fen_count || !fen_sum) {
+        perror("Error allocating RR state");
+        exit(EXIT_FAILURE);
+    }
+
+    for (int i = 0; i < n; i++)
+        sorted[i] = processes[i].burst;
+    qsort(sorted, n, sizeof(int), compareInt);
+    prefix[0] = 0;
+    for (int i = 0; i < n; i++)
+        prefix[i + 1] = prefix[i] + sorted[i];
+
+    long long first_round = 0; // Sum of min(burst_j, quantum) over j < i.
+    for (int i = 0; i < n; i++) {
+        processes[i].start_time = base + (int)first_round;
+        first_round += processes[i].burst < quantum ? processes[i].burst : quantum;
+    }
+
+    long long inserted = 0;
+    for (int i = n - 1; i >= 0; i--) {
+        long long rounds = ((long long)processes[i].burst + quantum - 1) / quantum;
+        if (rounds < 1)
+            rounds = 1;
+        long long upper = rounds * quantum, lower = upper - quantum;
+
+        // Work of every process up to min(burst, upper).
+        int below = countAtMost(sorted, n, upper);
+        long long done = prefix[below] + (n - below) * upper;
+
+        // Processes after i only got min(burst, lower): subtract their last-round share.
+        long long count_lower = 0, sum_lower = 0, count_upper = 0, sum_upper = 0;
+        for (int k = countAtMost(sorted, n, lower); k > 0; k -= k & -k) {
+            count_lower += fen_count[k];
+            sum_lower += fen_sum[k];
+        }
+        for (int k = countAtMost(sorted, n, upper - 1); k > 0; k -= k & -k) {
+            count_upper += fen_count[k];
+            sum_upper += fen_sum[k];
+        }
+        long long partial = (sum_upper - sum_lower) - (count_upper - count_lower) * lower;
+        long long full = (inserted - count_upper) * quantum;
+
+        processes[i].finish_time = base + (int)(done - partial - full);
+
+        for (int k = countAtMost(sorted, n, processes[i].burst); k <= n; k += k & -k) {
+            fen_count[k]++;
+            fen_sum[k] += processes[i].burst;
+        }
+        inserted++;
+    }
+
+    free(fen_sum);
+    free(fen_count);
+    free(prefix);
+    free(sorted);
+}
+
+/**
+ * @brief Parses an engine name ("auto", "tick", "event", "closed" or "parallel").
+ *
+ * @return 0 on success, -1 if the name is unknown.
+ */
+int parseRREngine(const char *name, RREngine *engine) {
+    for (int e = RR_ENGINE_AUTO; e <= RR_ENGINE_PARALLEL; e++) {
+        if (strcmp(name, rrEngineName((RREngine)e)) == 0) {
+            *engine = (RREngine)e;
+            return 0;
+        }
+    }
+    return -1;
+}
+
+/**
+ * @brief Returns the name of an engine.
+ */
+const char *rrEngineName(RREngine engine) {
+    static const char *const names[] = {"auto", "tick", "event", "closed", "parallel"};
+    return names[engine];
+}
+
+/**
+ * @brief Chooses the fastest correct RR engine for a trace.
+ *
+ * @param profile The profile of the (validated) trace.
+ * @param quantum The time quantum.
+ * @param threads The number of threads available.
+ * @param forced The engine requested by the user, or RR_ENGINE_AUTO.
+ * @param reason Receives a short explanation of the choice.
+ * @return The engine to run.
+ *
+ * @details
+ * Tiny traces are stepped, since setup costs dominate.  A common arrival time
+ * admits the closed form, which pays a sort up front and wins once processes
+ * need many rounds each.  Large traces whose offered load (mean burst over mean
+ * inter-arrival time) is clearly below one have many idle gaps, hence many busy
+ * periods to spread over threads.  Everything else goes to the event engine,
+ * which never does worse than stepping and wins whenever bursts span several
+ * quanta or arrivals are sparse.
+ */
+RREngine selectRREngine(const TraceProfile *profile, int quantum, int threads, RREngine forced,
+                        const char **reason) {
+    static char text[128];
+    int common_arrival = profile->count <= 1 || (profile->sorted && profile->min_gap == 0 && profile->max_gap == 0);
+    double load = profile->mean_gap > 0 ? profile->mean_burst / profile->mean_gap : 0;
+
+    if (forced == RR_ENGINE_CLOSED && !common_arrival) {
+        *reason = "forced closed form needs a common arrival time, falling back";
+        return RR_ENGINE_EVENT;
+    }
+    if (forced != RR_ENGINE_AUTO) {
+        *reason = "forced by --engine";
+        return forced;
+    }
+
+    *reason = text;
+    if (profile->count < ENGINE_TINY_TRACE) {
+        snprintf(text, sizeof(text), "tiny trace (%d < %d processes)", profile->count, ENGINE_TINY_TRACE);
+        return RR_ENGINE_TICK;
+    }
+    if (common_arrival && profile->mean_burst / quantum >= ENGINE_CLOSED_MIN_ROUNDS) {
+        snprintf(text, sizeof(text), "all %d processes arrive at %d, %.1f rounds each on average",
+                 profile->count, profile->first_arrival, profile->mean_burst / quantum);
+        return RR_ENGINE_CLOSED;
+    }
+    if (threads > 1 && profile->count >= ENGINE_PARALLEL_MIN && load < ENGINE_IDLE_UTILIZATION) {
+        snprintf(text, sizeof(text), "offered load %.2f leaves idle gaps to split on, %d threads", load, threads);
+        return RR_ENGINE_PARALLEL;
+    }
+    if (common_arrival)
+        snprintf(text, sizeof(text), "all %d processes arrive at %d but need only %.1f rounds each",
+                 profile->count, profile->first_arrival, profile->mean_burst / quantum);
+    else
+        snprintf(text, sizeof(text), "offered load %.2f, bursts average %.1f quanta", load, profile->mean_burst / quantum);
+    return RR_ENGINE_EVENT;
+}
@@ -0,0 +1,66 @@
+#ifndef ENGINES_H
+#define ENGINES_H
+
+#include "process.h"
+#include "profile.h"
+
+/**
+ * @brief The interchangeable Round Robin implementations.
+ *
+ * All of them produce exactly the schedule of computeRR.
+ */
+typedef enum {
+    RR_ENGINE_AUTO,     ///< Let selectRREngine decide.
+    RR_ENGINE_TICK,     ///< computeRR: one quantum per step, idle time one tick at a time.
+    RR_ENGINE_EVENT,    ///< Jumps over idle time and runs a lone process up to the next arrival.
+    RR_ENGINE_CLOSED,   ///< O(n log n) closed form for traces whose processes all arrive together.
+    RR_ENGINE_PARALLEL  ///< The event engine on every busy period, concurrently.
+} RREngine;
+
+#define ENGINE_TINY_TRACE 64          ///< Below this many processes, stepping is cheapest.
+#define ENGINE_PARALLEL_MIN 100000    ///< Minimum trace size worth spreading over threads.
+#define ENGINE_IDLE_UTILIZATION 0.9   ///< Offered load below which idle gaps are common.
+#define ENGINE_CLOSED_MIN_ROUNDS 16   ///< Mean rounds per process above which the closed form wins.
+
+/**
+ * @brief FIFO ring of process indices: the ready queue of the event RR engine.
+ */
+typedef struct {
+    int *items;   ///< Ring storage.
+    int capacity; ///< Capacity of items; the queue never holds more.
+    int front;    ///< Slot of the oldest entry.
+    int size;     ///< Number of entries.
+} RRQueue;
+
+void rrQueueInit(RRQueue *queue, int capacity);
+void rrQueueFree(RRQueue *queue);
+long long rrEventRun(long long remaining, int quantum, int alone, long long until_arrival);
+
+/**
+ * @brief Appends i at the back of the queue, which must not be full.
+ */
+static inline void rrQueuePush(RRQueue *queue, int i) {
+    int slot = queue->front + queue->size++;
+    queue->items[slot < queue->capacity ? slot : slot - queue->capacity] = i;
+}
+
+/**
+ * @brief Takes the entry at the front of the queue, which must not be empty.
+ */
+static inline int rrQueuePop(RRQueue *queue) {
+    int i = queue->items[queue->front];
+    if (++queue->front == queue->capacity)
+        queue->front = 0;
+    queue->size--;
+    return i;
+}
+
+void computeRREvent(Process processes[], int n, int quantum);
+void computeRREventCounted(Process processes[], int n, int quantum, long long *decisions);
+void computeRRClosedForm(Process processes[], int n, int quantum);
+int parseRREngine(const char *name, RREngine *engine);
+const char *rrEngineName(RREngine engine);
+RREngine selectRREngine(const TraceProfile *profile, int quantum, int threads, RREngine forced,
+                        const char **reason);
+
+#endif
@@ -0,0 +1,255 @@
+#include <stdlib.h>
+#include <stdint.h>
+#include <limits.h>
+#include "gang.h"
+
+/**
+ * @brief The Ousterhout matrix: one bitmap of busy columns per row.
+ *
+ * A set bit marks a column (CPU) taken in that time slice; bits past the last
+ * CPU are set once and never cleared.  Each row also caches its longest run of
+ * free columns, so rows that cannot take a process are skipped unread.
+ */
+typedef struct {
+    int rows;         ///< Time slices.
+    int cpus;         ///< Columns.
+    int words;        ///< 64-bit words per row.
+    uint64_t *bits;   ///< Row r at bits + r * words.
+    int *longest;     ///< Longest run of free columns of each row.
+    int *jobs;        ///< First process of each row, -1 if the row is empty.
+} Matrix;
+
+/**
+ * @brief Finds the first run of `width` free columns of a row.
+ *
+ * @param longest If not NULL, receives the longest free run and the whole row
+ *                is scanned.
+ * @return The first column of the run, or -1.
+ *
+ * @details
+ * Full and empty words are handled whole; in the others, runs of set and clear
+ * bits are skipped with count-trailing-zeros, so the cost is O(cpus / 64) plus
+ * the number of runs.
+ */
+static int findRun(const uint64_t *bits, int words, int width, int *longest) {
+    int start = 0, run = 0, best = 0, found = -1;
+    for (int w = 0; w < words; w++) {
+        uint64_t used = bits[w];
+        for (int b = 0; b < 64;) {
+            uint64_t rest = used >> b;
+            if (rest & 1) {
+                b += __builtin_ctzll(~rest);
+                run = 0;
+                continue;
+            }
+            int zeros = rest == 0 ? 64 - b : __builtin_ctzll(rest);
+            if (run == 0)
+                start = w * 64 + b;
+            run += zeros;
+            b += zeros;
+            if (run > best)
+                best = run;
+            if (found < 0 && run >= width) {
+                found = start;
+                if (!longest)
+                    return found;
+            }
+        }
+    }
+    if (longest)
+        *longest = best;
+    return found;
+}
+
+/**
+ * @brief Sets or clears the columns [start, start + width) of a row.
+ */
+static void markColumns(uint64_t *bits, int start, int width, int used) {
+    for (int c = start; c < start + width;) {
+        int b = c % 64, span = 64 - b < start + width - c ? 64 - b : start + width - c;
+        uint64_t mask = (span == 64 ? ~0ULL : ((1ULL << span) - 1)) << b;
+        if (used)
+            bits[c / 64] |= mask;
+        else
+            bits[c / 64] &= ~mask;
+        c += span;
+    }
+}
+
+/**
+ * @brief Places a process in the first row with enough contiguous free columns.
+ *
+ * @return The row, or -1 if the matrix has no room for it.
+ */
+static int placeProcess(Matrix *matrix, int i, int width, int *column, int *next) {
+    for (int r = 0; r < matrix->rows; r++) {
+        if (matrix->longest[r] < width)
+            continue;
+        uint64_t *bits = matrix->bits + (size_t)r * matrix->words;
+        column[i] = findRun(bits, matrix->words, width, NULL);
+        markColumns(bits, column[i], width, 1);
+        findRun(bits, matrix->words, matrix->cpus + 1, &matrix->longest[r]);
+        next[i] = matrix->jobs[r];
+        matrix->jobs[r] = i;
+        return r;
+    }
+    return -1;
+}
+
+/**
+ * @brief Computes gang scheduling of parallel processes on an Ousterhout matrix.
+ *
+ * @param processes An array of Process structures sorted by arrival.  Each
+ *                  process runs the cores column's number of threads, which
+ *                  all need burst time and always run together.
+ * @param n The number of processes in the array.
+ * @param config The CPUs, rows and time slice of the matrix.
+ * @param stats Receives utilization, fragmentation and slowdown.
+ *
+ * @details
+ * The matrix has one column per CPU and one row per time slice.  An arriving
+ * process takes a contiguous run of columns in the first row with room for
+ * it, in arrival order; when no row has room the queue waits, so a wide
+ * process is not starved by narrower ones behind it.  The non-empty rows run
+ * in turn for one quantum each, every process of the row on its own columns,
+ * and a slice ends early once all its processes are done.  Columns a row
+ * leaves unused are idle for the whole slice: the fragmentation the report
+ * counts while processes wait.
+ *
+ * Free columns are found in per-row bitmaps (see findRun), and a row whose
+ * cached longest free run is too short is skipped, so placement costs
+ * O(rows + cpus / 64).  While a single row holds processes, its slices up to
+ * the next arrival, or up to the next completion if processes wait, run as one.
+ */
+void computeGang(Process processes[], int n, const GangConfig *config, GangStats *stats) {
+    int cpus = config->cpus, quantum = config->quantum;
+    Matrix matrix = {config->rows, cpus, (cpus + 63) / 64, NULL, NULL, NULL};
+    matrix.bits = calloc((size_t)matrix.rows * matrix.words, sizeof(uint64_t));
+    matrix.longest = malloc(matrix.rows * sizeof(int));
+    matrix.jobs = malloc(matrix.rows * sizeof(int));
+    int *column = malloc((n ? n : 1) * sizeof(int));
+    int *next = malloc((n ? n : 1) * sizeof(int));
+    if (!matrix.bits || !matrix.longest || !matrix.jobs || !column || !next) {
+        perror("Error allocating gang matrix");
+        exit(EXIT_FAILURE);
+    }
+    for (int r = 0; r < matrix.rows; r++) {
+        if (cpus % 64)
+            matrix.bits[(size_t)r * matrix.words + matrix.words - 1] = ~0ULL << (cpus % 64);
+        matrix.longest[r] = cpus;
+        matrix.jobs[r] = -1;
+    }
+    for (int i = 0; i < n; i++) {
+        if (processes[i].cores < 1 || processes[i].cores > cpus) {
+            fprintf(stderr, "Invalid trace: process %d needs %d cores, the machine has %d\n", processes[i].id,
+                    processes[i].cores, cpus);
+            exit(EXIT_FAILURE);
+        }
+        processes[i].remaining = processes[i].burst;
+        processes[i].start_time = -1;
+        processes[i].finish_time = -1;
+    }
+
+    *stats = (GangStats){0};
+    int idx = 0, head = 0, completed = 0, filled = 0, turn = 0;
+    long long now = 0;
+
+    while (completed < n) {
+        for (; idx < n && processes[idx].arrival <= now; idx++)
+            ;
+        for (; head < idx; head++) {
+            int r = placeProcess(&matrix, head, processes[head].cores, column, next);
+            if (r < 0)
+                break;
+            filled += matrix.jobs[r] == head && next[head] < 0;
+        }
+        if (filled == 0) {
+            now = processes[idx].arrival;
+            continue;
+        }
+
+        while (matrix.jobs[turn] < 0)
+            turn = (turn + 1) % matrix.rows;
+        int r = turn;
+        turn = (turn + 1) % matrix.rows;
+
+        long long longest = 0, shortest = LLONG_MAX, slice = quantum;
+        for (int i = matrix.jobs[r]; i >= 0; i = next[i]) {
+            if (processes[i].remaining > longest)
+                longest = processes[i].remaining;
+            if (processes[i].remaining < shortest)
+                shortest = processes[i].remaining;
+        }
+        if (filled == 1 && longest > quantum) {
+            // Columns freed by the first process to finish may admit a waiting one.
+            long long slices = ((head < idx ? shortest : longest) + quantum - 1) / quantum;
+            if (slices < 1)
+                slices = 1;
+            if (idx < n) {
+                long long until_arrival = (processes[idx].arrival - now + quantum - 1) / quantum;
+                if (until_arrival < slices)
+                    slices = until_arrival > 0 ? until_arrival : 1;
+            }
+            slice = slices * quantum;
+        }
+        if (slice > longest)
+            slice = longest;
+
+        long long busy = 0;
+        uint64_t *bits = matrix.bits + (size_t)r * matrix.words;
+        for (int *link = &matrix.jobs[r]; *link >= 0;) {
+            int i = *link;
+            long long run = processes[i].remaining < slice ? processes[i].remaining : slice;
+            if (processes[i].start_time == -1)
+                processes[i].start_time = (int)now;
+            processes[i].remaining -= (int)run;
+            busy += run * processes[i].cores;
+            if (processes[i].remaining > 0) {
+                link = &next[i];
+                continue;
+            }
+            processes[i].finish_time = (int)(now + run);
+            completed++;
+            markColumns(bits, column[i], processes[i].cores, 0);
+            *link = next[i];
+        }
+        findRun(bits, matrix.words, cpus + 1, &matrix.longest[r]);
+        filled -= matrix.jobs[r] < 0;
+
+        stats->busy += busy;
+        stats->slice_time += slice;
+        if (head < idx)
+            stats->idle_waiting += slice * cpus - busy;
+        now += slice;
+    }
+
+    stats->makespan = (int)now;
+    for (int i = 0; i < n; i++) {
+        double slowdown = (double)(processes[i].finish_time - processes[i].arrival) /
+                          (processes[i].burst > 0 ? processes[i].burst : 1);
+        stats->mean_slowdown += slowdown / n;
+        if (slowdown > stats->max_slowdown)
+            stats->max_slowdown = slowdown;
+    }
+
+    free(next);
+    free(column);
+    free(matrix.jobs);
+    free(matrix.longest);
+    free(matrix.bits);
+}
+
+/**
+ * @brief Prints how well a gang-scheduled run used the machine.
+ */
+void printGangStats(const GangConfig *config, const GangStats *stats, FILE *out) {
+    fprintf(out, "\nGang Scheduling (%d CPUs, %d rows):\n", config->cpus, config->rows);
+    fprintf(out, "CPU Utilization: %.2f%%\n",
+            stats->makespan ? 100.0 * stats->busy / ((double)stats->makespan * config->cpus) : 0.0);
+    fprintf(out, "Idle CPUs in Slices: %.2f%%\n",
+            stats->slice_time ? 100.0 * (stats->slice_time * config->cpus - stats->busy) /
+                                ((double)stats->slice_time * config->cpus) : 0.0);
+    fprintf(out, "Fragmentation: %.2f%% (idle CPUs in slices while processes waited)\n",
+            stats->slice_time ? 100.0 * stats->idle_waiting / ((double)stats->slice_time * config->cpus) : 0.0);
+    fprintf(out, "Slowdown: mean %.2f, max %.2f\n", stats->mean_slowdown, stats->max_slowdown);
+}
@@ -0,0 +1,33 @@
+#ifndef GANG_H
+#define GANG_H
+
+#include <stdio.h>
+#include "process.h"
+
+#define GANG_DEFAULT_ROWS 4 ///< Default time slices (rows) of the Ousterhout matrix.
+
+/**
+ * @brief A machine gang scheduled through an Ousterhout matrix.
+ */
+typedef struct {
+    int cpus;    ///< Columns of the matrix.
+    int rows;    ///< Time slices of the matrix, the multiprogramming level.
+    int quantum; ///< Length of one time slice.
+} GangConfig;
+
+/**
+ * @brief Outcome of a gang-scheduled run.
+ */
+typedef struct {
+    long long busy;         ///< CPU time spent running processes.
+    long long slice_time;   ///< Time spent in time slices.
+    long long idle_waiting; ///< Idle CPU time in slices while processes waited.
+    int makespan;           ///< Finish time of the last process.
+    double mean_slowdown;   ///< Turnaround over burst, averaged over processes.
+    double max_slowdown;    ///< Largest turnaround over burst.
+} GangStats;
+
+void computeGang(Process processes[], int n, const GangConfig *config, GangStats *stats);
+void printGangStats(const GangConfig *config, const GangStats *stats, FILE *out);
+
+#endif
@@ -0,0 +1,264 @@
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+#include "groupby.h"
+
+static const char *const class_names[] = {"batch", "interactive", "system"};
+#define NAMED_CLASSES (int)(sizeof(class_names) / sizeof(class_names[0]))
+
+/**
+ * @brief Maps a class column value to a class id.
+ *
+ * @param name Either a class number or one of "batch", "interactive", "system".
+ * @return The class id, or -1 if the value is not a valid class.
+ */
+int parseClass(const char *name) {
+    for (int i = 0; i < NAMED_CLASSES; i++)
+        if (strcmp(name, class_names[i]) == 0)
+            return i;
+
+    char *end;
+    long cls = strtol(name, &end, 10);
+    if (*end != '\0' || end == name || cls < 0 || cls >= MAX_CLASSES)
+        return -1;
+    return (int)cls;
+}
+
+/**
+ * @brief Returns the display name of a class id.
+ */
+const char *className(int cls) {
+    static char numbered[MAX_CLASSES][12];
+    if (cls < NAMED_CLASSES)
+        return class_names[cls];
+    snprintf(numbered[cls], sizeof(numbered[cls]), "%d", cls);
+    return numbered[cls];
+}
+
+/**
+ * @brief Returns the log-linear histogram bucket of a non-negative value.
+ */
+int histBucket(int value) {
+    if (value < 2 * HIST_SUB_BUCKETS)
+        return value < 0 ? 0 : value;
+    int shift = 31 - __builtin_clz((unsigned)value) - 5; // value >> shift in [32, 63]
+    return shift * HIST_SUB_BUCKETS + (value >> shift);
+}
+
+/**
+ * @brief Returns the value a bucket stands for (the middle of its range).
+ */
+int histValue(int bucket) {
+    if (bucket < 2 * HIST_SUB_BUCKETS)
+        return bucket;
+    int shift = bucket / HIST_SUB_BUCKETS - 1;
+    int mantissa = bucket - shift * HIST_SUB_BUCKETS;
+    return (mantissa << shift) + ((1 << shift) - 1) / 2;
+}
+
+/**
+ * @brief Returns the p-th percentile (0 < p <= 1) of a histogram holding count values.
+ */
+int histPercentile(const long long hist[], long long count, double p) {
+    long long rank = (long long)(p * count + 0.999999);
+    long long seen = 0;
+    if (rank < 1)
+        rank = 1;
+    for (int b = 0; b < HIST_BUCKETS; b++) {
+        seen += hist[b];
+        if (seen >= rank)
+            return histValue(b);
+    }
+    return 0;
+}
+
+typedef struct {
+    Process *processes;
+    int begin, end;
+    ClassAccumulator *acc; ///< MAX_CLASSES accumulators owned by this worker.
+} GroupByTask;
+
+/**
+ * @brief Accumulates the processes [begin, end) of a task into its partials.
+ */
+static void *accumulateClasses(void *arg) {
+    GroupByTask *task = arg;
+    for (int i = task->begin; i < task->end; i++) {
+        const Process *p = &task->processes[i];
+        ClassAccumulator *acc = &task->acc[p->cls];
+        int tat = p->finish_time - p->arrival; //Turnaround Time
+        int rt = p->start_time - p->arrival; //Response Time
+        acc->count++;
+        acc->total_tat += tat;
+        acc->total_rt += rt;
+        acc->total_wt += tat - p->burst;
+        if (p->finish_time > acc->max_finish)
+            acc->max_finish = p->finish_time;
+        acc->tat_hist[histBucket(tat)]++;
+        acc->rt_hist[histBucket(rt)]++;
+    }
+    return NULL;
+}
+
+/**
+ * @brief Calculates the performance metrics of every job class in a single pass.
+ *
+ * @param processes An array of Process structures with start and finish times set.
+ * @param n The number of processes in the array.
+ * @param threads The number of worker threads to split the array over.
+ * @param metrics The per-class results, indexed by class id.
+ *
+ * @details
+ * Each worker owns a dense array of MAX_CLASSES accumulators and scans a contiguous
+ * slice of the table, so there is no sharing while scanning.  The partials are
+ * merged at the end, which costs O(threads * MAX_CLASSES * HIST_BUCKETS) regardless
+ * of n.  Throughput is measured over the makespan of the whole schedule so that
+ * the class throughputs add up to the overall one.
+ */
+void calculateClassMetrics(Process processes[], int n, int threads, ClassMetrics metrics[MAX_CLASSES]) {
+    if (threads < 1)
+        threads = 1;
+    if (threads > n)
+        threads = n > 0 ? n : 1;
+
+    GroupByTask *tasks = malloc(threads * sizeof(GroupByTask));
+    pthread_t *workers = malloc(threads * sizeof(pthread_t));
+    ClassAccumulator *acc = calloc((size_t)threads * MAX_CLASSES, sizeof(ClassAccumulator));
+    if (!tasks || !workers || !acc) {
+        perror("Error allocating class accumulators");
+        exit(EXIT_FAILURE);
+    }
+
+    for (int t = 0; t < threads; t++) {
+        tasks[t].processes = processes;
+        tasks[t].begin = (int)((long long)n * t / threads);
+        tasks[t].end = (int)((long long)n * (t + 1) / threads);
+        tasks[t].acc = &acc[t * MAX_CLASSES];
+        if (t > 0 && pthread_create(&workers[t], NULL, accumulateClasses, &tasks[t]) != 0) {
+            perror("Error creating worker thread");
+            exit(EXIT_FAILURE);
+        }
+    }
+    accumulateClasses(&tasks[0]);
+
+    for (int t = 1; t < threads; t++) {
+        pthread_join(workers[t], NULL);
+        for (int c = 0; c < MAX_CLASSES; c++) {
+            ClassAccumulator *dst = &acc[c], *src = &acc[t * MAX_CLASSES + c];
+            dst->count += src->count;
+            dst->total_tat += src->total_tat;
+            dst->total_rt += src->total_rt;
+            dst->total_wt += src->total_wt;
+            if (src->max_finish > dst->max_finish)
+                dst->max_finish = src->max_finish;
+            for (int b = 0; b < HIST_BUCKETS; b++) {
+                dst->tat_hist[b] += src->tat_hist[b];
+                dst->rt_hist[b] += src->rt_hist[b];
+            }
+        }
+    }
+
+    int makespan = 0;
+    for (int c = 0; c < MAX_CLASSES; c++)
+        if (acc[c].max_finish > makespan)
+            makespan = acc[c].max_finish;
+
+    for (int c = 0; c < MAX_CLASSES; c++) {
+        ClassAccumulator *a = &acc[c];
+        ClassMetrics *m = &metrics[c];
+        memset(m, 0, sizeof(*m));
+        m->count = (int)a->count;
+        if (a->count == 0)
+            continue;
+        m->avg_tat = (float)a->total_tat / a->count;
+        m->avg_rt = (float)a->total_rt / a->count;
+        m->avg_wt = (float)a->total_wt / a->count;
+        m->tat_p50 = histPercentile(a->tat_hist, a->count, 0.50);
+        m->tat_p95 = histPercentile(a->tat_hist, a->count, 0.95);
+        m->tat_p99 = histPercentile(a->tat_hist, a->count, 0.99);
+        m->rt_p50 = histPercentile(a->rt_hist, a->count, 0.50);
+        m->rt_p95 = histPercentile(a->rt_hist, a->count, 0.95);
+        m->rt_p99 = histPercentile(a->rt_hist, a->count, 0.99);
+        m->throughput = makespan > 0 ? (float)a->count / makespan : 0;
+    }
+
+    free(acc);
+    free(workers);
+    free(tasks);
+}
+
+/**
+ * @brief Prints the metrics of every class that has at least one process.
+ */
+void printClassMetrics(const ClassMetrics metrics[MAX_CLASSES], FILE *out) {
+    for (int c = 0; c < MAX_CLASSES; c++) {
+        const ClassMetrics *m = &metrics[c];
+        if (m->count == 0)
+            continue;
+        fprintf(out, "Class %s (%d processes):\n", className(c), m->count);
+        fprintf(out, "  Average Turnaround Time: %.2f (p50 %d, p95 %d, p99 %d)\n",
+                m->avg_tat, m->tat_p50, m->tat_p95, m->tat_p99);
+        fprintf(out, "  Average Response Time: %.2f (p50 %d, p95 %d, p99 %d)\n",
+                m->avg_rt, m->rt_p50, m->rt_p95, m->rt_p99);
+        fprintf(out, "  Average Waiting Time: %.2f\n", m->avg_wt);
+        fprintf(out, "  Throughput: %.2f processes/ut\n", m->throughput);
+    }
+}
+
+/**
+ * @brief Summarizes the response and turnaround time distributions of a schedule.
+ *
+ * @details
+ * The percentiles come from the same log-linear histograms as the class
+ * metrics, so they are within ~3% and cost one pass with no sorting.
+ */
+void summarizeLatency(const Process processes[], int n, LatencySummary *summary) {
+    long long *rt_hist = calloc(2 * HIST_BUCKETS, sizeof(long long));
+    if (!rt_hist) {
+        perror("Error allocating latency histograms");
+        exit(EXIT_FAILURE);
+    }
+    long long *tat_hist = rt_hist + HIST_BUCKETS;
+    *summary = (LatencySummary){0};
+    for (int i = 0; i < n; i++) {
+        int tat = processes[i].finish_time - processes[i].arrival; //Turnaround Time
+        int rt = processes[i].start_time - processes[i].arrival; //Response Time
+        rt_hist[histBucket(rt)]++;
+        tat_hist[histBucket(tat)]++;
+        if (rt > summary->rt_max)
+            summary->rt_max = rt;
+        if (tat > summary->tat_max)
+            summary->tat_max = tat;
+    }
+    if (n > 0) {
+        summary->rt_p50 = histPercentile(rt_hist, n, 0.50);
+        summary->rt_p90 = histPercentile(rt_hist, n, 0.90);
+        summary->rt_p99 = histPercentile(rt_hist, n, 0.99);
+        summary->tat_p50 = histPercentile(tat_hist, n, 0.50);
+        summary->tat_p90 = histPercentile(tat_hist, n, 0.90);
+        summary->tat_p99 = histPercentile(tat_hist, n, 0.99);
+    }
+    // A bucket stands for the middle of its range, which may lie past the maximum.
+    int *clamp[] = {&summary->rt_p50, &summary->rt_p90, &summary->rt_p99,
+                    &summary->tat_p50, &summary->tat_p90, &summary->tat_p99};
+    for (int k = 0; k < 6; k++) {
+        int max = k < 3 ? summary->rt_max : summary->tat_max;
+        if (*clamp[k] > max)
+            *clamp[k] = max;
+    }
+    free(rt_hist);
+}
+
+/**
+ * @brief Prints the latency summaries of several schedules as one table.
+ */
+void printLatencyTable(const char *const algorithms[], const LatencySummary summaries[], int count, FILE *out) {
+    fprintf(out, "%-12s %39s  %39s\n", "", "Response Time", "Turnaround Time");
+    fprintf(out, "%-12s %9s %9s %9s %9s  %9s %9s %9s %9s\n", "Algorithm", "p50", "p90", "p99", "max", "p50",
+            "p90", "p99", "max");
+    for (int a = 0; a < count; a++) {
+        const LatencySummary *s = &summaries[a];
+        fprintf(out, "%-12s %9d %9d %9d %9d  %9d %9d %9d %9d\n", algorithms[a], s->rt_p50, s->rt_p90, s->rt_p99,
+                s->rt_max, s->tat_p50, s->tat_p90, s->tat_p99, s->tat_max);
+    }
+}
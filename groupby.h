@@ -0,0 +1,58 @@
+#ifndef GROUPBY_H
+#define GROUPBY_H
+
+#include <stdio.h>
+#include "process.h"
+
+#define MAX_CLASSES 8          ///< Number of job class ids (0..MAX_CLASSES-1).
+#define HIST_SUB_BUCKETS 32    ///< Sub-buckets per power of two (~3% percentile error).
+#define HIST_BUCKETS (27 * HIST_SUB_BUCKETS) ///< Enough buckets for any non-negative int.
+
+/**
+ * @brief Running totals for one job class.
+ *
+ * The histograms are log-linear: values below 2 * HIST_SUB_BUCKETS have a bucket
+ * of their own, larger values share a bucket with values within ~3% of them.
+ */
+typedef struct {
+    long long count;                 ///< Completed processes in the class.
+    long long total_tat;             ///< Sum of turnaround times.
+    long long total_rt;              ///< Sum of response times.
+    long long total_wt;              ///< Sum of waiting times.
+    int max_finish;                  ///< Latest finish time in the class.
+    long long tat_hist[HIST_BUCKETS];///< Turnaround time histogram.
+    long long rt_hist[HIST_BUCKETS]; ///< Response time histogram.
+} ClassAccumulator;
+
+/**
+ * @brief Aggregate metrics of one job class.
+ */
+typedef struct {
+    int count;            ///< Completed processes in the class.
+    float avg_tat;        ///< Average turnaround time.
+    float avg_rt;         ///< Average response time.
+    float avg_wt;         ///< Average waiting time.
+    int tat_p50, tat_p95, tat_p99; ///< Turnaround time percentiles.
+    int rt_p50, rt_p95, rt_p99;    ///< Response time percentiles.
+    float throughput;     ///< Class completions per unit of the schedule's makespan.
+} ClassMetrics;
+
+/**
+ * @brief Latency percentiles of a whole schedule, for side-by-side comparisons.
+ */
+typedef struct {
+    int rt_p50, rt_p90, rt_p99, rt_max;     ///< Response time percentiles and maximum.
+    int tat_p50, tat_p90, tat_p99, tat_max; ///< Turnaround time percentiles and maximum.
+} LatencySummary;
+
+int parseClass(const char *name);
+const char *className(int cls);
+int histBucket(int value);
+int histValue(int bucket);
+int histPercentile(const long long hist[], long long count, double p);
+void calculateClassMetrics(Process processes[], int n, int threads, ClassMetrics metrics[MAX_CLASSES]);
+void printClassMetrics(const ClassMetrics metrics[MAX_CLASSES], FILE *out);
+void summarizeLatency(const Process processes[], int n, LatencySummary *summary);
+void printLatencyTable(const char *const algorithms[], const LatencySummary summaries[], int count, FILE *out);
+
+#endif
@@ -0,0 +1,73 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "heap.h"
+
+static int heapLess(HeapItem a, HeapItem b) {
+    return a.key < b.key || (a.key == b.key && a.value < b.value);
+}
+
+/**
+ * @brief Initializes an empty heap with room for capacity entries.
+ */
+void heapInit(MinHeap *heap, int capacity) {
+    heap->size = 0;
+    heap->capacity = capacity > 0 ? capacity : 16;
+    heap->items = malloc(heap->capacity * sizeof(HeapItem));
+    if (!heap->items) {
+        perror("Error allocating heap");
+        exit(EXIT_FAILURE);
+    }
+}
+
+/**
+ * @brief Releases the entries of a heap.
+ */
+void heapFree(MinHeap *heap) {
+    free(heap->items);
+    heap->items = NULL;
+    heap->size = heap->capacity = 0;
+}
+
+/**
+ * @brief Inserts an entry in O(log n), doubling the heap when full.
+ */
+void heapPush(MinHeap *heap, long long key, int value) {
+    if (heap->size == heap->capacity) {
+        heap->capacity *= 2;
+        heap->items = realloc(heap->items, heap->capacity * sizeof(HeapItem));
+        if (!heap->items) {
+            perror("Error allocating heap");
+            exit(EXIT_FAILURE);
+        }
+    }
+    HeapItem item = {key, value};
+    int i = heap->size++;
+    while (i > 0 && heapLess(item, heap->items[(i - 1) / 2])) {
+        heap->items[i] = heap->items[(i - 1) / 2];
+        i = (i - 1) / 2;
+    }
+    heap->items[i] = item;
+}
+
+/**
+ * @brief Removes and returns the smallest entry in O(log n); the heap must not be empty.
+ */
+HeapItem heapPop(MinHeap *heap) {
+    HeapItem top = heap->items[0];
+    HeapItem last = heap->items[--heap->size];
+    int i = 0;
+    for (;;) {
+        int child = 2 * i + 1;
+        if (child >= heap->size)
+            break;
+        if (child + 1 < heap->size && heapLess(heap->items[child + 1], heap->items[child]))
+            child++;
+        if (!heapLess(heap->items[child], last))
+            break;
+        heap->items[i] = heap->items[child];
+        i = child;
+    }
+    if (heap->size > 0)
+        heap->items[i] = last;
+    return top;
+}
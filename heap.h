@@ -0,0 +1,26 @@
+#ifndef HEAP_H
+#define HEAP_H
+
+/**
+ * @brief An entry of a MinHeap: entries are ordered by key, then by value.
+ */
+typedef struct {
+    long long key; ///< Priority, smallest first.
+    int value;     ///< Payload, usually a process index; breaks ties.
+} HeapItem;
+
+/**
+ * @brief Growable binary min-heap of HeapItem.
+ */
+typedef struct {
+    HeapItem *items; ///< Heap-ordered entries.
+    int size;        ///< Number of entries.
+    int capacity;    ///< Capacity of items.
+} MinHeap;
+
+void heapInit(MinHeap *heap, int capacity);
+void heapFree(MinHeap *heap);
+void heapPush(MinHeap *heap, long long key, int value);
+HeapItem heapPop(MinHeap *heap);
+
+#endif
@@ -0,0 +1,456 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <time.h>
+#include <unistd.h>
+#include <stdatomic.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <linux/io_uring.h>
+#include "loader.h"
+#include "schema.h"
+
+/**
+ * @brief Incremental trace parser fed with arbitrary chunks of the file.
+ */
+typedef struct {
+    Process *table;       ///< Parsed processes.
+    int count;            ///< Number of parsed processes.
+    int capacity;         ///< Capacity of table.
+    int lines;            ///< Lines parsed so far, the header included.
+    unsigned fields;      ///< FIELD_BIT values the run uses.
+    TraceSchema schema;   ///< Column map built from the header line.
+    char *carry;          ///< Partial line left over from the previous chunk.
+    size_t carry_len;     ///< Bytes in carry.
+    size_t carry_cap;     ///< Capacity of carry.
+} ChunkParser;
+
+/**
+ * @brief Parses one line [s, end): the header on the first call, a process afterwards.
+ */
+static void parseLine(ChunkParser *parser, const char *s, const char *end) {
+    if (parser->lines++ == 0) {
+        parseSchema(s, end, parser->fields, &parser->schema);
+        return;
+    }
+
+    if (parser->count == parser->capacity) {
+        parser->capacity = parser->capacity ? parser->capacity * 2 : 1024;
+        parser->table = realloc(parser->table, parser->capacity * sizeof(Process));
+        if (!parser->table) {
+            perror("Error allocating process table");
+            exit(EXIT_FAILURE);
+        }
+    }
+    parser->count += parseRecord(&parser->schema, s, end, parser->lines, &parser->table[parser->count]);
+}
+
+/**
+ * @brief Parses every complete line of a chunk and keeps the partial last line.
+ */
+static void feedChunk(ChunkParser *parser, const char *data, size_t len) {
+    const char *p = data, *end = data + len;
+
+    if (parser->carry_len > 0) {
+        const char *newline = memchr(p, '\n', len);
+        size_t part = newline ? (size_t)(newline - p) : len;
+        if (parser->carry_len + part > parser->carry_cap) {
+            parser->carry_cap = (parser->carry_len + part) * 2;
+            parser->carry = realloc(parser->carry, parser->carry_cap);
+            if (!parser->carry) {
+                perror("Error allocating line buffer");
+                exit(EXIT_FAILURE);
+            }
+        }
+        memcpy(parser->carry + parser->carry_len, p, part);
+        parser->carry_len += part;
+        if (!newline)
+            return;
+        parseLine(parser, parser->carry, parser->carry + parser->carry_len);
+        parser->carry_len = 0;
+        p = newline + 1;
+    }
+
+    for (;;) {
+        const char *newline = memchr(p, '\n', (size_t)(end - p));
+        if (!newline)
+            break;
+        parseLine(parser, p, newline);
+        p = newline + 1;
+    }
+
+    size_t rest = (size_t)(end - p);
+    if (rest > parser->carry_cap) {
+        parser->carry_cap = rest * 2;
+        parser->carry = realloc(parser->carry, parser->carry_cap);
+        if (!parser->carry) {
+            perror("Error allocating line buffer");
+            exit(EXIT_FAILURE);
+        }
+    }
+    memcpy(parser->carry, p, rest);
+    parser->carry_len = rest;
+}
+
+/**
+ * @brief Parses the last line if the file does not end with a newline.
+ */
+static int finishParser(ChunkParser *parser, Process **processes) {
+    if (parser->lines == 0)
+        defaultSchema(parser->fields, &parser->schema);
+    if (parser->carry_len > 0)
+        parseLine(parser, parser->carry, parser->carry + parser->carry_len);
+    free(parser->carry);
+    *processes = parser->table ? parser->table : malloc(sizeof(Process));
+    return parser->count;
+}
+
+/**
+ * @brief Reads exactly len bytes at offset unless the file ends first.
+ *
+ * @return The number of bytes read.
+ */
+static size_t preadFully(int fd, char *buf, size_t len, off_t offset) {
+    size_t done = 0;
+    while (done < len) {
+        ssize_t got = pread(fd, buf + done, len - done, offset + (off_t)done);
+        if (got < 0 && errno == EINTR)
+            continue;
+        if (got < 0) {
+            perror("Error reading file");
+            exit(EXIT_FAILURE);
+        }
+        if (got == 0)
+            break;
+        done += (size_t)got;
+    }
+    return done;
+}
+
+/**
+ * @brief Loads a trace with synchronous chunked pread calls.
+ */
+static int loadWithPread(int fd, ChunkParser *parser) {
+    char *buf;
+    if (posix_memalign((void **)&buf, 4096, LOADER_CHUNK_SIZE) != 0) {
+        perror("Error allocating read buffer");
+        exit(EXIT_FAILURE);
+    }
+    off_t offset = 0;
+    size_t got;
+    while ((got = preadFully(fd, buf, LOADER_CHUNK_SIZE, offset)) > 0) {
+        feedChunk(parser, buf, got);
+        offset += (off_t)got;
+    }
+    free(buf);
+    return 0;
+}
+
+/**
+ * @brief A minimal io_uring instance: the mapped rings of one queue.
+ */
+typedef struct {
+    int fd;
+    unsigned *sq_tail, *sq_mask, *sq_array;
+    unsigned *cq_head, *cq_tail, *cq_mask;
+    struct io_uring_sqe *sqes;
+    struct io_uring_cqe *cqes;
+    void *sq_ring, *cq_ring;
+    size_t sq_ring_size, cq_ring_size, sqes_size;
+} Uring;
+
+/**
+ * @brief Unmaps the rings that were mapped and closes the instance.
+ */
+static void uringClose(Uring *ring) {
+    if (ring->sqes != MAP_FAILED)
+        munmap(ring->sqes, ring->sqes_size);
+    if (ring->cq_ring != ring->sq_ring && ring->cq_ring != MAP_FAILED)
+        munmap(ring->cq_ring, ring->cq_ring_size);
+    if (ring->sq_ring != MAP_FAILED)
+        munmap(ring->sq_ring, ring->sq_ring_size);
+    close(ring->fd);
+}
+
+/**
+ * @brief Sets up an io_uring instance without liburing.
+ *
+ * @return 0 on success, -1 if the kernel does not offer io_uring or a ring cannot be mapped
+ *         (whatever was mapped is unmapped and the instance closed).
+ */
+static int uringSetup(Uring *ring, unsigned entries) {
+    struct io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    ring->fd = (int)syscall(__NR_io_uring_setup, entries, &params);
+    if (ring->fd < 0)
+        return -1;
+
+    ring->sq_ring_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    ring->cq_ring_size = params.cq_off.cqes + params.cq_entries * sizeof(struct io_uring_cqe);
+    if (params.features & IORING_FEAT_SINGLE_MMAP) {
+        if (ring->cq_ring_size > ring->sq_ring_size)
+            ring->sq_ring_size = ring->cq_ring_size;
+        ring->cq_ring_size = ring->sq_ring_size;
+    }
+    ring->sqes_size = params.sq_entries * sizeof(struct io_uring_sqe);
+
+    ring->sq_ring = mmap(NULL, ring->sq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                         ring->fd, IORING_OFF_SQ_RING);
+    ring->cq_ring = (params.features & IORING_FEAT_SINGLE_MMAP) ? ring->sq_ring :
+        mmap(NULL, ring->cq_ring_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+             ring->fd, IORING_OFF_CQ_RING);
+    ring->sqes = mmap(NULL, ring->sqes_size, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                      ring->fd, IORING_OFF_SQES);
+    if (ring->sq_ring == MAP_FAILED || ring->cq_ring == MAP_FAILED || ring->sqes == MAP_FAILED) {
+        uringClose(ring);
+        return -1;
+    }
+
+    char *sq = ring->sq_ring, *cq = ring->cq_ring;
+    ring->sq_tail = (unsigned *)(sq + params.sq_off.tail);
+    ring->sq_mask = (unsigned *)(sq + params.sq_off.ring_mask);
+    ring->sq_array = (unsigned *)(sq + params.sq_off.array);
+    ring->cq_head = (unsigned *)(cq + params.cq_off.head);
+    ring->cq_tail = (unsigned *)(cq + params.cq_off.tail);
+    ring->cq_mask = (unsigned *)(cq + params.cq_off.ring_mask);
+    ring->cqes = (struct io_uring_cqe *)(cq + params.cq_off.cqes);
+    return 0;
+}
+
+/**
+ * @brief Queues a readv of one buffer; it is submitted by the next uringEnter.
+ */
+static void uringQueueRead(Uring *ring, int fd, struct iovec *iov, off_t offset, unsigned long long tag) {
+    unsigned tail = *ring->sq_tail;
+    unsigned idx = tail & *ring->sq_mask;
+    struct io_uring_sqe *sqe = &ring->sqes[idx];
+    memset(sqe, 0, sizeof(*sqe));
+    sqe->opcode = IORING_OP_READV;
+    sqe->fd = fd;
+    sqe->addr = (unsigned long long)(uintptr_t)iov;
+    sqe->len = 1;
+    sqe->off = (unsigned long long)offset;
+    sqe->user_data = tag;
+    ring->sq_array[idx] = idx;
+    atomic_store_explicit((_Atomic unsigned *)ring->sq_tail, tail + 1, memory_order_release);
+}
+
+/**
+ * @brief Submits queued reads and waits for at least min_complete completions.
+ */
+static int uringEnter(Uring *ring, unsigned to_submit, unsigned min_complete) {
+    int ret;
+    do {
+        ret = (int)syscall(__NR_io_uring_enter, ring->fd, to_submit, min_complete,
+                           min_complete ? IORING_ENTER_GETEVENTS : 0, NULL, 0);
+    } while (ret < 0 && errno == EINTR);
+    return ret;
+}
+
+typedef struct {
+    char *data;          ///< Page-aligned chunk buffer.
+    struct iovec iov;    ///< The readv vector pointing at data.
+    long long chunk;     ///< Chunk number being read into data, -1 if idle.
+    long long result;    ///< Bytes read, or -1 while the read is in flight.
+} ReadSlot;
+
+/**
+ * @brief Loads a trace with LOADER_QUEUE_DEPTH io_uring reads in flight.
+ *
+ * @return 0 on success, -1 if io_uring is unavailable (nothing has been parsed).
+ *
+ * @details
+ * Chunk k is read into slot k % LOADER_QUEUE_DEPTH.  Chunks are parsed strictly
+ * in order; as soon as a chunk is parsed its slot is reused for the chunk
+ * LOADER_QUEUE_DEPTH positions ahead, so the kernel keeps reading while the
+ * parser works on the current buffer.
+ */
+static int loadWithUring(int fd, ChunkParser *parser) {
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        perror("Error reading file");
+        exit(EXIT_FAILURE);
+    }
+    long long chunks = (st.st_size + LOADER_CHUNK_SIZE - 1) / LOADER_CHUNK_SIZE;
+
+    Uring ring;
+    if (uringSetup(&ring, LOADER_QUEUE_DEPTH) != 0)
+        return -1;
+
+    ReadSlot slots[LOADER_QUEUE_DEPTH];
+    unsigned pending_submit = 0;
+    for (int s = 0; s < LOADER_QUEUE_DEPTH; s++) {
+        if (posix_memalign((void **)&slots[s].data, 4096, LOADER_CHUNK_SIZE) != 0) {
+            perror("Error allocating read buffer");
+            exit(EXIT_FAILURE);
+        }
+        slots[s].iov.iov_base = slots[s].data;
+        slots[s].iov.iov_len = LOADER_CHUNK_SIZE;
+        slots[s].chunk = s < chunks ? s : -1;
+        slots[s].result = -1;
+        if (slots[s].chunk >= 0) {
+            uringQueueRead(&ring, fd, &slots[s].iov, (off_t)s * LOADER_CHUNK_SIZE, (unsigned long long)s);
+            pending_submit++;
+        }
+    }
+
+    for (long long chunk = 0; chunk < chunks; chunk++) {
+        ReadSlot *slot = &slots[chunk % LOADER_QUEUE_DEPTH];
+
+        while (slot->result < 0) {
+            if (uringEnter(&ring, pending_submit, 1) < 0) {
+                perror("Error waiting for io_uring");
+                exit(EXIT_FAILURE);
+            }
+            pending_submit = 0;
+
+            unsigned head = *ring.cq_head;
+            unsigned tail = atomic_load_explicit((_Atomic unsigned *)ring.cq_tail, memory_order_acquire);
+            for (; head != tail; head++) {
+                struct io_uring_cqe *cqe = &ring.cqes[head & *ring.cq_mask];
+                ReadSlot *done = &slots[cqe->user_data];
+                if (cqe->res < 0) {
+                    errno = -cqe->res;
+                    perror("Error reading file");
+                    exit(EXIT_FAILURE);
+                }
+                done->result = cqe->res;
+            }
+            atomic_store_explicit((_Atomic unsigned *)ring.cq_head, head, memory_order_release);
+        }
+
+        // A short read in the middle of the file is completed synchronously.
+        size_t len = (size_t)slot->result;
+        off_t offset = (off_t)chunk * LOADER_CHUNK_SIZE;
+        if (len < LOADER_CHUNK_SIZE && chunk + 1 < chunks)
+            len += preadFully(fd, slot->data + len, LOADER_CHUNK_SIZE - len, offset + (off_t)len);
+        feedChunk(parser, slot->data, len);
+
+        long long next = chunk + LOADER_QUEUE_DEPTH;
+        slot->result = -1;
+        slot->chunk = next < chunks ? next : -1;
+        if (slot->chunk >= 0) {
+            uringQueueRead(&ring, fd, &slot->iov, (off_t)next * LOADER_CHUNK_SIZE,
+                           (unsigned long long)(chunk % LOADER_QUEUE_DEPTH));
+            pending_submit++;
+        }
+    }
+
+    for (int s = 0; s < LOADER_QUEUE_DEPTH; s++)
+        free(slots[s].data);
+    uringClose(&ring);
+    return 0;
+}
+
+/**
+ * @brief Parses the name of a loader ("stdio", "pread" or "uring").
+ *
+ * @return 0 on success, -1 if the name is unknown.
+ */
+int parseLoaderKind(const char *name, LoaderKind *kind) {
+    if (strcmp(name, "stdio") == 0)
+        *kind = LOADER_STDIO;
+    else if (strcmp(name, "pread") == 0)
+        *kind = LOADER_PREAD;
+    else if (strcmp(name, "uring") == 0)
+        *kind = LOADER_URING;
+    else
+        return -1;
+    return 0;
+}
+
+/**
+ * @brief Reads a trace file with the chosen loader.
+ *
+ * @param filename The name of the file containing process data.
+ * @param processes Receives a heap-allocated array of Process structures.
+ * @param kind The loader to use.  LOADER_URING falls back to LOADER_PREAD on
+ *             kernels (or sandboxes) without io_uring.
+ * @param fields Bitmask of FIELD_BIT values the run uses; other columns are skipped.
+ * @return The number of processes read from the file.
+ */
+int loadProcesses(const char *filename, Process **processes, LoaderKind kind, unsigned fields) {
+    if (kind == LOADER_STDIO)
+        return readProcesses(filename, processes, fields);
+
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0) {
+        perror("Error opening file");
+        exit(EXIT_FAILURE);
+    }
+    posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+
+    ChunkParser parser;
+    memset(&parser, 0, sizeof(parser));
+    parser.fields = fields;
+    if (kind != LOADER_URING || loadWithUring(fd, &parser) != 0)
+        loadWithPread(fd, &parser);
+
+    close(fd);
+    return finishParser(&parser, processes);
+}
+
+/**
+ * @brief Returns the monotonic clock in milliseconds.
+ */
+static double nowMs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e3 + ts.tv_nsec / 1e6;
+}
+
+/**
+ * @brief Loads a trace with every loader, checks they agree and prints their timings.
+ *
+ * @param filename The trace file.
+ * @param fields Bitmask of FIELD_BIT values to convert.
+ * @return EXIT_SUCCESS if every loader produced the same table, EXIT_FAILURE otherwise.
+ *
+ * @details
+ * Each loader runs LOADER_BENCH_RUNS times and the best time is reported, so the
+ * first run warms the page cache for the others.  Drop the page cache between
+ * invocations to measure cold-storage behaviour.
+ */
+int benchmarkLoaders(const char *filename, unsigned fields) {
+    static const char *const names[] = {"stdio", "pread", "uring"};
+    enum { LOADER_BENCH_RUNS = 3 };
+    Process *reference = NULL;
+    int reference_n = 0, status = EXIT_SUCCESS;
+    struct stat st;
+    double megabytes = stat(filename, &st) == 0 ? st.st_size / 1e6 : 0;
+
+    for (int k = LOADER_STDIO; k <= LOADER_URING; k++) {
+        double best = 0;
+        Process *table = NULL;
+        int n = 0;
+        for (int run = 0; run < LOADER_BENCH_RUNS; run++) {
+            free(table);
+            double start = nowMs();
+            n = loadProcesses(filename, &table, (LoaderKind)k, fields);
+            double elapsed = nowMs() - start;
+            if (run == 0 || elapsed < best)
+                best = elapsed;
+        }
+
+        printf("%-6s %d processes in %.2f ms (%.1f MB/s)\n", names[k], n, best,
+               best > 0 ? megabytes * 1e3 / best : 0.0);
+        if (k == LOADER_STDIO) {
+            reference = table;
+            reference_n = n;
+            continue;
+        }
+        if (n != reference_n || memcmp(table, reference, n * sizeof(Process)) != 0) {
+            fprintf(stderr, "%s loader disagrees with stdio\n", names[k]);
+            status = EXIT_FAILURE;
+        }
+        free(table);
+    }
+
+    free(reference);
+    return status;
+}
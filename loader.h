@@ -0,0 +1,22 @@
+#ifndef LOADER_H
+#define LOADER_H
+
+#include "process.h"
+
+#define LOADER_CHUNK_SIZE (1 << 20) ///< Bytes per read, a multiple of the page size.
+#define LOADER_QUEUE_DEPTH 4        ///< Reads kept in flight by the io_uring loader.
+
+/**
+ * @brief Strategy used to read a trace file.
+ */
+typedef enum {
+    LOADER_STDIO, ///< readProcesses: getline line by line.
+    LOADER_PREAD, ///< Large synchronous pread calls and a hand-written parser.
+    LOADER_URING  ///< Asynchronous io_uring reads overlapped with parsing.
+} LoaderKind;
+
+int parseLoaderKind(const char *name, LoaderKind *kind);
+int loadProcesses(const char *filename, Process **processes, LoaderKind kind, unsigned fields);
+int benchmarkLoaders(const char *filename, unsigned fields);
+
+#endif
@@ -1,237 +1,756 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <getopt.h>
+#include "process.h"
+#include "rangeindex.h"
+#include "groupby.h"
+#include "output.h"
+#include "watch.h"
+#include "publish.h"
+#include "busyperiod.h"
+#include "loader.h"
+#include "profile.h"
+#include "engines.h"
+#include "schema.h"
+#include "sjf.h"
+#include "admission.h"
+#include "capacity.h"
+#include "autoscale.h"
+#include "dispatch.h"
+#include "backfill.h"
+#include "gang.h"
+#include "topology.h"
+#include "balance.h"
+#include "eevdf.h"
+#include "bandwidth.h"
+#include "o1.h"
+#include "cbs.h"
+#include "closedloop.h"
 
 /**
- * @brief Represents a process with its attributes.
+ * @brief Command-line options shared by every report.
  */
 typedef struct {
-    int id;          ///< Unique identifier for the process.
-    int arrival;     ///< Arrival time of the process.
-    int burst;       ///< Total burst time required by the process.
-    int remaining;   ///< Remaining burst time of the process.
-    int start_time;  ///< Start time of the process execution. 
-    int finish_time; ///< Finish time of the process execution.
-} Process;
+    const char *query_file; ///< Range query file, or NULL.
+    int by_class;           ///< Non-zero to print the per-class breakdown.
+    int threads;            ///< Worker threads for parallel passes.
+    OutputFormat format;    ///< Format of the aggregate metrics.
+    const char *dump_file;  ///< Per-process dump file, or NULL.
+    DumpFormat dump_format; ///< Format of the per-process dump.
+    BufferedWriter dump;    ///< Writer of the per-process dump.
+    Publisher *publisher;   ///< Shared-memory publisher, or NULL.
+    int busy_periods;       ///< Non-zero to schedule busy periods in parallel.
+    int quantum;            ///< RR time quantum.
+    RREngine rr_engine;     ///< RR engine requested with --engine.
+    int sjf;                ///< Non-zero to add oracle and predicted SJF.
+    double alpha;           ///< Smoothing factor of the burst predictions.
+    AdmissionPolicy admission; ///< Admission rules for the extra RR run, if any.
+    AutoscalePolicy autoscale; ///< Scaling policy of the elastic RR run, if max_cpus > 0.
+    DispatchConfig dispatch;   ///< Servers of the dispatched run, if servers > 0.
+    int cores;                 ///< Cores of the EASY backfilling run, if > 0.
+    GangConfig gang;           ///< Matrix of the gang-scheduled run, if cpus > 0.
+    const char *topology_file; ///< Topology of the placement comparison, or NULL.
+    int balance;               ///< Non-zero to compare balancing modes on the topology.
+    int eevdf;                 ///< Non-zero to add EEVDF and compare latencies with FCFS and RR.
+    const char *bandwidth_file; ///< Group bandwidth limits of the throttling run, or NULL.
+    GroupPolicy group_policy;   ///< Scheduling within each group of the throttling run.
+    int o1;                     ///< Non-zero to add the O(1) scheduler and time its decisions.
+    const char *cbs_file;       ///< Servers of the reserved groups, or NULL.
+} Options;
 
 /**
- * @brief Reads process information from a file.
+ * @brief Reports the metrics of a completed schedule and the optional extras.
  *
- * @param filename The name of the file containing process data.
- * @param processes An array of Process structures to store the read data.
- * @return The number of processes read from the file.
- *
- * @details
- * The function opens the specified file, skips the header line, and reads process data
- * in the format "id arrival burst" from each subsequent line.  It populates the
- * processes array with the read data.  Error handling is included for file opening.
- * The remaining field is initialized to the burst time, and start_time and
- * finish_time are initialized to -1.
+ * @param algorithm Short algorithm name ("fcfs", "rr", ...).
+ * @param quantum The time quantum, or 0 for non-preemptive algorithms.
+ * @param processes An array of Process structures with start and finish times set.
+ * @param n The number of processes in the array.
+ * @param options The command-line options.
+ * @return The average turnaround time.
  */
-int readProcesses(const char *filename, Process processes[]) {
-    FILE *file = fopen(filename, "r");
-    if (!file) {
-        perror("Error opening file");
-        exit(EXIT_FAILURE);
-    }
-
-    char line[256];
-    fgets(line, sizeof(line), file); // Skip header
-    int count = 0;
-
-    while (fgets(line, sizeof(line), file)) {
-        int id, arrival, burst;
-        if (sscanf(line, "%d %d %d", &id, &arrival, &burst) == 3) {
-            processes[count].id = id;
-            processes[count].arrival = arrival;
-            processes[count].burst = burst;
-            processes[count].remaining = burst;
-            processes[count].start_time;
-            processes[count].finish_time;
-            count++;
-        }
+static float reportSchedule(const char *algorithm, int quantum, Process processes[], int n, Options *options) {
+    float tat, rt, throughput;
+    ClassMetrics classes[MAX_CLASSES];
+    calculateMetrics(processes, n, &tat, &rt, &throughput);
+    if (options->by_class)
+        calculateClassMetrics(processes, n, options->threads, classes);
+
+    writeMetrics(stdout, options->format, algorithm, quantum, n, tat, rt, throughput,
+                 options->by_class ? classes : NULL);
+
+    if (options->query_file) {
+        RangeIndex index;
+        buildRangeIndex(processes, n, &index);
+        printf("\n");
+        runRangeQueries(options->query_file, processes, &index, stdout);
+        freeRangeIndex(&index);
     }
 
-    fclose(file);
-    return count;
-}
+    if (options->dump_file)
+        dumpSchedule(&options->dump, options->dump_format, algorithm, processes, n);
 
+    if (options->publisher) {
+        publishMetrics(options->publisher, algorithm, quantum, n, tat, rt, throughput);
+        publishCompletionCurve(options->publisher, algorithm, processes, n);
+    }
+    return tat;
+}
 
 /**
- * @brief Computes the First-Come, First-Served (FCFS) scheduling algorithm.
- *
- * @param processes An array of Process structures.
- * @param n The number of processes in the array.
- *
- * @details
- * This function implements the FCFS scheduling algorithm. It iterates through the
- * processes in the order they appear in the array and calculates the start and finish
- * times for each process based on the current time.
+ * @brief Clears the schedule of every process before the next algorithm runs.
  */
-void computeFCFS(Process processes[], int n) {
-    int current_time = 0;
+static void resetSchedule(Process processes[], int n) {
     for (int i = 0; i < n; i++) {
-        if (processes[i].arrival > current_time)
-            current_time = processes[i].arrival;
-        processes[i].start_time = current_time;
-        processes[i].finish_time = current_time + processes[i].burst;
-        current_time = processes[i].finish_time;
+        processes[i].start_time = -1;
+        processes[i].finish_time = -1;
+        processes[i].remaining = processes[i].burst;
     }
 }
 
 /**
- * @brief Computes the Round Robin (RR) scheduling algorithm.
+ * @brief Adapts computeFCFS to the ScheduleEngine signature.
+ */
+static void engineFCFS(Process processes[], int n, int quantum) {
+    (void)quantum;
+    computeFCFS(processes, n);
+}
+
+/**
+ * @brief Adapts computeSJF to the ScheduleEngine signature.
+ */
+static void engineSJF(Process processes[], int n, int quantum) {
+    (void)quantum;
+    computeSJF(processes, n);
+}
+
+/**
+ * @brief Runs an engine on the whole trace, or busy period by busy period.
+ */
+static void runEngine(ScheduleEngine engine, Process processes[], int n, int quantum, const Options *options) {
+    if (!options->busy_periods || n == 0) {
+        engine(processes, n, quantum);
+        return;
+    }
+    int periods = computeByBusyPeriods(processes, n, quantum, options->threads, engine);
+    fprintf(stderr, "Scheduled %d busy periods on %d threads\n", periods, options->threads);
+}
+
+/**
+ * @brief Main function of the program.
  *
- * @param processes An array of Process structures.
- * @param n The number of processes in the array.
- * @param quantum The time quantum for the RR algorithm.
+ * @param argc The number of command-line arguments.
+ * @param argv An array of strings representing the command-line arguments.
+ * @return An integer indicating the exit status of the program.
  *
  * @details
- * This function implements the RR scheduling algorithm. It uses a queue to manage
- * the processes and simulates the execution of each process for a time quantum.
- * It calculates the start and finish times for each process.
+ * This function reads process data from a file specified as a command-line argument,
+ * computes the FCFS and RR scheduling algorithms, and prints the performance metrics
+ * for each algorithm.  Options:
+ *  - -q, --queries FILE: answer the range queries in FILE after each algorithm.
+ *  - -c, --by-class: break the metrics down by job class.
+ *  - -t, --threads N: number of worker threads for parallel passes (default 1).
+ *  - -f, --format text|json|csv: format of the aggregate metrics (default text).
+ *  - -d, --dump FILE: write every process's start and finish times to FILE ("-" for stdout).
+ *  - --dump-format csv|bin|arrow: format of the dump (default csv).
+ *  - -w, --watch: follow the file as it grows and refresh the metrics on every append.
+ *  - -p, --publish NAME: publish the metrics to the POSIX shared-memory segment NAME.
+ *  - --read-shm NAME: print the snapshot currently published in NAME and exit.
+ *  - -b, --busy-periods: schedule the independent busy periods concurrently (see -t).
+ *  - --loader stdio|pread|uring: how the trace is read (default uring, which falls
+ *    back to pread without io_uring support).
+ *  - --bench-load: time every loader on the trace, check they agree and exit.
+ *  - -s, --stats: print the trace profile computed while validating the trace.
+ *  - -Q, --quantum N: RR time quantum (default 1).
+ *  - -e, --engine auto|tick|event|closed|parallel: RR implementation (default auto,
+ *    chosen from the trace profile; the choice is logged on stderr).
+ *  - -S, --sjf: also run SJF with the true bursts and SJF with bursts predicted by a
+ *    per-class exponential average, and report what the predictions cost.
+ *  - --alpha A: weight of the latest burst in the prediction (default 0.5).
+ *  - --max-queue N, --max-wait W, --deadlines: also run RR under admission control,
+ *    turning away arrivals while N processes are in the system, while the admitted
+ *    work exceeds W, or when they are predicted to miss their deadline column.
+ *  - --defer: retry processes over the cap or the threshold later instead of dropping them.
+ *  - --plan SLO: print the fewest CPUs that keep the latency percentile below SLO and exit;
+ *    --plan-percentile P (default 99), --plan-metric response|turnaround (default
+ *    response) and --plan-policy fcfs|rr (default rr, with -Q) describe the objective
+ *    and the system, -t the candidate CPU counts simulated at once.
+ *  - --autoscale MIN:MAX: also run RR on a shared queue served by MIN to MAX CPUs
+ *    that follow the queue length, and report the CPU time paid for; --scale-up N,
+ *    --scale-down N, --provision-delay D and --cooldown C tune the policy.
+ *  - --servers M: also spread the trace over M independent servers; --dispatch
+ *    random|rr|jsq|pod (default jsq) picks the server of each arrival, --choices D
+ *    the servers sampled by pod (default 2), --server-policy fcfs|rr (default rr,
+ *    with -Q) the local scheduling and --seed S the random stream.
+ *  - --cores K: also run FCFS with EASY backfilling on a K-core machine, each process
+ *    holding the cores of its cores column (default 1) for its whole burst.
+ *  - --gang K: also gang schedule the trace on K CPUs, each process running as many
+ *    threads as its cores column; --gang-rows L sets the time slices of the matrix
+ *    (default 4) and -Q their length.
+ *  - --topology FILE: also run RR on the cores of the machine described in FILE
+ *    (see loadTopology), once with naive and once with affinity-aware placement,
+ *    and compare their migrations.
+ *  - --balance: with --topology, also run RR on per-CPU run queues, once with periodic
+ *    load balancing per domain level and once with idle-time stealing.
+ *  - --eevdf: also run EEVDF with -Q as the base slice and each process's weight column
+ *    (default 1) as its share, and compare the latency distributions of FCFS, RR and EEVDF.
+ *  - --bandwidth FILE: also run RR among the groups of the group column, first without
+ *    limits and then under the CPU quota and period of each group in FILE (see
+ *    loadBandwidth), and report the throttling and its cost in latency; --group-policy
+ *    rr|fair (default rr) shares each group's turns among its processes in turn or by
+ *    their weight column.
+ *  - --o1: also run the Linux 2.6 O(1) scheduler, with the priority column as the nice
+ *    value and -Q as the nice-0 time slice, and compare its cost per decision with RR's.
+ *  - --cbs FILE: also reserve CPU for the groups listed in FILE, in the --bandwidth
+ *    format without a "default" line, each served by a constant bandwidth server of that
+ *    budget and period under EDF, while the other processes share the rest under RR
+ *    (-Q); report the reserved and the best-effort processes apart.
+ *  - --users N|MIN:MAX[:STEP]: instead of replaying the arrivals, run a closed loop of N
+ *    users on one RR CPU (-Q), each submitting a job with the next burst of the trace,
+ *    waiting for it and thinking before the next; print throughput and response time
+ *    for every population from MIN to MAX and exit.  --think Z sets the mean of the
+ *    exponential think time (default 10), --closed-jobs J the completions per run
+ *    (default 10000), --seed S the think times and -t the populations run at once.
  */
-void computeRR(Process processes[], int n, int quantum) {
-    int *remaining = malloc(n * sizeof(int));
-    int *start_time = malloc(n * sizeof(int));
-    int *finish_time = malloc(n * sizeof(int));
-    
-    for (int i = 0; i < n; i++) {
-        remaining[i] = processes[i].burst;
-        start_time[i] = -1;
-        finish_time[i] = -1;
+int main(int argc, char *argv[]) {
+    enum { OPT_DUMP_FORMAT = 256, OPT_READ_SHM, OPT_LOADER, OPT_BENCH_LOAD, OPT_ALPHA,
+           OPT_MAX_QUEUE, OPT_MAX_WAIT, OPT_DEADLINES, OPT_DEFER,
+           OPT_PLAN, OPT_PLAN_PERCENTILE, OPT_PLAN_METRIC, OPT_PLAN_POLICY,
+           OPT_AUTOSCALE, OPT_SCALE_UP, OPT_SCALE_DOWN, OPT_PROVISION_DELAY, OPT_COOLDOWN,
+           OPT_SERVERS, OPT_DISPATCH, OPT_CHOICES, OPT_SERVER_POLICY, OPT_SEED, OPT_CORES,
+           OPT_GANG, OPT_GANG_ROWS, OPT_TOPOLOGY, OPT_BALANCE, OPT_EEVDF,
+           OPT_BANDWIDTH, OPT_GROUP_POLICY, OPT_O1, OPT_CBS,
+           OPT_USERS, OPT_THINK, OPT_CLOSED_JOBS };
+    static const struct option long_options[] = {
+        {"queries", required_argument, NULL, 'q'},
+        {"by-class", no_argument, NULL, 'c'},
+        {"threads", required_argument, NULL, 't'},
+        {"format", required_argument, NULL, 'f'},
+        {"dump", required_argument, NULL, 'd'},
+        {"dump-format", required_argument, NULL, OPT_DUMP_FORMAT},
+        {"watch", no_argument, NULL, 'w'},
+        {"publish", required_argument, NULL, 'p'},
+        {"read-shm", required_argument, NULL, OPT_READ_SHM},
+        {"busy-periods", no_argument, NULL, 'b'},
+        {"loader", required_argument, NULL, OPT_LOADER},
+        {"bench-load", no_argument, NULL, OPT_BENCH_LOAD},
+        {"stats", no_argument, NULL, 's'},
+        {"quantum", required_argument, NULL, 'Q'},
+        {"engine", required_argument, NULL, 'e'},
+        {"sjf", no_argument, NULL, 'S'},
+        {"alpha", required_argument, NULL, OPT_ALPHA},
+        {"max-queue", required_argument, NULL, OPT_MAX_QUEUE},
+        {"max-wait", required_argument, NULL, OPT_MAX_WAIT},
+        {"deadlines", no_argument, NULL, OPT_DEADLINES},
+        {"defer", no_argument, NULL, OPT_DEFER},
+        {"plan", required_argument, NULL, OPT_PLAN},
+        {"plan-percentile", required_argument, NULL, OPT_PLAN_PERCENTILE},
+        {"plan-metric", required_argument, NULL, OPT_PLAN_METRIC},
+        {"plan-policy", required_argument, NULL, OPT_PLAN_POLICY},
+        {"autoscale", required_argument, NULL, OPT_AUTOSCALE},
+        {"scale-up", required_argument, NULL, OPT_SCALE_UP},
+        {"scale-down", required_argument, NULL, OPT_SCALE_DOWN},
+        {"provision-delay", required_argument, NULL, OPT_PROVISION_DELAY},
+        {"cooldown", required_argument, NULL, OPT_COOLDOWN},
+        {"servers", required_argument, NULL, OPT_SERVERS},
+        {"dispatch", required_argument, NULL, OPT_DISPATCH},
+        {"choices", required_argument, NULL, OPT_CHOICES},
+        {"server-policy", required_argument, NULL, OPT_SERVER_POLICY},
+        {"seed", required_argument, NULL, OPT_SEED},
+        {"cores", required_argument, NULL, OPT_CORES},
+        {"gang", required_argument, NULL, OPT_GANG},
+        {"gang-rows", required_argument, NULL, OPT_GANG_ROWS},
+        {"topology", required_argument, NULL, OPT_TOPOLOGY},
+        {"balance", no_argument, NULL, OPT_BALANCE},
+        {"eevdf", no_argument, NULL, OPT_EEVDF},
+        {"bandwidth", required_argument, NULL, OPT_BANDWIDTH},
+        {"group-policy", required_argument, NULL, OPT_GROUP_POLICY},
+        {"o1", no_argument, NULL, OPT_O1},
+        {"cbs", required_argument, NULL, OPT_CBS},
+        {"users", required_argument, NULL, OPT_USERS},
+        {"think", required_argument, NULL, OPT_THINK},
+        {"closed-jobs", required_argument, NULL, OPT_CLOSED_JOBS},
+        {NULL, 0, NULL, 0}
+    };
+    Options options = {0};
+    const char *publish_name = NULL;
+    Publisher publisher;
+    LoaderKind loader = LOADER_URING;
+    CapacityQuery plan = {0};
+    ClosedLoopConfig closed = {0};
+    int opt, usage_error = 0, watch = 0, bench_load = 0, stats = 0;
+    options.threads = 1;
+    options.quantum = 1;
+    options.alpha = SJF_DEFAULT_ALPHA;
+    plan.percentile = 99;
+    options.autoscale.scale_up_queue = AUTOSCALE_SCALE_UP;
+    options.autoscale.scale_down_queue = AUTOSCALE_SCALE_DOWN;
+    options.autoscale.provision_delay = AUTOSCALE_DELAY;
+    options.autoscale.cooldown = AUTOSCALE_COOLDOWN;
+    options.dispatch.policy = DISPATCH_JSQ;
+    options.dispatch.choices = DISPATCH_DEFAULT_CHOICES;
+    options.dispatch.local = MULTI_RR;
+    options.dispatch.seed = DISPATCH_DEFAULT_SEED;
+    plan.policy = MULTI_RR;
+    options.gang.rows = GANG_DEFAULT_ROWS;
+    closed.step = 1;
+    closed.think = CLOSED_THINK;
+    closed.jobs = CLOSED_JOBS;
+
+    while ((opt = getopt_long(argc, argv, "q:ct:f:d:wp:bsQ:e:S", long_options, NULL)) != -1) {
+        switch (opt) {
+        case 'q':
+            options.query_file = optarg;
+            break;
+        case 'c':
+            options.by_class = 1;
+            break;
+        case 't':
+            options.threads = atoi(optarg);
+            usage_error |= options.threads < 1;
+            break;
+        case 'f':
+            usage_error |= parseOutputFormat(optarg, &options.format) != 0;
+            break;
+        case 'd':
+            options.dump_file = optarg;
+            break;
+        case OPT_DUMP_FORMAT:
+            usage_error |= parseDumpFormat(optarg, &options.dump_format) != 0;
+            break;
+        case 'w':
+            watch = 1;
+            break;
+        case 'p':
+            publish_name = optarg;
+            break;
+        case OPT_READ_SHM:
+            return printPublished(optarg);
+        case 'b':
+            options.busy_periods = 1;
+            break;
+        case OPT_LOADER:
+            usage_error |= parseLoaderKind(optarg, &loader) != 0;
+            break;
+        case OPT_BENCH_LOAD:
+            bench_load = 1;
+            break;
+        case 's':
+            stats = 1;
+            break;
+        case 'Q':
+            options.quantum = atoi(optarg);
+            usage_error |= options.quantum < 1;
+            break;
+        case 'e':
+            usage_error |= parseRREngine(optarg, &options.rr_engine) != 0;
+            break;
+        case 'S':
+            options.sjf = 1;
+            break;
+        case OPT_ALPHA:
+            options.alpha = atof(optarg);
+            usage_error |= options.alpha <= 0 || options.alpha > 1;
+            break;
+        case OPT_MAX_QUEUE:
+            options.admission.max_in_system = atoi(optarg);
+            usage_error |= options.admission.max_in_system < 1;
+            break;
+        case OPT_MAX_WAIT:
+            options.admission.max_wait = atoll(optarg);
+            usage_error |= options.admission.max_wait < 1;
+            break;
+        case OPT_DEADLINES:
+            options.admission.deadlines = 1;
+            break;
+        case OPT_DEFER:
+            options.admission.action = ADMIT_DEFER;
+            break;
+        case OPT_PLAN:
+            plan.slo = atoll(optarg);
+            usage_error |= plan.slo < 1;
+            break;
+        case OPT_PLAN_PERCENTILE:
+            plan.percentile = atof(optarg);
+            usage_error |= plan.percentile <= 0 || plan.percentile > 100;
+            break;
+        case OPT_PLAN_METRIC:
+            if (strcmp(optarg, "turnaround") == 0)
+                plan.turnaround = 1;
+            else
+                usage_error |= strcmp(optarg, "response") != 0;
+            break;
+        case OPT_PLAN_POLICY:
+            usage_error |= parseMultiPolicy(optarg, &plan.policy) != 0;
+            break;
+        case OPT_AUTOSCALE:
+            usage_error |= sscanf(optarg, "%d:%d", &options.autoscale.min_cpus, &options.autoscale.max_cpus) != 2 ||
+                           options.autoscale.min_cpus < 1 || options.autoscale.max_cpus < options.autoscale.min_cpus;
+            break;
+        case OPT_SCALE_UP:
+            options.autoscale.scale_up_queue = atoi(optarg);
+            usage_error |= options.autoscale.scale_up_queue < 0;
+            break;
+        case OPT_SCALE_DOWN:
+            options.autoscale.scale_down_queue = atoi(optarg);
+            usage_error |= options.autoscale.scale_down_queue < 0;
+            break;
+        case OPT_PROVISION_DELAY:
+            options.autoscale.provision_delay = atoi(optarg);
+            usage_error |= options.autoscale.provision_delay < 0;
+            break;
+        case OPT_COOLDOWN:
+            options.autoscale.cooldown = atoi(optarg);
+            usage_error |= options.autoscale.cooldown < 0;
+            break;
+        case OPT_SERVERS:
+            options.dispatch.servers = atoi(optarg);
+            usage_error |= options.dispatch.servers < 1;
+            break;
+        case OPT_DISPATCH:
+            usage_error |= parseDispatchPolicy(optarg, &options.dispatch.policy) != 0;
+            break;
+        case OPT_CHOICES:
+            options.dispatch.choices = atoi(optarg);
+            usage_error |= options.dispatch.choices < 1;
+            break;
+        case OPT_SERVER_POLICY:
+            usage_error |= parseMultiPolicy(optarg, &options.dispatch.local) != 0;
+            break;
+        case OPT_SEED:
+            options.dispatch.seed = strtoull(optarg, NULL, 10);
+            break;
+        case OPT_CORES:
+            options.cores = atoi(optarg);
+            usage_error |= options.cores < 1;
+            break;
+        case OPT_GANG:
+            options.gang.cpus = atoi(optarg);
+            usage_error |= options.gang.cpus < 1;
+            break;
+        case OPT_GANG_ROWS:
+            options.gang.rows = atoi(optarg);
+            usage_error |= options.gang.rows < 1;
+            break;
+        case OPT_TOPOLOGY:
+            options.topology_file = optarg;
+            break;
+        case OPT_BALANCE:
+            options.balance = 1;
+            break;
+        case OPT_EEVDF:
+            options.eevdf = 1;
+            break;
+        case OPT_BANDWIDTH:
+            options.bandwidth_file = optarg;
+            break;
+        case OPT_GROUP_POLICY:
+            if (strcmp(optarg, "rr") == 0)
+                options.group_policy = GROUP_RR;
+            else if (strcmp(optarg, "fair") == 0)
+                options.group_policy = GROUP_FAIR;
+            else
+                usage_error = 1;
+            break;
+        case OPT_O1:
+            options.o1 = 1;
+            break;
+        case OPT_CBS:
+            options.cbs_file = optarg;
+            break;
+        case OPT_USERS: {
+            int fields = sscanf(optarg, "%d:%d:%d", &closed.min_users, &closed.max_users, &closed.step);
+            if (fields == 1)
+                closed.max_users = closed.min_users;
+            usage_error |= fields < 1 || closed.min_users < 1 || closed.max_users < closed.min_users ||
+                           closed.step < 1;
+            break;
+        }
+        case OPT_THINK:
+            closed.think = atof(optarg);
+            usage_error |= closed.think < 0;
+            break;
+        case OPT_CLOSED_JOBS:
+            closed.jobs = atoll(optarg);
+            usage_error |= closed.jobs < 1;
+            break;
+        default:
+            usage_error = 1;
+            break;
+        }
     }
 
-    int queue[1000], front = 0, rear = -1, size = 0;
-    int current_time = 0, idx = 0, completed = 0;
+    usage_error |= options.balance && !options.topology_file;
+    // Range query answers are free-form text and would corrupt a JSON/CSV document.
+    usage_error |= options.query_file && options.format != FORMAT_TEXT;
+    // Watch mode refreshes aggregate metrics only, as text lines or CSV rows.
+    usage_error |= watch && (options.format == FORMAT_JSON || options.query_file ||
+                             options.by_class || options.dump_file);
 
-    while (idx < n && processes[idx].arrival <= current_time) {
-        queue[++rear] = idx++;
-        size++;
+    if (usage_error || optind != argc - 1) {
+        fprintf(stderr, "Usage: %s [-q query_file] [-c] [-t threads] [-f text|json|csv]\n"
+                        "       [-d dump_file] [--dump-format csv|bin|arrow] [-w] [-p shm_name] [-b]\n"
+                        "       [--loader stdio|pread|uring] [--bench-load] [-s]\n"
+                        "       [-Q quantum] [-e auto|tick|event|closed|parallel] [-S] [--alpha A]\n"
+                        "       [--max-queue N] [--max-wait W] [--deadlines] [--defer]\n"
+                        "       [--plan SLO [--plan-percentile P] [--plan-metric response|turnaround]\n"
+                        "        [--plan-policy fcfs|rr]] [--autoscale MIN:MAX [--scale-up N]\n"
+                        "        [--scale-down N] [--provision-delay D] [--cooldown C]]\n"
+                        "       [--servers M [--dispatch random|rr|jsq|pod] [--choices D]\n"
+                        "        [--server-policy fcfs|rr] [--seed S]] [--cores K]\n"
+                        "       [--gang K [--gang-rows L]] [--topology FILE [--balance]]\n"
+                        "       [--eevdf] [--bandwidth FILE [--group-policy rr|fair]] [--o1]\n"
+                        "       [--cbs FILE] [--users N|MIN:MAX[:STEP] [--think Z] [--closed-jobs J]]\n"
+                        "       <process_file>\n"
+                        "       %s --read-shm shm_name\n", argv[0], argv[0]);
+        return EXIT_FAILURE;
     }
 
-    while (completed < n) {
-        if (size == 0) {
-            current_time++;
-            while (idx < n && processes[idx].arrival <= current_time) {
-                queue[++rear] = idx++;
-                size++;
-            }
-            continue;
-        }
+    // Only the columns this run looks at are converted while loading.
+    unsigned fields = FIELDS_REQUIRED | (options.by_class || options.sjf ? FIELD_BIT(FIELD_CLASS) : 0) |
+                      (admissionEnabled(&options.admission) ? FIELD_BIT(FIELD_DEADLINE) : 0) |
+                      (options.cores > 0 || options.gang.cpus > 0 ? FIELD_BIT(FIELD_CORES) : 0) |
+                      (options.eevdf || (options.bandwidth_file && options.group_policy == GROUP_FAIR) ?
+                       FIELD_BIT(FIELD_WEIGHT) : 0) |
+                      (options.bandwidth_file || options.cbs_file ? FIELD_BIT(FIELD_GROUP) : 0) |
+                      (options.o1 ? FIELD_BIT(FIELD_PRIORITY) : 0);
 
-        int proc_idx = queue[front++];
-        size--;
+    if (bench_load)
+        return benchmarkLoaders(argv[optind], fields);
 
-        if (start_time[proc_idx] == -1)
-            start_time[proc_idx] = current_time;
+    if (publish_name) {
+        openPublisher(&publisher, publish_name);
+        options.publisher = &publisher;
+    }
 
-        int exec_time = (remaining[proc_idx] < quantum) ? remaining[proc_idx] : quantum;
-        remaining[proc_idx] -= exec_time;
-        current_time += exec_time;
+    if (watch)
+        return watchTrace(argv[optind], options.quantum, options.format, options.publisher);
 
-        while (idx < n && processes[idx].arrival <= current_time) {
-            queue[++rear] = idx++;
-            size++;
-        }
+    Process *processes;
+    int n = loadProcesses(argv[optind], &processes, loader, fields);
 
-        if (remaining[proc_idx] > 0) {
-            queue[++rear] = proc_idx;
-            size++;
-        } else {
-            finish_time[proc_idx] = current_time;
-            completed++;
-        }
+    TraceProfile profile;
+    profileTrace(processes, n, &profile);
+    validateTrace(processes, n, &profile);
+    if (stats)
+        printTraceProfile(&profile, options.format == FORMAT_TEXT ? stdout : stderr);
+
+    if (plan.slo > 0) {
+        plan.quantum = options.quantum;
+        plan.threads = options.threads;
+        int cpus = planCapacity(processes, n, &plan, stdout);
+        free(processes);
+        return cpus >= 0 ? EXIT_SUCCESS : EXIT_FAILURE;
     }
 
-    for (int i = 0; i < n; i++) {
-        processes[i].start_time = start_time[i];
-        processes[i].finish_time = finish_time[i];
+    if (closed.min_users > 0) {
+        closed.quantum = options.quantum;
+        closed.threads = options.threads;
+        closed.seed = options.dispatch.seed;
+        sweepClosedLoop(processes, n, &closed, stdout);
+        free(processes);
+        return EXIT_SUCCESS;
     }
 
+    if (options.dump_file) {
+        writerOpen(&options.dump, options.dump_file);
+        dumpBegin(&options.dump, options.dump_format);
+    }
+    writeMetricsBegin(stdout, options.format);
 
-    free(remaining);
-    free(start_time);
-    free(finish_time);
-}
+    // Latency distributions kept for the EEVDF comparison.
+    LatencySummary latency[3];
 
-/**
- * @brief Calculates performance metrics for the scheduling algorithms.
- *
- * @param processes An array of Process structures.
- * @param n The number of processes in the array.
- * @param avg_tat A pointer to a float variable to store the average turnaround time.
- * @param avg_rt A pointer to a float variable to store the average response time.
- * @param throughput A pointer to a float variable to store the throughput.
- *f
- * @details
- * This function calculates the average turnaround time, average response time, and
- * throughput based on the start and finish times of the processes.
- */
-void calculateMetrics(Process processes[], int n, float *avg_tat, float *avg_rt, float *throughput) {
-    float total_tat = 0, total_rt = 0;
-    int max_finish = 0;
+    // FCFS
+    runEngine(engineFCFS, processes, n, 0, &options);
+    reportSchedule("fcfs", 0, processes, n, &options);
+    if (options.eevdf)
+        summarizeLatency(processes, n, &latency[0]);
 
-    for (int i = 0; i < n; i++) {
-        int tat = processes[i].finish_time - processes[i].arrival; //Turnaround Time
-        int rt = processes[i].start_time - processes[i].arrival; //Response Time
-        total_tat += tat;
-        total_rt += rt;
-        if (processes[i].finish_time > max_finish)
-            max_finish = processes[i].finish_time;
+    // RR
+    resetSchedule(processes, n);
+    const char *reason;
+    RREngine rr_engine = selectRREngine(&profile, options.quantum, options.threads, options.rr_engine, &reason);
+    fprintf(stderr, "RR engine: %s (%s)\n", rrEngineName(rr_engine), reason);
+    if (rr_engine == RR_ENGINE_PARALLEL)
+        options.busy_periods = 1;
+    runEngine(rr_engine == RR_ENGINE_TICK ? computeRR :
+              rr_engine == RR_ENGINE_CLOSED ? computeRRClosedForm : computeRREvent,
+              processes, n, options.quantum, &options);
+    reportSchedule("rr", options.quantum, processes, n, &options);
+    if (options.eevdf)
+        summarizeLatency(processes, n, &latency[1]);
+
+    // RR under admission control; the metrics cover the admitted processes only.
+    if (admissionEnabled(&options.admission)) {
+        AdmissionStats admission;
+        resetSchedule(processes, n);
+        computeRRAdmission(processes, n, options.quantum, &options.admission, &admission);
+        Process *admitted = malloc((admission.admitted ? admission.admitted : 1) * sizeof(Process));
+        if (!admitted) {
+            perror("Error allocating admitted processes");
+            exit(EXIT_FAILURE);
+        }
+        int count = 0;
+        for (int i = 0; i < n; i++)
+            if (processes[i].finish_time >= 0)
+                admitted[count++] = processes[i];
+        if (count > 0)
+            reportSchedule("rr-ac", options.quantum, admitted, count, &options);
+        printAdmissionStats(&admission, options.format == FORMAT_TEXT ? stdout : stderr);
+        free(admitted);
     }
 
-    *avg_tat = total_tat / n; // Total TAT and RT are divided by the number of processes (n) to get the averages.
-    *avg_rt = total_rt / n;
-    *throughput = (float)n / max_finish;
-}
+    // RR on an elastic pool of CPUs.
+    if (options.autoscale.max_cpus > 0) {
+        AutoscaleStats scaling;
+        resetSchedule(processes, n);
+        computeAutoscaledRR(processes, n, options.quantum, &options.autoscale, &scaling);
+        reportSchedule("elastic", options.quantum, processes, n, &options);
+        printAutoscaleStats(processes, n, &options.autoscale, &scaling,
+                            options.format == FORMAT_TEXT ? stdout : stderr);
+    }
 
-/**
- * @brief Main function of the program.
- *
- * @param argc The number of command-line arguments.
- * @param argv An array of strings representing the command-line arguments.
- * @return An integer indicating the exit status of the program.
- *
- * @details
- * This function reads process data from a file specified as a command-line argument,
- * computes the FCFS and RR scheduling algorithms, and prints the performance metrics
- * for each algorithm.
- */
-int main(int argc, char *argv[]) {
-    if (argc < 2) {
-        fprintf(stderr, "Usage: %s <process_file>\n", argv[0]);
-        return EXIT_FAILURE;
+    // A dispatcher in front of independent servers.
+    if (options.dispatch.servers > 0) {
+        DispatchStats spread;
+        options.dispatch.quantum = options.quantum;
+        resetSchedule(processes, n);
+        computeDispatched(processes, n, &options.dispatch, &spread);
+        reportSchedule("dispatch", options.dispatch.local == MULTI_RR ? options.quantum : 0, processes, n, &options);
+        printDispatchStats(&options.dispatch, &spread, options.format == FORMAT_TEXT ? stdout : stderr);
     }
 
-    Process processes[100];
-    int n = readProcesses(argv[1], processes);
+    // FCFS with EASY backfilling on a machine with several cores.
+    if (options.cores > 0) {
+        BackfillStats backfill;
+        resetSchedule(processes, n);
+        computeEASY(processes, n, options.cores, &backfill);
+        reportSchedule("easy", 0, processes, n, &options);
+        printBackfillStats(options.cores, n, &backfill, options.format == FORMAT_TEXT ? stdout : stderr);
+    }
 
-    // FCFS
-    computeFCFS(processes, n);
-    float fcfs_tat, fcfs_rt, fcfs_throughput;
-    calculateMetrics(processes, n, &fcfs_tat, &fcfs_rt, &fcfs_throughput);
+    // Gang scheduling of parallel processes.
+    if (options.gang.cpus > 0) {
+        GangStats gang;
+        options.gang.quantum = options.quantum;
+        resetSchedule(processes, n);
+        computeGang(processes, n, &options.gang, &gang);
+        reportSchedule("gang", options.quantum, processes, n, &options);
+        printGangStats(&options.gang, &gang, options.format == FORMAT_TEXT ? stdout : stderr);
+    }
 
-    // Reset for RR
-    for (int i = 0; i < n; i++) {
-        processes[i].start_time;
-        processes[i].finish_time;
-        processes[i].remaining = processes[i].burst;
+    // RR on a cache and NUMA topology, with naive and then affinity-aware placement.
+    if (options.topology_file) {
+        Topology topology;
+        TopologyStats naive, affinity;
+        loadTopology(options.topology_file, &topology);
+        resetSchedule(processes, n);
+        computeTopologyRR(processes, n, options.quantum, &topology, PLACE_NAIVE, &naive);
+        reportSchedule("topo-naive", options.quantum, processes, n, &options);
+        resetSchedule(processes, n);
+        computeTopologyRR(processes, n, options.quantum, &topology, PLACE_AFFINITY, &affinity);
+        reportSchedule("topo-affinity", options.quantum, processes, n, &options);
+        printTopologyStats(&topology, &naive, &affinity, options.format == FORMAT_TEXT ? stdout : stderr);
+
+        if (options.balance) {
+            BalanceStats periodic, steal;
+            resetSchedule(processes, n);
+            computeBalancedRR(processes, n, options.quantum, &topology, BALANCE_PERIODIC, &periodic);
+            reportSchedule("lb-periodic", options.quantum, processes, n, &options);
+            resetSchedule(processes, n);
+            computeBalancedRR(processes, n, options.quantum, &topology, BALANCE_STEAL, &steal);
+            reportSchedule("lb-steal", options.quantum, processes, n, &options);
+            printBalanceStats(&topology, &periodic, &steal, options.format == FORMAT_TEXT ? stdout : stderr);
+        }
     }
 
-    // RR
-    computeRR(processes, n, 1);
-    float rr_tat, rr_rt, rr_throughput;
-    calculateMetrics(processes, n, &rr_tat, &rr_rt, &rr_throughput);
+    // EEVDF, and its latencies next to those of FCFS and RR.
+    if (options.eevdf) {
+        static const char *const latency_names[] = {"fcfs", "rr", "eevdf"};
+        FILE *out = options.format == FORMAT_TEXT ? stdout : stderr;
+        EEVDFStats eevdf;
+        resetSchedule(processes, n);
+        computeEEVDF(processes, n, options.quantum, &eevdf);
+        reportSchedule("eevdf", options.quantum, processes, n, &options);
+        summarizeLatency(processes, n, &latency[2]);
+        printEEVDFStats(options.quantum, &eevdf, out);
+        fprintf(out, "\nLatency Distribution:\n");
+        printLatencyTable(latency_names, latency, 3, out);
+    }
+
+    // RR among groups, without and then with their CPU bandwidth limits.
+    if (options.bandwidth_file) {
+        BandwidthConfig bandwidth, unlimited;
+        BandwidthStats free_run, throttled;
+        LatencySummary before, after;
+        loadBandwidth(options.bandwidth_file, &bandwidth);
+        bandwidth.policy = options.group_policy;
+        bandwidth.quantum = options.quantum;
+        unlimited = (BandwidthConfig){NULL, 0, {0, 0, 1}, options.group_policy, options.quantum};
+        resetSchedule(processes, n);
+        computeBandwidth(processes, n, &unlimited, &free_run);
+        reportSchedule("groups", options.quantum, processes, n, &options);
+        summarizeLatency(processes, n, &before);
+        resetSchedule(processes, n);
+        computeBandwidth(processes, n, &bandwidth, &throttled);
+        reportSchedule("bandwidth", options.quantum, processes, n, &options);
+        summarizeLatency(processes, n, &after);
+        printBandwidthStats(&bandwidth, &throttled, &before, &after, options.format == FORMAT_TEXT ? stdout : stderr);
+        freeBandwidth(&bandwidth);
+    }
 
-    printf("FCFS Scheduling:\n");
-    printf("Average Turnaround Time: %.2f\n", fcfs_tat);
-    printf("Average Response Time: %.2f\n", fcfs_rt);
-    printf("Throughput: %.2f processes/ut\n\n", fcfs_throughput);
+    // The Linux 2.6 O(1) scheduler, and its cost per decision against RR's.
+    if (options.o1) {
+        O1Stats o1;
+        O1Benchmark bench;
+        resetSchedule(processes, n);
+        computeO1(processes, n, options.quantum, &o1);
+        reportSchedule("o1", options.quantum, processes, n, &options);
+        benchmarkO1(processes, n, options.quantum, &bench);
+        printO1Stats(options.quantum, &o1, &bench, options.format == FORMAT_TEXT ? stdout : stderr);
+    }
 
-    printf("Round Robin Scheduling (Quantum=1):\n");
-    printf("Average Turnaround Time: %.2f\n", rr_tat);
-    printf("Average Response Time: %.2f\n", rr_rt);
-    printf("Throughput: %.2f processes/ut\n", rr_throughput);
+    // Constant bandwidth servers for the reserved groups, best-effort RR for the rest.
+    if (options.cbs_file) {
+        BandwidthConfig servers;
+        CBSStats cbs;
+        loadBandwidth(options.cbs_file, &servers);
+        if (servers.fallback.quota > 0) {
+            // A default server would take in every unlisted group, leaving nothing best effort.
+            fprintf(stderr, "Invalid CBS file %s: servers are per group, \"default\" is not allowed\n",
+                    options.cbs_file);
+            exit(EXIT_FAILURE);
+        }
+        servers.quantum = options.quantum;
+        resetSchedule(processes, n);
+        computeCBS(processes, n, &servers, &cbs);
+        reportSchedule("cbs", options.quantum, processes, n, &options);
+        printCBSStats(processes, n, &servers, &cbs, options.format == FORMAT_TEXT ? stdout : stderr);
+        freeBandwidth(&servers);
+    }
 
+    // SJF with true bursts, then with predicted ones (whose history spans busy periods).
+    if (options.sjf) {
+        PredictionStats prediction;
+        resetSchedule(processes, n);
+        runEngine(engineSJF, processes, n, 0, &options);
+        float oracle_tat = reportSchedule("sjf", 0, processes, n, &options);
+        resetSchedule(processes, n);
+        computeSJFPredicted(processes, n, options.alpha, &prediction);
+        float predicted_tat = reportSchedule("psjf", 0, processes, n, &options);
+        printPredictionImpact(&prediction, oracle_tat, predicted_tat,
+                              options.format == FORMAT_TEXT ? stdout : stderr);
+    }
+
+    writeMetricsEnd(stdout, options.format);
+    if (options.dump_file) {
+        dumpEnd(&options.dump, options.dump_format);
+        writerClose(&options.dump);
+    }
+    if (options.publisher)
+        closePublisher(options.publisher);
+
+    free(processes);
     return 0;
-}
\ No newline at end of file
+}
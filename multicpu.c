@@ -0,0 +1,150 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "multicpu.h"
+#include "heap.h"
+
+/**
+ * @brief Parses a policy name ("fcfs" or "rr").
+ *
+ * @return 0 on success, -1 if the name is unknown.
+ */
+int parseMultiPolicy(const char *name, MultiPolicy *policy) {
+    if (strcmp(name, "fcfs") == 0)
+        *policy = MULTI_FCFS;
+    else if (strcmp(name, "rr") == 0)
+        *policy = MULTI_RR;
+    else
+        return -1;
+    return 0;
+}
+
+/**
+ * @brief Returns the name of a policy.
+ */
+const char *multiPolicyName(MultiPolicy policy) {
+    return policy == MULTI_FCFS ? "fcfs" : "rr";
+}
+
+/**
+ * @brief FCFS on several identical CPUs fed by one queue.
+ *
+ * @param processes An array of Process structures sorted by arrival.
+ * @param n The number of processes in the array.
+ * @param cpus The number of CPUs.
+ *
+ * @details
+ * Processes start in arrival order, each on the CPU that frees up first, found
+ * in a heap of CPU free times: O(log cpus) per process.  With one CPU this is
+ * computeFCFS.
+ */
+void computeMultiFCFS(Process processes[], int n, int cpus) {
+    MinHeap free_at;
+    heapInit(&free_at, cpus);
+    for (int c = 0; c < cpus; c++)
+        heapPush(&free_at, 0, c);
+
+    for (int i = 0; i < n; i++) {
+        HeapItem cpu = heapPop(&free_at);
+        long long start = cpu.key > processes[i].arrival ? cpu.key : processes[i].arrival;
+        processes[i].start_time = (int)start;
+        processes[i].finish_time = (int)(start + processes[i].burst);
+        processes[i].remaining = 0;
+        heapPush(&free_at, processes[i].finish_time, cpu.value);
+    }
+
+    heapFree(&free_at);
+}
+
+/**
+ * @brief Round Robin on several identical CPUs sharing one ready queue.
+ *
+ * @param processes An array of Process structures sorted by arrival.
+ * @param n The number of processes in the array.
+ * @param cpus The number of CPUs.
+ * @param quantum The time quantum.
+ *
+ * @details
+ * Event-driven: the end of every running slice is an event in a heap keyed by
+ * time (ties by CPU number).  At each event time the processes that have
+ * arrived join the queue first, then the processes whose slice just ended are
+ * requeued or retired, then every idle CPU takes the head of the queue.  That
+ * is the order of computeRR, which this reproduces with one CPU.  Each slice
+ * costs O(log cpus) and idle time is skipped.
+ */
+void computeMultiRR(Process processes[], int n, int cpus, int quantum) {
+    int *remaining = malloc(n * sizeof(int));
+    int *queue = malloc(n * sizeof(int));
+    int *running = malloc(cpus * sizeof(int));
+    int *idle = malloc(cpus * sizeof(int));
+    if ((n > 0 && (!remaining || !queue)) || !running || !idle) {
+        perror("Error allocating multi-CPU state");
+        exit(EXIT_FAILURE);
+    }
+    for (int i = 0; i < n; i++) {
+        remaining[i] = processes[i].burst;
+        processes[i].start_time = -1;
+        processes[i].finish_time = -1;
+    }
+    int idle_count = cpus;
+    for (int c = 0; c < cpus; c++)
+        idle[c] = cpus - 1 - c;
+
+    MinHeap slice_end;
+    heapInit(&slice_end, cpus);
+    int front = 0, rear = -1, size = 0, idx = 0, completed = 0;
+
+    while (completed < n) {
+        long long now = slice_end.size > 0 ? slice_end.items[0].key : processes[idx].arrival;
+        if (idx < n && processes[idx].arrival < now)
+            now = processes[idx].arrival;
+
+        while (idx < n && processes[idx].arrival <= now) {
+            rear = (rear + 1) % n;
+            queue[rear] = idx++;
+            size++;
+        }
+        while (slice_end.size > 0 && slice_end.items[0].key == now) {
+            int cpu = heapPop(&slice_end).value;
+            int proc_idx = running[cpu];
+            if (remaining[proc_idx] > 0) {
+                rear = (rear + 1) % n;
+                queue[rear] = proc_idx;
+                size++;
+            } else {
+                processes[proc_idx].finish_time = (int)now;
+                completed++;
+            }
+            idle[idle_count++] = cpu;
+        }
+
+        while (idle_count > 0 && size > 0) {
+            int cpu = idle[--idle_count];
+            int proc_idx = queue[front];
+            front = (front + 1) % n;
+            size--;
+            if (processes[proc_idx].start_time == -1)
+                processes[proc_idx].start_time = (int)now;
+            int exec_time = remaining[proc_idx] < quantum ? remaining[proc_idx] : quantum;
+            remaining[proc_idx] -= exec_time;
+            running[cpu] = proc_idx;
+            heapPush(&slice_end, now + exec_time, cpu);
+        }
+    }
+
+    heapFree(&slice_end);
+    free(idle);
+    free(running);
+    free(queue);
+    free(remaining);
+}
+
+/**
+ * @brief Runs the multi-CPU simulation of a policy.
+ */
+void computeMulti(Process processes[], int n, int cpus, MultiPolicy policy, int quantum) {
+    if (policy == MULTI_FCFS)
+        computeMultiFCFS(processes, n, cpus);
+    else
+        computeMultiRR(processes, n, cpus, quantum);
+}
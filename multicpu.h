@@ -0,0 +1,20 @@
+#ifndef MULTICPU_H
+#define MULTICPU_H
+
+#include "process.h"
+
+/**
+ * @brief Discipline of a global ready queue shared by several CPUs.
+ */
+typedef enum {
+    MULTI_FCFS, ///< Each process runs to completion on the first CPU to free up.
+    MULTI_RR    ///< Round Robin: a preempted process goes to the tail of the shared queue.
+} MultiPolicy;
+
+int parseMultiPolicy(const char *name, MultiPolicy *policy);
+const char *multiPolicyName(MultiPolicy policy);
+void computeMultiFCFS(Process processes[], int n, int cpus);
+void computeMultiRR(Process processes[], int n, int cpus, int quantum);
+void computeMulti(Process processes[], int n, int cpus, MultiPolicy policy, int quantum);
+
+#endif
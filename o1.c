@@ -0,0 +1,330 @@
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+#include "o1.h"
+#include "engines.h"
+
+#define O1_WORDS ((O1_PRIO_LEVELS + 63) / 64)
+#define O1_BENCH_RUNS 3 ///< Timed runs of each engine; the best one counts.
+
+/**
+ * @brief One priority array: a FIFO per priority and a bitmap of the non-empty ones.
+ */
+typedef struct {
+    uint64_t bitmap[O1_WORDS];
+    int head[O1_PRIO_LEVELS], tail[O1_PRIO_LEVELS]; ///< Lists linked through O1Task.next.
+    int count;                                      ///< Processes in the array.
+} PrioArray;
+
+/**
+ * @brief Scheduling state of one process.
+ */
+typedef struct {
+    int static_prio;     ///< 120 + nice.
+    int prio;            ///< Dynamic priority: static_prio minus the interactivity bonus.
+    int time_slice;      ///< Time left in the current slice.
+    int next;            ///< Next process of the same list, -1 at the tail.
+    long long sleep_avg; ///< Sleep credit, 0..max_sleep_avg.
+} O1Task;
+
+/**
+ * @brief The run queue of the CPU.
+ */
+typedef struct {
+    PrioArray arrays[2];
+    PrioArray *active, *expired;
+    long long expired_timestamp; ///< When the first slice expired since the last switch, -1 if none.
+    int best_expired_prio;       ///< Best static priority in the expired array.
+    int nr_running;              ///< Runnable processes, the running one included.
+    O1Task *tasks;
+    long long max_sleep_avg;     ///< O1_SLEEP_QUANTA nice-0 slices; also the starvation limit.
+    int quantum;                 ///< Time slice at nice 0.
+} O1RunQueue;
+
+static void arrayInit(PrioArray *array) {
+    memset(array->bitmap, 0, sizeof(array->bitmap));
+    for (int p = 0; p < O1_PRIO_LEVELS; p++)
+        array->head[p] = array->tail[p] = -1;
+    array->count = 0;
+}
+
+/**
+ * @brief Adds a process at the tail of its priority's list, or at the head to
+ *        let a preempted process resume first.
+ */
+static void arrayEnqueue(PrioArray *array, O1Task *tasks, int i, int at_head) {
+    int prio = tasks[i].prio;
+    if (array->head[prio] < 0) {
+        tasks[i].next = -1;
+        array->head[prio] = array->tail[prio] = i;
+        array->bitmap[prio / 64] |= 1ULL << (prio % 64);
+    } else if (at_head) {
+        tasks[i].next = array->head[prio];
+        array->head[prio] = i;
+    } else {
+        tasks[i].next = -1;
+        tasks[array->tail[prio]].next = i;
+        array->tail[prio] = i;
+    }
+    array->count++;
+}
+
+/**
+ * @brief Removes and returns the first process of the best non-empty priority.
+ *
+ * The bitmap has a fixed O1_WORDS words, so finding the priority is a bounded
+ * number of find-first-set steps whatever the number of processes.
+ */
+static int arrayPopFirst(PrioArray *array, O1Task *tasks) {
+    int w = 0;
+    while (array->bitmap[w] == 0)
+        w++;
+    int prio = w * 64 + __builtin_ctzll(array->bitmap[w]);
+    int i = array->head[prio];
+    array->head[prio] = tasks[i].next;
+    if (array->head[prio] < 0)
+        array->bitmap[prio / 64] &= ~(1ULL << (prio % 64));
+    array->count--;
+    return i;
+}
+
+/**
+ * @brief Returns the full time slice of a static priority: the quantum at
+ *        nice 0, eight times it at nice -20, a twentieth of it at nice 19.
+ */
+static int timeSlice(const O1RunQueue *rq, int static_prio) {
+    int scale = static_prio < 120 ? 4 : 1;
+    int slice = (O1_PRIO_LEVELS - static_prio) * scale * rq->quantum / 20;
+    return slice > 0 ? slice : 1;
+}
+
+/**
+ * @brief Returns the dynamic priority: up to 5 levels better or worse than the
+ *        static one, by how much of the sleep credit is left.
+ */
+static int effectivePrio(const O1RunQueue *rq, const O1Task *task) {
+    int bonus = (int)(task->sleep_avg * O1_MAX_BONUS / rq->max_sleep_avg) - O1_MAX_BONUS / 2;
+    int prio = task->static_prio - bonus;
+    if (prio < O1_MAX_RT_PRIO)
+        prio = O1_MAX_RT_PRIO;
+    if (prio > O1_PRIO_LEVELS - 1)
+        prio = O1_PRIO_LEVELS - 1;
+    return prio;
+}
+
+/**
+ * @brief TASK_INTERACTIVE: the bonus is worth at least the nice-dependent delta.
+ */
+static int isInteractive(const O1Task *task) {
+    int nice = task->static_prio - 120;
+    int delta = (nice + 20) * O1_MAX_BONUS / 40 - 20 * O1_MAX_BONUS / 40 + 2;
+    return task->prio <= task->static_prio - delta;
+}
+
+/**
+ * @brief EXPIRED_STARVING: the expired array has waited too long, or holds a
+ *        process of better static priority than the one whose slice expired.
+ */
+static int expiredStarving(const O1RunQueue *rq, const O1Task *task, long long now) {
+    if (rq->expired_timestamp >= 0 && now - rq->expired_timestamp >= rq->max_sleep_avg * rq->nr_running + 1)
+        return 1;
+    return task->static_prio > rq->best_expired_prio;
+}
+
+/**
+ * @brief Computes the schedule of the Linux 2.6 O(1) scheduler on one CPU.
+ *
+ * @param processes An array of Process structures sorted by arrival.  The
+ *                  priority column is the nice value, -20..19 (default 0).
+ * @param n The number of processes in the array.
+ * @param quantum The time slice at nice 0; nicer processes get shorter ones.
+ * @param stats Receives the decision, preemption and expiry counts.
+ *
+ * @details
+ * Runnable processes sit in the active or the expired array, each a list per
+ * priority with a bitmap of the non-empty lists, and the next process is the
+ * head of the first set bit of the active array.  A process runs until it
+ * finishes, its slice is used up, or an arrival of better dynamic priority
+ * preempts it, in which case it goes back to the head of its list with the
+ * rest of its slice.  A used-up slice is refilled and the process goes to the
+ * expired array, unless it is interactive and the expired array is not
+ * starving, in which case it goes back to the tail of the active list.  When
+ * the active array empties the two arrays are swapped.
+ *
+ * The trace has no sleeps, so the interactivity estimate follows the kernel's
+ * treatment of a new process: it inherits O1_CHILD_PENALTY percent of the
+ * maximum sleep average, as a child of an interactive shell would, and loses
+ * it as it runs.  Short processes therefore keep their bonus and CPU-bound
+ * ones sink to the expired array.  Real-time lists exist but the trace has no
+ * column for them, and TIMESLICE_GRANULARITY round robin within a slice is not
+ * modelled.
+ *
+ * Every decision is a constant number of bitmap words and list operations, and
+ * time jumps from event to event (arrival, slice end, completion).
+ */
+void computeO1(Process processes[], int n, int quantum, O1Stats *stats) {
+    for (int i = 0; i < n; i++) {
+        if (processes[i].priority < -20 || processes[i].priority > 19) {
+            fprintf(stderr, "Invalid trace: process %d has priority %d, the O(1) scheduler takes nice values "
+                            "-20..19\n", processes[i].id, processes[i].priority);
+            exit(EXIT_FAILURE);
+        }
+        processes[i].remaining = processes[i].burst;
+        processes[i].start_time = -1;
+        processes[i].finish_time = -1;
+    }
+
+    O1RunQueue rq;
+    arrayInit(&rq.arrays[0]);
+    arrayInit(&rq.arrays[1]);
+    rq.active = &rq.arrays[0];
+    rq.expired = &rq.arrays[1];
+    rq.expired_timestamp = -1;
+    rq.best_expired_prio = O1_PRIO_LEVELS;
+    rq.nr_running = 0;
+    rq.quantum = quantum;
+    rq.max_sleep_avg = (long long)O1_SLEEP_QUANTA * quantum;
+    rq.tasks = malloc((n > 0 ? n : 1) * sizeof(O1Task));
+    if (!rq.tasks) {
+        perror("Error allocating O(1) run queue");
+        exit(EXIT_FAILURE);
+    }
+    O1Task *tasks = rq.tasks;
+
+    *stats = (O1Stats){0};
+    int idx = 0, completed = 0, current = -1;
+    long long now = 0;
+
+    while (completed < n) {
+        if (current < 0 && rq.nr_running == 0 && processes[idx].arrival > now)
+            now = processes[idx].arrival;
+
+        int resched = 0;
+        for (; idx < n && processes[idx].arrival <= now; idx++) {
+            O1Task *task = &tasks[idx];
+            task->static_prio = 120 + processes[idx].priority;
+            task->sleep_avg = rq.max_sleep_avg * O1_CHILD_PENALTY / 100;
+            task->prio = effectivePrio(&rq, task);
+            task->time_slice = timeSlice(&rq, task->static_prio);
+            arrayEnqueue(rq.active, tasks, idx, 0);
+            rq.nr_running++;
+            resched |= current >= 0 && task->prio < tasks[current].prio;
+        }
+        if (resched) {
+            arrayEnqueue(rq.active, tasks, current, 1);
+            current = -1;
+            stats->preemptions++;
+        }
+
+        if (current < 0) {
+            if (rq.active->count == 0) {
+                PrioArray *swap = rq.active;
+                rq.active = rq.expired;
+                rq.expired = swap;
+                rq.expired_timestamp = -1;
+                rq.best_expired_prio = O1_PRIO_LEVELS;
+                stats->switches++;
+            }
+            current = arrayPopFirst(rq.active, tasks);
+            stats->decisions++;
+            if (processes[current].start_time == -1)
+                processes[current].start_time = (int)now;
+        }
+
+        O1Task *task = &tasks[current];
+        long long run = task->time_slice < processes[current].remaining ? task->time_slice
+                                                                         : processes[current].remaining;
+        if (idx < n && processes[idx].arrival - now < run)
+            run = processes[idx].arrival - now;
+        now += run;
+        processes[current].remaining -= (int)run;
+        task->time_slice -= (int)run;
+        task->sleep_avg = task->sleep_avg > run ? task->sleep_avg - run : 0;
+
+        if (processes[current].remaining == 0) {
+            processes[current].finish_time = (int)now;
+            completed++;
+            rq.nr_running--;
+            current = -1;
+        } else if (task->time_slice == 0) {
+            task->prio = effectivePrio(&rq, task);
+            task->time_slice = timeSlice(&rq, task->static_prio);
+            stats->expirations++;
+            if (rq.expired_timestamp < 0)
+                rq.expired_timestamp = now;
+            if (!isInteractive(task) || expiredStarving(&rq, task, now)) {
+                arrayEnqueue(rq.expired, tasks, current, 0);
+                if (task->static_prio < rq.best_expired_prio)
+                    rq.best_expired_prio = task->static_prio;
+            } else {
+                arrayEnqueue(rq.active, tasks, current, 0);
+                stats->requeued++;
+            }
+            current = -1;
+        }
+    }
+    stats->makespan = (int)now;
+
+    free(rq.tasks);
+}
+
+/**
+ * @brief Returns the monotonic clock in nanoseconds.
+ */
+static double nowNs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/**
+ * @brief Times the O(1) scheduler and the event RR engine on the same trace.
+ *
+ * @details
+ * Each engine runs O1_BENCH_RUNS times on its own copy of the trace and the
+ * best run counts, divided by that engine's own number of decisions: the RR
+ * engine takes fewer, since it runs a lone process up to the next arrival in
+ * one decision.
+ */
+void benchmarkO1(const Process processes[], int n, int quantum, O1Benchmark *bench) {
+    Process *copy = malloc((n > 0 ? n : 1) * sizeof(Process));
+    if (!copy) {
+        perror("Error allocating benchmark trace");
+        exit(EXIT_FAILURE);
+    }
+    double best_o1 = 0, best_rr = 0;
+    for (int run = 0; run < O1_BENCH_RUNS; run++) {
+        O1Stats stats;
+        memcpy(copy, processes, n * sizeof(Process));
+        double start = nowNs();
+        computeO1(copy, n, quantum, &stats);
+        double elapsed = nowNs() - start;
+        if (run == 0 || elapsed < best_o1)
+            best_o1 = elapsed;
+        bench->o1_decisions = stats.decisions;
+
+        memcpy(copy, processes, n * sizeof(Process));
+        start = nowNs();
+        computeRREventCounted(copy, n, quantum, &bench->rr_decisions);
+        elapsed = nowNs() - start;
+        if (run == 0 || elapsed < best_rr)
+            best_rr = elapsed;
+    }
+    bench->o1_ns = bench->o1_decisions ? best_o1 / bench->o1_decisions : 0;
+    bench->rr_ns = bench->rr_decisions ? best_rr / bench->rr_decisions : 0;
+    free(copy);
+}
+
+/**
+ * @brief Prints what the O(1) scheduler did and what each of its decisions cost.
+ */
+void printO1Stats(int quantum, const O1Stats *stats, const O1Benchmark *bench, FILE *out) {
+    fprintf(out, "\nO(1) Scheduler (nice-0 slice %d):\n", quantum);
+    fprintf(out, "Scheduling Decisions: %lld\n", stats->decisions);
+    fprintf(out, "Preemptions by Arrivals: %lld\n", stats->preemptions);
+    fprintf(out, "Expired Slices: %lld (%lld kept active as interactive)\n", stats->expirations, stats->requeued);
+    fprintf(out, "Array Switches: %lld\n", stats->switches);
+    fprintf(out, "Cost per Decision: %.1f ns (RR: %.1f ns over %lld decisions)\n", bench->o1_ns, bench->rr_ns,
+            bench->rr_decisions);
+}
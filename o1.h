@@ -0,0 +1,37 @@
+#ifndef O1_H
+#define O1_H
+
+#include <stdio.h>
+#include "process.h"
+
+#define O1_PRIO_LEVELS 140  ///< Priority lists: 0-99 real time, 100-139 nice -20..19.
+#define O1_MAX_RT_PRIO 100  ///< First non-real-time priority.
+#define O1_MAX_BONUS 10     ///< Width of the interactivity bonus range (-5..+5).
+#define O1_SLEEP_QUANTA 10  ///< Maximum sleep average, in nice-0 time slices.
+#define O1_CHILD_PENALTY 95 ///< Percent of the maximum sleep average a new process starts with.
+
+/**
+ * @brief Outcome of a run of the O(1) scheduler.
+ */
+typedef struct {
+    long long decisions;    ///< Processes picked to run.
+    long long preemptions;  ///< Running processes preempted by a better arrival.
+    long long expirations;  ///< Time slices used up.
+    long long requeued;     ///< Expired slices put back in the active array as interactive.
+    long long switches;     ///< Swaps of the active and expired arrays.
+    int makespan;           ///< Finish time of the last process.
+} O1Stats;
+
+/**
+ * @brief Cost per scheduling decision of the O(1) scheduler and the event RR engine.
+ */
+typedef struct {
+    double o1_ns, rr_ns;                ///< Wall time per decision, best of a few runs.
+    long long o1_decisions, rr_decisions; ///< Decisions of each run.
+} O1Benchmark;
+
+void computeO1(Process processes[], int n, int quantum, O1Stats *stats);
+void benchmarkO1(const Process processes[], int n, int quantum, O1Benchmark *bench);
+void printO1Stats(int quantum, const O1Stats *stats, const O1Benchmark *bench, FILE *out);
+
+#endif
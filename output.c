@@ -0,0 +1,402 @@
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "output.h"
+#include "arrow.h"
+
+/**
+ * @brief Opens a buffered writer on a newly created (or truncated) file.
+ *
+ * @param writer The writer to initialize.
+ * @param filename The file to write, or "-" for stdout.
+ */
+void writerOpen(BufferedWriter *writer, const char *filename) {
+    if (strcmp(filename, "-") == 0) {
+        fflush(stdout);
+        writer->fd = STDOUT_FILENO;
+    } else {
+        writer->fd = open(filename, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    }
+    if (writer->fd < 0) {
+        perror("Error opening dump file");
+        exit(EXIT_FAILURE);
+    }
+
+    writer->len = 0;
+    writer->cap = WRITER_BUFFER_SIZE;
+    writer->buf = malloc(writer->cap);
+    if (!writer->buf) {
+        perror("Error allocating output buffer");
+        exit(EXIT_FAILURE);
+    }
+}
+
+/**
+ * @brief Writes len bytes to fd, retrying on short writes.
+ */
+static void writeAll(int fd, const char *data, size_t len) {
+    size_t done = 0;
+    while (done < len) {
+        ssize_t written = write(fd, data + done, len - done);
+        if (written < 0) {
+            perror("Error writing dump file");
+            exit(EXIT_FAILURE);
+        }
+        done += (size_t)written;
+    }
+}
+
+/**
+ * @brief Writes out every buffered byte.
+ */
+void writerFlush(BufferedWriter *writer) {
+    if (writer->fd == STDOUT_FILENO)
+        fflush(stdout); // Keep the dump ordered with the report when both go to stdout.
+    writeAll(writer->fd, writer->buf, writer->len);
+    writer->len = 0;
+}
+
+/**
+ * @brief Flushes the writer and closes its file.
+ */
+void writerClose(BufferedWriter *writer) {
+    writerFlush(writer);
+    if (writer->fd != STDOUT_FILENO)
+        close(writer->fd);
+    free(writer->buf);
+    writer->buf = NULL;
+}
+
+/**
+ * @brief Appends raw bytes to the buffer.
+ */
+void writerPutBytes(BufferedWriter *writer, const void *data, size_t len) {
+    if (writer->len + len > writer->cap) {
+        writerFlush(writer);
+        if (len > writer->cap) {
+            writeAll(writer->fd, data, len);
+            return;
+        }
+    }
+    memcpy(writer->buf + writer->len, data, len);
+    writer->len += len;
+}
+
+static const char digit_pairs[201] =
+    "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+    "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+/**
+ * @brief Appends the decimal representation of an integer.
+ *
+ * @details
+ * Digits are produced two at a time from a lookup table, right to left into a
+ * scratch area, which is several times faster than going through printf.
+ */
+void writerPutInt(BufferedWriter *writer, int value) {
+    char scratch[12];
+    char *end = scratch + sizeof(scratch), *p = end;
+    unsigned int v = value < 0 ? 0u - (unsigned int)value : (unsigned int)value;
+
+    while (v >= 100) {
+        unsigned int pair = (v % 100) * 2;
+        v /= 100;
+        *--p = digit_pairs[pair + 1];
+        *--p = digit_pairs[pair];
+    }
+    if (v >= 10) {
+        *--p = digit_pairs[v * 2 + 1];
+        *--p = digit_pairs[v * 2];
+    } else {
+        *--p = (char)('0' + v);
+    }
+    if (value < 0)
+        *--p = '-';
+
+    size_t len = (size_t)(end - p);
+    if (writer->len + len > writer->cap)
+        writerFlush(writer);
+    memcpy(writer->buf + writer->len, p, len);
+    writer->len += len;
+}
+
+/**
+ * @brief Parses the name of an output format ("text", "json" or "csv").
+ *
+ * @return 0 on success, -1 if the name is unknown.
+ */
+int parseOutputFormat(const char *name, OutputFormat *format) {
+    if (strcmp(name, "text") == 0)
+        *format = FORMAT_TEXT;
+    else if (strcmp(name, "json") == 0)
+        *format = FORMAT_JSON;
+    else if (strcmp(name, "csv") == 0)
+        *format = FORMAT_CSV;
+    else
+        return -1;
+    return 0;
+}
+
+/**
+ * @brief Parses the name of a dump format ("csv", "bin" or "arrow").
+ *
+ * @return 0 on success, -1 if the name is unknown.
+ */
+int parseDumpFormat(const char *name, DumpFormat *format) {
+    if (strcmp(name, "csv") == 0)
+        *format = DUMP_CSV;
+    else if (strcmp(name, "bin") == 0)
+        *format = DUMP_BIN;
+    else if (strcmp(name, "arrow") == 0)
+        *format = DUMP_ARROW;
+    else
+        return -1;
+    return 0;
+}
+
+static int schedules_written = 0;
+
+/**
+ * @brief Writes whatever precedes the first schedule in the chosen format.
+ */
+void writeMetricsBegin(FILE *out, OutputFormat format) {
+    schedules_written = 0;
+    if (format == FORMAT_JSON)
+        fprintf(out, "{\"schedules\": [");
+    else if (format == FORMAT_CSV)
+        fprintf(out, "algorithm,quantum,class,processes,avg_turnaround,avg_response,avg_waiting,"
+                     "throughput,tat_p50,tat_p95,tat_p99,rt_p50,rt_p95,rt_p99\n");
+}
+
+/**
+ * @brief Heading of a schedule in the text report, and tag of its binary dump section.
+ */
+typedef struct {
+    const char *algorithm; ///< Short algorithm name, as passed to writeMetrics.
+    const char *format;    ///< Heading, with a %d for the quantum if uses_quantum.
+    int uses_quantum;      ///< Non-zero for the heading of a run with a quantum.
+    const char *tag;       ///< Tag of its binary dump section, up to four bytes, unique per algorithm.
+} ScheduleTitle;
+
+/**
+ * @brief Headings and tags of every schedule.  "dispatch" has one per local policy:
+ *        RR servers pass their quantum, FCFS servers 0.
+ */
+static const ScheduleTitle schedule_titles[] = {
+    {"fcfs", "FCFS Scheduling", 0, "FCFS"},
+    {"rr", "Round Robin Scheduling (Quantum=%d)", 1, "RR"},
+    {"rr-ac", "Round Robin with Admission Control (Quantum=%d)", 1, "RR-A"},
+    {"elastic", "Elastic Round Robin Scheduling (Quantum=%d)", 1, "ELAS"},
+    {"dispatch", "Dispatched Round Robin Scheduling (Quantum=%d)", 1, "DISP"},
+    {"dispatch", "Dispatched FCFS Scheduling", 0, "DISP"},
+    {"eevdf", "EEVDF Scheduling (Slice=%d)", 1, "EEVD"},
+    {"groups", "Group Round Robin Scheduling (Quantum=%d)", 1, "GROU"},
+    {"bandwidth", "Group Round Robin with Bandwidth Limits (Quantum=%d)", 1, "BAND"},
+    {"o1", "O(1) Scheduling (Quantum=%d)", 1, "O1"},
+    {"cbs", "CBS with Best-Effort Round Robin (Quantum=%d)", 1, "CBS"},
+    {"topo-naive", "Round Robin with Naive Placement (Quantum=%d)", 1, "TOPN"},
+    {"topo-affinity", "Round Robin with Affinity Placement (Quantum=%d)", 1, "TOPA"},
+    {"lb-periodic", "Per-CPU Round Robin with Periodic Balancing (Quantum=%d)", 1, "LB-P"},
+    {"lb-steal", "Per-CPU Round Robin with Work Stealing (Quantum=%d)", 1, "LB-S"},
+    {"gang", "Gang Scheduling (Quantum=%d)", 1, "GANG"},
+    {"easy", "FCFS with EASY Backfilling", 0, "EASY"},
+    {"sjf", "SJF Scheduling (Oracle Bursts)", 0, "SJF"},
+    {"psjf", "SJF Scheduling (Predicted Bursts)", 0, "PSJF"},
+};
+
+/**
+ * @brief Returns the heading of a schedule in the text report.
+ *
+ * @details
+ * The entry of the algorithm that agrees on having a quantum wins, then any
+ * entry of the algorithm; unknown algorithms get a generic heading.
+ */
+static const char *scheduleTitle(const char *algorithm, int quantum) {
+    static char title[96];
+    const ScheduleTitle *found = NULL;
+    for (size_t i = 0; i < sizeof(schedule_titles) / sizeof(schedule_titles[0]); i++) {
+        const ScheduleTitle *t = &schedule_titles[i];
+        if (strcmp(t->algorithm, algorithm) != 0)
+            continue;
+        if (!found || t->uses_quantum == (quantum > 0))
+            found = t;
+        if (t->uses_quantum == (quantum > 0))
+            break;
+    }
+    if (!found)
+        snprintf(title, sizeof(title), "%s Scheduling", algorithm);
+    else if (found->uses_quantum)
+        snprintf(title, sizeof(title), found->format, quantum);
+    else
+        return found->format;
+    return title;
+}
+
+/**
+ * @brief Copies the tag of a schedule's binary dump section into tag.
+ *
+ * @details
+ * Unknown algorithms are tagged with the first four bytes of their name,
+ * upper-cased.
+ */
+static void scheduleTag(const char *algorithm, char tag[4]) {
+    const char *name = algorithm;
+    for (size_t i = 0; i < sizeof(schedule_titles) / sizeof(schedule_titles[0]); i++) {
+        if (strcmp(schedule_titles[i].algorithm, algorithm) == 0) {
+            name = schedule_titles[i].tag;
+            break;
+        }
+    }
+    memset(tag, 0, 4);
+    for (int i = 0; i < 4 && name[i]; i++)
+        tag[i] = (char)toupper((unsigned char)name[i]);
+}
+
+/**
+ * @brief Writes the aggregate metrics of one schedule.
+ *
+ * @param out The stream to write to.
+ * @param format The output format.
+ * @param algorithm Short algorithm name used as key ("fcfs", "rr", ...).
+ * @param quantum The time quantum, or 0 for non-preemptive algorithms.
+ * @param n The number of processes.
+ * @param avg_tat The average turnaround time.
+ * @param avg_rt The average response time.
+ * @param throughput The throughput.
+ * @param classes The per-class breakdown, or NULL.
+ */
+void writeMetrics(FILE *out, OutputFormat format, const char *algorithm, int quantum, int n,
+                  float avg_tat, float avg_rt, float throughput, const ClassMetrics *classes) {
+    int first = schedules_written++ == 0;
+
+    if (format == FORMAT_TEXT) {
+        if (!first)
+            fprintf(out, "\n");
+        fprintf(out, "%s:\n", scheduleTitle(algorithm, quantum));
+        fprintf(out, "Average Turnaround Time: %.2f\n", avg_tat);
+        fprintf(out, "Average Response Time: %.2f\n", avg_rt);
+        fprintf(out, "Throughput: %.2f processes/ut\n", throughput);
+        if (classes) {
+            fprintf(out, "\n");
+            printClassMetrics(classes, out);
+        }
+        return;
+    }
+
+    if (format == FORMAT_CSV) {
+        fprintf(out, "%s,%d,all,%d,%.6f,%.6f,,%.6f,,,,,,\n", algorithm, quantum, n, avg_tat, avg_rt, throughput);
+        for (int c = 0; classes && c < MAX_CLASSES; c++) {
+            const ClassMetrics *m = &classes[c];
+            if (m->count == 0)
+                continue;
+            fprintf(out, "%s,%d,%s,%d,%.6f,%.6f,%.6f,%.6f,%d,%d,%d,%d,%d,%d\n", algorithm, quantum,
+                    className(c), m->count, m->avg_tat, m->avg_rt, m->avg_wt, m->throughput,
+                    m->tat_p50, m->tat_p95, m->tat_p99, m->rt_p50, m->rt_p95, m->rt_p99);
+        }
+        return;
+    }
+
+    fprintf(out, "%s\n  {\"algorithm\": \"%s\", \"quantum\": %d, \"processes\": %d, "
+                 "\"avg_turnaround\": %.6f, \"avg_response\": %.6f, \"throughput\": %.6f",
+            first ? "" : ",", algorithm, quantum, n, avg_tat, avg_rt, throughput);
+    if (classes) {
+        int first_class = 1;
+        fprintf(out, ", \"classes\": [");
+        for (int c = 0; c < MAX_CLASSES; c++) {
+            const ClassMetrics *m = &classes[c];
+            if (m->count == 0)
+                continue;
+            fprintf(out, "%s\n    {\"class\": \"%s\", \"processes\": %d, \"avg_turnaround\": %.6f, "
+                         "\"avg_response\": %.6f, \"avg_waiting\": %.6f, \"throughput\": %.6f, "
+                         "\"tat_p50\": %d, \"tat_p95\": %d, \"tat_p99\": %d, "
+                         "\"rt_p50\": %d, \"rt_p95\": %d, \"rt_p99\": %d}",
+                    first_class ? "" : ",", className(c), m->count, m->avg_tat, m->avg_rt,
+                    m->avg_wt, m->throughput, m->tat_p50, m->tat_p95, m->tat_p99,
+                    m->rt_p50, m->rt_p95, m->rt_p99);
+            first_class = 0;
+        }
+        fprintf(out, "]");
+    }
+    fprintf(out, "}");
+}
+
+/**
+ * @brief Writes whatever follows the last schedule in the chosen format.
+ */
+void writeMetricsEnd(FILE *out, OutputFormat format) {
+    if (format == FORMAT_JSON)
+        fprintf(out, "\n]}\n");
+}
+
+/**
+ * @brief Writes the header of a per-process dump.
+ */
+void dumpBegin(BufferedWriter *writer, DumpFormat format) {
+    static const char csv_header[] = "algorithm,id,arrival,burst,start,finish\n";
+    if (format == DUMP_CSV)
+        writerPutBytes(writer, csv_header, sizeof(csv_header) - 1);
+    else if (format == DUMP_ARROW)
+        arrowWriteSchema(writer);
+    else
+        writerPutBytes(writer, "PRCSDMP1", 8);
+}
+
+/**
+ * @brief Writes the trailer of a per-process dump, if the format has one.
+ */
+void dumpEnd(BufferedWriter *writer, DumpFormat format) {
+    if (format == DUMP_ARROW)
+        arrowWriteEnd(writer);
+}
+
+/**
+ * @brief Appends the start and finish times of every process of a schedule.
+ *
+ * @param writer The buffered writer of the dump.
+ * @param format The dump format.
+ * @param algorithm Short algorithm name; schedule_titles gives the tag of its binary section.
+ * @param processes An array of Process structures with start and finish times set.
+ * @param n The number of processes in the array.
+ */
+void dumpSchedule(BufferedWriter *writer, DumpFormat format, const char *algorithm,
+                  const Process processes[], int n) {
+    if (format == DUMP_ARROW) {
+        arrowWriteBatches(writer, algorithm, processes, n);
+        return;
+    }
+    if (format == DUMP_BIN) {
+        char tag[4];
+        int record[5];
+        scheduleTag(algorithm, tag);
+        writerPutBytes(writer, tag, sizeof(tag));
+        writerPutBytes(writer, &n, sizeof(n));
+        for (int i = 0; i < n; i++) {
+            record[0] = processes[i].id;
+            record[1] = processes[i].arrival;
+            record[2] = processes[i].burst;
+            record[3] = processes[i].start_time;
+            record[4] = processes[i].finish_time;
+            writerPutBytes(writer, record, sizeof(record));
+        }
+        return;
+    }
+
+    size_t name_len = strlen(algorithm);
+    for (int i = 0; i < n; i++) {
+        writerPutBytes(writer, algorithm, name_len);
+        writerPutBytes(writer, ",", 1);
+        writerPutInt(writer, processes[i].id);
+        writerPutBytes(writer, ",", 1);
+        writerPutInt(writer, processes[i].arrival);
+        writerPutBytes(writer, ",", 1);
+        writerPutInt(writer, processes[i].burst);
+        writerPutBytes(writer, ",", 1);
+        writerPutInt(writer, processes[i].start_time);
+        writerPutBytes(writer, ",", 1);
+        writerPutInt(writer, processes[i].finish_time);
+        writerPutBytes(writer, "\n", 1);
+    }
+}
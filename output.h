@@ -0,0 +1,64 @@
+#ifndef OUTPUT_H
+#define OUTPUT_H
+
+#include <stdio.h>
+#include <stddef.h>
+#include "process.h"
+#include "groupby.h"
+
+/**
+ * @brief Format of the aggregate metrics written to stdout.
+ */
+typedef enum {
+    FORMAT_TEXT, ///< The human-readable report.
+    FORMAT_JSON, ///< One JSON document with an entry per schedule.
+    FORMAT_CSV   ///< One CSV row per schedule and class.
+} OutputFormat;
+
+/**
+ * @brief Format of the per-process dump.
+ *
+ * The binary dump starts with the 8-byte magic "PRCSDMP1" followed by one section
+ * per schedule: a 4-byte algorithm tag ("FCFS", "RR\0\0", "TOPN", ...), distinct
+ * for every algorithm, a 32-bit record count and that many records of five 32-bit
+ * integers (id, arrival, burst, start, finish), all in host byte order.
+ *
+ * The Arrow dump is an Apache Arrow IPC stream with one record batch per
+ * ARROW_BATCH_ROWS processes of each schedule, see arrow.c.
+ */
+typedef enum {
+    DUMP_CSV,  ///< "algorithm,id,arrival,burst,start,finish" rows.
+    DUMP_BIN,  ///< Fixed-size binary records, see above.
+    DUMP_ARROW ///< Arrow IPC stream with turnaround, response and waiting times as well.
+} DumpFormat;
+
+/**
+ * @brief Write-behind buffer over a file descriptor.
+ */
+typedef struct {
+    int fd;       ///< Destination file descriptor.
+    char *buf;    ///< Buffered bytes not yet written.
+    size_t len;   ///< Number of buffered bytes.
+    size_t cap;   ///< Capacity of buf.
+} BufferedWriter;
+
+#define WRITER_BUFFER_SIZE (4 << 20) ///< Bytes buffered between write() calls.
+
+void writerOpen(BufferedWriter *writer, const char *filename);
+void writerFlush(BufferedWriter *writer);
+void writerClose(BufferedWriter *writer);
+void writerPutBytes(BufferedWriter *writer, const void *data, size_t len);
+void writerPutInt(BufferedWriter *writer, int value);
+
+int parseOutputFormat(const char *name, OutputFormat *format);
+int parseDumpFormat(const char *name, DumpFormat *format);
+void writeMetricsBegin(FILE *out, OutputFormat format);
+void writeMetrics(FILE *out, OutputFormat format, const char *algorithm, int quantum, int n,
+                  float avg_tat, float avg_rt, float throughput, const ClassMetrics *classes);
+void writeMetricsEnd(FILE *out, OutputFormat format);
+void dumpBegin(BufferedWriter *writer, DumpFormat format);
+void dumpSchedule(BufferedWriter *writer, DumpFormat format, const char *algorithm,
+                  const Process processes[], int n);
+void dumpEnd(BufferedWriter *writer, DumpFormat format);
+
+#endif
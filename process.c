@@ -0,0 +1,223 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "process.h"
+#include "schema.h"
+
+/**
+ * @brief Parses one trace line according to the column map of its trace.
+ *
+ * @param schema The column map built from the header line.
+ * @param line The NUL-terminated line to parse.
+ * @param line_number The number of the line in its trace, for error messages.
+ * @param process The Process structure to fill.
+ * @return 1 if the line holds a process, 0 if it should be skipped.
+ *
+ * @details
+ * See parseRecord for the rules; columns the run does not need are skipped
+ * without conversion and leave their fields at the defaults.
+ */
+int parseProcessLine(const TraceSchema *schema, const char *line, int line_number, Process *process) {
+    return parseRecord(schema, line, line + strlen(line), line_number, process);
+}
+
+/**
+ * @brief Reads process information from a file.
+ *
+ * @param filename The name of the file containing process data.
+ * @param processes A pointer that receives a heap-allocated array of Process structures.
+ *                  The caller releases it with free().
+ * @param fields Bitmask of FIELD_BIT values the run uses; other columns are skipped.
+ * @return The number of processes read from the file.
+ *
+ * @details
+ * The function opens the specified file, builds the column map from the header
+ * line, and reads process data from each subsequent line with parseProcessLine.
+ * Lines are read with getline, so like the chunked loaders it takes lines of any
+ * length.
+ * It populates the processes array with the read data, doubling its capacity as
+ * needed.  Error handling is included for file opening and allocation.
+ */
+int readProcesses(const char *filename, Process **processes, unsigned fields) {
+    FILE *file = fopen(filename, "r");
+    if (!file) {
+        perror("Error opening file");
+        exit(EXIT_FAILURE);
+    }
+
+    char *line = NULL;
+    size_t line_capacity = 0;
+    ssize_t length = getline(&line, &line_capacity, file);
+    TraceSchema schema;
+    if (length >= 0)
+        parseSchema(line, line + length, fields, &schema);
+    else
+        defaultSchema(fields, &schema);
+    int count = 0, capacity = 1024, line_number = 1;
+    Process *table = malloc(capacity * sizeof(Process));
+
+    while (table && getline(&line, &line_capacity, file) >= 0) {
+        line_number++;
+        if (count == capacity) {
+            capacity *= 2;
+            Process *grown = realloc(table, capacity * sizeof(Process));
+            if (!grown)
+                free(table);
+            table = grown;
+            if (!table)
+                break;
+        }
+        count += parseProcessLine(&schema, line, line_number, &table[count]);
+    }
+
+    if (!table) {
+        perror("Error allocating process table");
+        exit(EXIT_FAILURE);
+    }
+
+    free(line);
+    fclose(file);
+    *processes = table;
+    return count;
+}
+
+
+/**
+ * @brief Computes the First-Come, First-Served (FCFS) scheduling algorithm.
+ *
+ * @param processes An array of Process structures.
+ * @param n The number of processes in the array.
+ *
+ * @details
+ * This function implements the FCFS scheduling algorithm. It iterates through the
+ * processes in the order they appear in the array and calculates the start and finish
+ * times for each process based on the current time.
+ */
+void computeFCFS(Process processes[], int n) {
+    int current_time = 0;
+    for (int i = 0; i < n; i++) {
+        if (processes[i].arrival > current_time)
+            current_time = processes[i].arrival;
+        processes[i].start_time = current_time;
+        processes[i].finish_time = current_time + processes[i].burst;
+        current_time = processes[i].finish_time;
+    }
+}
+
+/**
+ * @brief Computes the Round Robin (RR) scheduling algorithm.
+ *
+ * @param processes An array of Process structures.
+ * @param n The number of processes in the array.
+ * @param quantum The time quantum for the RR algorithm.
+ *
+ * @details
+ * This function implements the RR scheduling algorithm. It uses a queue to manage
+ * the processes and simulates the execution of each process for a time quantum.
+ * It calculates the start and finish times for each process.  A process is never
+ * queued twice, so the queue is a ring buffer of n slots.
+ */
+void computeRR(Process processes[], int n, int quantum) {
+    int *remaining = malloc(n * sizeof(int));
+    int *start_time = malloc(n * sizeof(int));
+    int *finish_time = malloc(n * sizeof(int));
+    
+    for (int i = 0; i < n; i++) {
+        remaining[i] = processes[i].burst;
+        start_time[i] = -1;
+        finish_time[i] = -1;
+    }
+
+    int *queue = malloc(n * sizeof(int));
+    int front = 0, rear = -1, size = 0;
+    int current_time = 0, idx = 0, completed = 0;
+
+    while (idx < n && processes[idx].arrival <= current_time) {
+        rear = (rear + 1) % n;
+        queue[rear] = idx++;
+        size++;
+    }
+
+    while (completed < n) {
+        if (size == 0) {
+            current_time++;
+            while (idx < n && processes[idx].arrival <= current_time) {
+                rear = (rear + 1) % n;
+                queue[rear] = idx++;
+                size++;
+            }
+            continue;
+        }
+
+        int proc_idx = queue[front];
+        front = (front + 1) % n;
+        size--;
+
+        if (start_time[proc_idx] == -1)
+            start_time[proc_idx] = current_time;
+
+        int exec_time = (remaining[proc_idx] < quantum) ? remaining[proc_idx] : quantum;
+        remaining[proc_idx] -= exec_time;
+        current_time += exec_time;
+
+        while (idx < n && processes[idx].arrival <= current_time) {
+            rear = (rear + 1) % n;
+            queue[rear] = idx++;
+            size++;
+        }
+
+        if (remaining[proc_idx] > 0) {
+            rear = (rear + 1) % n;
+            queue[rear] = proc_idx;
+            size++;
+        } else {
+            finish_time[proc_idx] = current_time;
+            completed++;
+        }
+    }
+
+    for (int i = 0; i < n; i++) {
+        processes[i].start_time = start_time[i];
+        processes[i].finish_time = finish_time[i];
+    }
+
+
+    free(queue);
+    free(remaining);
+    free(start_time);
+    free(finish_time);
+}
+
+/**
+ * @brief Calculates performance metrics for the scheduling algorithms.
+ *
+ * @param processes An array of Process structures.
+ * @param n The number of processes in the array.
+ * @param avg_tat A pointer to a float variable to store the average turnaround time.
+ * @param avg_rt A pointer to a float variable to store the average response time.
+ * @param throughput A pointer to a float variable to store the throughput.
+ *f
+ * @details
+ * This function calculates the average turnaround time, average response time, and
+ * throughput based on the start and finish times of the processes.  Without
+ * processes, or without elapsed time, they are 0, so that every output format,
+ * JSON included, stays well formed.
+ */
+void calculateMetrics(Process processes[], int n, float *avg_tat, float *avg_rt, float *throughput) {
+    float total_tat = 0, total_rt = 0;
+    int max_finish = 0;
+
+    for (int i = 0; i < n; i++) {
+        int tat = processes[i].finish_time - processes[i].arrival; //Turnaround Time
+        int rt = processes[i].start_time - processes[i].arrival; //Response Time
+        total_tat += tat;
+        total_rt += rt;
+        if (processes[i].finish_time > max_finish)
+            max_finish = processes[i].finish_time;
+    }
+
+    // An empty trace, or one that finishes at time 0, has no averages or rate: report 0.
+    *avg_tat = n > 0 ? total_tat / n : 0; // Total TAT and RT are divided by the number of processes (n) to get the averages.
+    *avg_rt = n > 0 ? total_rt / n : 0;
+    *throughput = max_finish > 0 ? (float)n / max_finish : 0;
+}
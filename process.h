@@ -0,0 +1,29 @@
+#ifndef PROCESS_H
+#define PROCESS_H
+
+/**
+ * @brief Represents a process with its attributes.
+ */
+typedef struct {
+    int id;          ///< Unique identifier for the process.
+    int arrival;     ///< Arrival time of the process.
+    int burst;       ///< Total burst time required by the process.
+    int remaining;   ///< Remaining burst time of the process.
+    int start_time;  ///< Start time of the process execution.
+    int finish_time; ///< Finish time of the process execution.
+    int cls;         ///< Job class id, 0 when the trace has no class column.
+    int priority;    ///< Priority, lower is more urgent; 0 without a priority column.
+    int deadline;    ///< Absolute deadline, -1 without a deadline column.
+    int weight;      ///< Share weight, 1 without a weight column.
+    int group;       ///< Group id, 0 without a group column.
+    int cores;       ///< Cores used at once, 1 without a cores column.
+} Process;
+
+struct TraceSchema;
+int parseProcessLine(const struct TraceSchema *schema, const char *line, int line_number, Process *process);
+int readProcesses(const char *filename, Process **processes, unsigned fields);
+void computeFCFS(Process processes[], int n);
+void computeRR(Process processes[], int n, int quantum);
+void calculateMetrics(Process processes[], int n, float *avg_tat, float *avg_rt, float *throughput);
+
+#endif
@@ -0,0 +1,174 @@
+#include <stdlib.h>
+#include <string.h>
+#include "profile.h"
+
+/**
+ * @brief Computes the profile of a trace in a single fused pass.
+ *
+ * @param processes An array of Process structures.
+ * @param n The number of processes in the array.
+ * @param profile Receives the profile.
+ *
+ * @details
+ * Every statistic and validation flag is accumulated in the same loop, so the
+ * table is streamed from memory exactly once.  The loop body is branch-free
+ * (minimum, maximum and flags are selects or ORs) and the accumulators are
+ * independent, so it runs at the speed the records can be loaded.
+ */
+void profileTrace(const Process processes[], int n, TraceProfile *profile) {
+    memset(profile, 0, sizeof(*profile));
+    profile->count = n;
+    profile->sorted = 1;
+    profile->all_zero_arrivals = 1;
+    profile->ids_increasing = 1;
+    if (n == 0)
+        return;
+
+    const Process *p = processes;
+    long long work = p[0].burst, gaps = 0;
+    double burst_sq = (double)p[0].burst * p[0].burst, gap_sq = 0;
+    int min_burst = p[0].burst, max_burst = p[0].burst, last_arrival = p[0].arrival;
+    long long min_gap = 0, max_gap = 0;
+    int unsorted = 0, nonzero = p[0].arrival != 0, ids_out_of_order = 0;
+    int negative_bursts = p[0].burst < 0, negative_arrivals = p[0].arrival < 0;
+    if (n > 1)
+        min_gap = max_gap = (long long)p[1].arrival - p[0].arrival;
+
+    for (int i = 1; i < n; i++) {
+        int burst = p[i].burst, arrival = p[i].arrival;
+        long long gap = (long long)arrival - p[i - 1].arrival; // Spans up to twice the int range.
+
+        work += burst;
+        burst_sq += (double)burst * burst;
+        min_burst = burst < min_burst ? burst : min_burst;
+        max_burst = burst > max_burst ? burst : max_burst;
+
+        gaps += gap;
+        gap_sq += (double)gap * gap;
+        min_gap = gap < min_gap ? gap : min_gap;
+        max_gap = gap > max_gap ? gap : max_gap;
+        last_arrival = arrival > last_arrival ? arrival : last_arrival;
+
+        unsorted |= gap < 0;
+        nonzero |= arrival != 0;
+        ids_out_of_order |= p[i].id <= p[i - 1].id;
+        negative_bursts += burst < 0;
+        negative_arrivals += arrival < 0;
+    }
+
+    profile->total_work = work;
+    profile->min_burst = min_burst;
+    profile->max_burst = max_burst;
+    profile->mean_burst = (double)work / n;
+    profile->var_burst = burst_sq / n - profile->mean_burst * profile->mean_burst;
+    profile->min_gap = min_gap;
+    profile->max_gap = max_gap;
+    if (n > 1) {
+        profile->mean_gap = (double)gaps / (n - 1);
+        profile->var_gap = gap_sq / (n - 1) - profile->mean_gap * profile->mean_gap;
+    }
+    profile->first_arrival = p[0].arrival;
+    profile->last_arrival = last_arrival;
+    profile->sorted = !unsorted;
+    profile->all_zero_arrivals = !nonzero;
+    profile->ids_increasing = !ids_out_of_order;
+    profile->negative_bursts = negative_bursts;
+    profile->negative_arrivals = negative_arrivals;
+}
+
+static const Process *sort_table;
+
+static int compareArrivalStable(const void *a, const void *b) {
+    int x = *(const int *)a, y = *(const int *)b;
+    int ax = sort_table[x].arrival, ay = sort_table[y].arrival;
+    if (ax != ay)
+        return (ax > ay) - (ax < ay);
+    return (x > y) - (x < y);
+}
+
+static int compareInt(const void *a, const void *b) {
+    int x = *(const int *)a, y = *(const int *)b;
+    return (x > y) - (x < y);
+}
+
+/**
+ * @brief Rejects invalid traces and sorts out-of-order ones.
+ *
+ * @param processes An array of Process structures.
+ * @param n The number of processes in the array.
+ * @param profile The profile of the array, updated if the array is reordered.
+ *
+ * @details
+ * Negative bursts or arrivals and duplicate ids are fatal.  Duplicates can only
+ * exist when ids are not strictly increasing, so the sort-based check runs only
+ * for such traces.  Processes arriving out of order are stably sorted by arrival,
+ * since every engine walks the table in arrival order.
+ */
+void validateTrace(Process processes[], int n, TraceProfile *profile) {
+    if (profile->negative_bursts || profile->negative_arrivals) {
+        for (int i = 0; i < n; i++) {
+            if (processes[i].burst < 0 || processes[i].arrival < 0) {
+                fprintf(stderr, "Invalid trace: process %d has a negative %s (%d processes affected)\n",
+                        processes[i].id, processes[i].burst < 0 ? "burst" : "arrival",
+                        profile->negative_bursts + profile->negative_arrivals);
+                exit(EXIT_FAILURE);
+            }
+        }
+    }
+
+    if (!profile->ids_increasing) {
+        int *ids = malloc(n * sizeof(int));
+        if (!ids) {
+            perror("Error allocating id table");
+            exit(EXIT_FAILURE);
+        }
+        for (int i = 0; i < n; i++)
+            ids[i] = processes[i].id;
+        qsort(ids, n, sizeof(int), compareInt);
+        for (int i = 1; i < n; i++) {
+            if (ids[i] == ids[i - 1]) {
+                fprintf(stderr, "Invalid trace: duplicate process id %d\n", ids[i]);
+                exit(EXIT_FAILURE);
+            }
+        }
+        free(ids);
+    }
+
+    if (!profile->sorted) {
+        int *order = malloc(n * sizeof(int));
+        Process *sorted = malloc(n * sizeof(Process));
+        if (!order || !sorted) {
+            perror("Error allocating sort buffer");
+            exit(EXIT_FAILURE);
+        }
+        for (int i = 0; i < n; i++)
+            order[i] = i;
+        sort_table = processes;
+        qsort(order, n, sizeof(int), compareArrivalStable);
+        for (int i = 0; i < n; i++)
+            sorted[i] = processes[order[i]];
+        memcpy(processes, sorted, n * sizeof(Process));
+        free(sorted);
+        free(order);
+
+        fprintf(stderr, "Warning: trace is not sorted by arrival, processes were reordered\n");
+        profileTrace(processes, n, profile);
+    }
+}
+
+/**
+ * @brief Prints a trace profile.
+ */
+void printTraceProfile(const TraceProfile *profile, FILE *out) {
+    fprintf(out, "Trace Statistics:\n");
+    fprintf(out, "Processes: %d\n", profile->count);
+    fprintf(out, "Total Work: %lld\n", profile->total_work);
+    fprintf(out, "Burst: min %d, max %d, mean %.2f, variance %.2f\n", profile->min_burst,
+            profile->max_burst, profile->mean_burst, profile->var_burst);
+    fprintf(out, "Inter-arrival: min %lld, max %lld, mean %.2f, variance %.2f\n", profile->min_gap,
+            profile->max_gap, profile->mean_gap, profile->var_gap);
+    fprintf(out, "Arrivals: %d to %d%s%s\n", profile->first_arrival, profile->last_arrival,
+            profile->sorted ? ", sorted" : ", unsorted",
+            profile->all_zero_arrivals ? ", all at time 0" : "");
+    fprintf(out, "Ids: %s\n\n", profile->ids_increasing ? "strictly increasing" : "unordered");
+}
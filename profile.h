@@ -0,0 +1,35 @@
+#ifndef PROFILE_H
+#define PROFILE_H
+
+#include <stdio.h>
+#include "process.h"
+
+/**
+ * @brief Summary of a trace, computed in one pass right after loading.
+ *
+ * Inter-arrival statistics cover the n - 1 gaps between consecutive processes in
+ * table order; a negative gap means the trace is not sorted by arrival.
+ */
+typedef struct {
+    int count;                  ///< Number of processes.
+    long long total_work;       ///< Sum of all bursts.
+    int min_burst, max_burst;   ///< Burst range.
+    double mean_burst;          ///< Mean burst.
+    double var_burst;           ///< Burst variance.
+    long long min_gap, max_gap; ///< Inter-arrival range.
+    double mean_gap;            ///< Mean inter-arrival time.
+    double var_gap;             ///< Inter-arrival variance.
+    int first_arrival;          ///< Arrival of the first process.
+    int last_arrival;           ///< Latest arrival.
+    int sorted;                 ///< Non-zero if arrivals are non-decreasing.
+    int all_zero_arrivals;      ///< Non-zero if every process arrives at time 0.
+    int ids_increasing;         ///< Non-zero if ids are strictly increasing.
+    int negative_bursts;        ///< Processes with a negative burst.
+    int negative_arrivals;      ///< Processes with a negative arrival.
+} TraceProfile;
+
+void profileTrace(const Process processes[], int n, TraceProfile *profile);
+void validateTrace(Process processes[], int n, TraceProfile *profile);
+void printTraceProfile(const TraceProfile *profile, FILE *out);
+
+#endif
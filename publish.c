@@ -0,0 +1,280 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include "publish.h"
+
+/**
+ * @brief Creates (or reuses) a POSIX shared-memory segment and maps it.
+ *
+ * @param publisher The publisher to initialize.
+ * @param name The segment name, e.g. "/procesos".
+ */
+void openPublisher(Publisher *publisher, const char *name) {
+    int fd = shm_open(name, O_CREAT | O_RDWR, 0644);
+    if (fd < 0 || ftruncate(fd, sizeof(PublishedResults)) != 0) {
+        perror("Error creating shared memory segment");
+        exit(EXIT_FAILURE);
+    }
+    publisher->shm = mmap(NULL, sizeof(PublishedResults), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (publisher->shm == MAP_FAILED) {
+        perror("Error mapping shared memory segment");
+        exit(EXIT_FAILURE);
+    }
+
+    // A publisher that died mid-write leaves seq odd; either way start from an odd value.
+    PublishedResults *shm = publisher->shm;
+    uint64_t seq = atomic_load_explicit(&shm->seq, memory_order_relaxed) | 1;
+    atomic_store_explicit(&shm->seq, seq, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+    shm->magic = PUBLISH_MAGIC;
+    shm->version = PUBLISH_VERSION;
+    shm->schedules = 0;
+    shm->samples = 0;
+    shm->series_algorithm[0] = '\0';
+    atomic_store_explicit(&shm->seq, seq + 1, memory_order_release);
+}
+
+/**
+ * @brief Unmaps the segment.  The segment itself stays for dashboards to read.
+ */
+void closePublisher(Publisher *publisher) {
+    munmap(publisher->shm, sizeof(PublishedResults));
+    publisher->shm = NULL;
+}
+
+/**
+ * @brief Makes seq odd before the publisher modifies the segment.
+ */
+static void beginWrite(PublishedResults *shm) {
+    uint64_t seq = atomic_load_explicit(&shm->seq, memory_order_relaxed);
+    atomic_store_explicit(&shm->seq, seq + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+}
+
+/**
+ * @brief Makes seq even again once the segment is consistent.
+ */
+static void endWrite(PublishedResults *shm) {
+    uint64_t seq = atomic_load_explicit(&shm->seq, memory_order_relaxed);
+    atomic_store_explicit(&shm->seq, seq + 1, memory_order_release);
+}
+
+/**
+ * @brief Exits if an algorithm name does not fit the name fields of the segment.
+ */
+static void checkName(const char *algorithm) {
+    if (strlen(algorithm) >= PUBLISH_NAME_LEN) {
+        fprintf(stderr, "Error publishing metrics: algorithm name %s is longer than %d characters\n", algorithm,
+                PUBLISH_NAME_LEN - 1);
+        exit(EXIT_FAILURE);
+    }
+}
+
+/**
+ * @brief Returns the slot of a schedule, or the next free one if it is new.
+ *
+ * @details
+ * Only the publisher writes the segment, so the lookup needs no write section.
+ * A full table is fatal, checked before the write begins so that readers never
+ * see the segment left mid-write.
+ */
+static int scheduleSlot(const PublishedResults *shm, const char *algorithm, int quantum) {
+    for (int i = 0; i < shm->schedules; i++)
+        if (strcmp(shm->metrics[i].algorithm, algorithm) == 0 && shm->metrics[i].quantum == quantum)
+            return i;
+    if (shm->schedules == PUBLISH_MAX_SCHEDULES) {
+        fprintf(stderr, "Error publishing metrics: no room for schedule %s, the segment holds %d\n", algorithm,
+                PUBLISH_MAX_SCHEDULES);
+        exit(EXIT_FAILURE);
+    }
+    return shm->schedules;
+}
+
+/**
+ * @brief Publishes the latest aggregate metrics of a schedule.
+ */
+void publishMetrics(Publisher *publisher, const char *algorithm, int quantum, int processes,
+                    float avg_tat, float avg_rt, float throughput) {
+    PublishedResults *shm = publisher->shm;
+    checkName(algorithm);
+    int slot = scheduleSlot(shm, algorithm, quantum);
+    beginWrite(shm);
+    if (slot == shm->schedules)
+        shm->schedules++;
+    PublishedMetrics *m = &shm->metrics[slot];
+    strcpy(m->algorithm, algorithm);
+    m->quantum = quantum;
+    m->processes = processes;
+    m->avg_tat = avg_tat;
+    m->avg_rt = avg_rt;
+    m->throughput = throughput;
+    endWrite(shm);
+}
+
+/**
+ * @brief Appends one sample to the time series ring.
+ *
+ * @details
+ * Samples of a different schedule than the current series restart the series.
+ */
+void publishSample(Publisher *publisher, const char *algorithm, int time, int completed,
+                   float avg_tat, float avg_rt) {
+    PublishedResults *shm = publisher->shm;
+    checkName(algorithm);
+    beginWrite(shm);
+    if (strcmp(shm->series_algorithm, algorithm) != 0) {
+        strcpy(shm->series_algorithm, algorithm);
+        shm->samples = 0;
+    }
+    PublishedSample *s = &shm->series[shm->samples % PUBLISH_SERIES_LEN];
+    s->time = time;
+    s->completed = completed;
+    s->avg_tat = avg_tat;
+    s->avg_rt = avg_rt;
+    shm->samples++;
+    endWrite(shm);
+}
+
+/**
+ * @brief Replaces the time series with the completion curve of a finished schedule.
+ *
+ * @param publisher The publisher.
+ * @param algorithm Short algorithm name of the schedule.
+ * @param processes An array of Process structures with start and finish times set.
+ * @param n The number of processes in the array.
+ *
+ * @details
+ * The makespan is split into at most PUBLISH_SERIES_LEN equal bins.  One pass buckets the
+ * completions by finish time and a prefix sum over the bins gives, for the end of
+ * each bin, the processes completed so far and their average metrics.
+ */
+void publishCompletionCurve(Publisher *publisher, const char *algorithm, const Process processes[], int n) {
+    static long long count[PUBLISH_SERIES_LEN], tat[PUBLISH_SERIES_LEN], rt[PUBLISH_SERIES_LEN];
+    int makespan = 1;
+    for (int i = 0; i < n; i++)
+        if (processes[i].finish_time > makespan)
+            makespan = processes[i].finish_time;
+
+    int bins = makespan < PUBLISH_SERIES_LEN ? makespan + 1 : PUBLISH_SERIES_LEN;
+    memset(count, 0, sizeof(count));
+    memset(tat, 0, sizeof(tat));
+    memset(rt, 0, sizeof(rt));
+    for (int i = 0; i < n; i++) {
+        int bin = (int)((long long)processes[i].finish_time * bins / (makespan + 1LL));
+        count[bin]++;
+        tat[bin] += processes[i].finish_time - processes[i].arrival;
+        rt[bin] += processes[i].start_time - processes[i].arrival;
+    }
+
+    PublishedResults *shm = publisher->shm;
+    long long done = 0, total_tat = 0, total_rt = 0;
+    checkName(algorithm);
+    beginWrite(shm);
+    strcpy(shm->series_algorithm, algorithm);
+    for (int b = 0; b < bins; b++) {
+        done += count[b];
+        total_tat += tat[b];
+        total_rt += rt[b];
+        shm->series[b].time = (int)(((b + 1LL) * (makespan + 1LL) - 1) / bins); // Last finish time in bin b
+        shm->series[b].completed = (int)done;
+        shm->series[b].avg_tat = done ? (float)total_tat / done : 0;
+        shm->series[b].avg_rt = done ? (float)total_rt / done : 0;
+    }
+    shm->samples = bins;
+    endWrite(shm);
+}
+
+/**
+ * @brief Copies a consistent snapshot of a mapped segment.
+ *
+ * @param shm The mapped segment.
+ * @param snapshot Receives the copy.
+ * @return 0 on success, -1 if no consistent copy was taken in PUBLISH_READ_TIMEOUT_MS.
+ *
+ * @details
+ * Lock-free: the copy is retried until it was taken while no write was in
+ * progress.  The first PUBLISH_READ_SPINS attempts spin without a system call;
+ * after that the reader sleeps a millisecond between attempts, and gives up at
+ * the timeout, since a publisher that died mid-write leaves seq odd for good.
+ */
+int readPublished(const PublishedResults *shm, PublishedResults *snapshot) {
+    const struct timespec pause = {0, 1000000};
+    for (long attempt = 0; attempt < PUBLISH_READ_SPINS + PUBLISH_READ_TIMEOUT_MS; attempt++) {
+        if (attempt >= PUBLISH_READ_SPINS)
+            nanosleep(&pause, NULL);
+        uint64_t before = atomic_load_explicit((_Atomic uint64_t *)&shm->seq, memory_order_acquire);
+        if (before & 1)
+            continue;
+        memcpy(snapshot, (const void *)shm, sizeof(*snapshot));
+        atomic_thread_fence(memory_order_acquire);
+        uint64_t after = atomic_load_explicit((_Atomic uint64_t *)&shm->seq, memory_order_relaxed);
+        if (before == after)
+            return 0;
+    }
+    return -1;
+}
+
+#define PRINTED_SAMPLES 10 ///< Most recent samples shown by printPublished.
+
+/**
+ * @brief Prints a snapshot of a published segment, as a dashboard would read it.
+ *
+ * @param name The segment name.
+ * @return EXIT_SUCCESS, or EXIT_FAILURE if the segment cannot be read.
+ */
+int printPublished(const char *name) {
+    int fd = shm_open(name, O_RDONLY, 0);
+    if (fd < 0) {
+        perror("Error opening shared memory segment");
+        return EXIT_FAILURE;
+    }
+    const PublishedResults *shm = mmap(NULL, sizeof(PublishedResults), PROT_READ, MAP_SHARED, fd, 0);
+    close(fd);
+    if (shm == MAP_FAILED) {
+        perror("Error mapping shared memory segment");
+        return EXIT_FAILURE;
+    }
+
+    PublishedResults *snapshot = malloc(sizeof(PublishedResults));
+    if (!snapshot) {
+        perror("Error allocating snapshot");
+        exit(EXIT_FAILURE);
+    }
+    int stuck = readPublished(shm, snapshot);
+    munmap((void *)shm, sizeof(PublishedResults));
+    if (stuck) {
+        fprintf(stderr, "%s stayed mid-write for %d ms; its publisher may have died\n", name,
+                PUBLISH_READ_TIMEOUT_MS);
+        free(snapshot);
+        return EXIT_FAILURE;
+    }
+
+    if (snapshot->magic != PUBLISH_MAGIC || snapshot->version != PUBLISH_VERSION) {
+        fprintf(stderr, "%s is not a results segment of this version\n", name);
+        free(snapshot);
+        return EXIT_FAILURE;
+    }
+
+    for (int i = 0; i < snapshot->schedules; i++) {
+        const PublishedMetrics *m = &snapshot->metrics[i];
+        printf("%s (quantum %d): %d processes, TAT %.2f, RT %.2f, throughput %.2f processes/ut\n",
+               m->algorithm, m->quantum, m->processes, m->avg_tat, m->avg_rt, m->throughput);
+    }
+
+    uint64_t samples = snapshot->samples;
+    uint64_t first = samples > PRINTED_SAMPLES ? samples - PRINTED_SAMPLES : 0;
+    if (samples > 0)
+        printf("Series %s (%llu samples):\n", snapshot->series_algorithm, (unsigned long long)samples);
+    for (uint64_t s = first; s < samples; s++) {
+        const PublishedSample *p = &snapshot->series[s % PUBLISH_SERIES_LEN];
+        printf("  t=%d completed=%d TAT=%.2f RT=%.2f\n", p->time, p->completed, p->avg_tat, p->avg_rt);
+    }
+
+    free(snapshot);
+    return EXIT_SUCCESS;
+}
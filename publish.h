@@ -0,0 +1,73 @@
+#ifndef PUBLISH_H
+#define PUBLISH_H
+
+#include <stdint.h>
+#include <stdatomic.h>
+#include "process.h"
+
+#define PUBLISH_MAGIC 0x50524353u   ///< "PRCS", marks an initialized segment.
+#define PUBLISH_VERSION 2u          ///< Layout version of PublishedResults.
+#define PUBLISH_MAX_SCHEDULES 32    ///< Schedules kept in one segment, more than one run reports.
+#define PUBLISH_NAME_LEN 16         ///< Room for an algorithm name and its terminator.
+#define PUBLISH_SERIES_LEN 1024     ///< Samples kept in the time series ring.
+#define PUBLISH_READ_SPINS 1000     ///< Copy attempts before a reader starts sleeping between them.
+#define PUBLISH_READ_TIMEOUT_MS 1000 ///< Time a reader waits for a write section to end.
+
+/**
+ * @brief Aggregate metrics of one schedule as seen by dashboards.
+ */
+typedef struct {
+    char algorithm[PUBLISH_NAME_LEN]; ///< Short algorithm name ("fcfs", "rr", ...).
+    int quantum;        ///< Time quantum, 0 for non-preemptive algorithms.
+    int processes;      ///< Number of completed processes.
+    float avg_tat;      ///< Average turnaround time.
+    float avg_rt;       ///< Average response time.
+    float throughput;   ///< Throughput in processes per unit of time.
+} PublishedMetrics;
+
+/**
+ * @brief One point of the published time series.
+ */
+typedef struct {
+    int time;           ///< Simulated time of the sample.
+    int completed;      ///< Processes completed by that time.
+    float avg_tat;      ///< Average turnaround time of those processes.
+    float avg_rt;       ///< Average response time of those processes.
+} PublishedSample;
+
+/**
+ * @brief Layout of the shared-memory segment.
+ *
+ * Guarded by a seqlock: seq is odd while the publisher is writing.  A reader
+ * copies the segment and retries if seq was odd or changed meanwhile, so it
+ * never blocks the publisher and needs no system call once the segment is mapped.
+ */
+typedef struct {
+    uint32_t magic;                 ///< PUBLISH_MAGIC once initialized.
+    uint32_t version;               ///< PUBLISH_VERSION.
+    _Atomic uint64_t seq;           ///< Seqlock sequence number.
+    int schedules;                  ///< Valid entries of metrics.
+    PublishedMetrics metrics[PUBLISH_MAX_SCHEDULES]; ///< Latest metrics per schedule.
+    char series_algorithm[PUBLISH_NAME_LEN]; ///< Schedule the time series belongs to.
+    uint64_t samples;               ///< Samples ever appended; the ring holds the last ones.
+    PublishedSample series[PUBLISH_SERIES_LEN]; ///< Time series ring.
+} PublishedResults;
+
+/**
+ * @brief Publisher side of a segment.
+ */
+typedef struct {
+    PublishedResults *shm;   ///< Mapped segment.
+} Publisher;
+
+void openPublisher(Publisher *publisher, const char *name);
+void closePublisher(Publisher *publisher);
+void publishMetrics(Publisher *publisher, const char *algorithm, int quantum, int processes,
+                    float avg_tat, float avg_rt, float throughput);
+void publishSample(Publisher *publisher, const char *algorithm, int time, int completed,
+                   float avg_tat, float avg_rt);
+void publishCompletionCurve(Publisher *publisher, const char *algorithm, const Process processes[], int n);
+int readPublished(const PublishedResults *shm, PublishedResults *snapshot);
+int printPublished(const char *name);
+
+#endif
@@ -0,0 +1,160 @@
+#include <stdlib.h>
+#include <string.h>
+#include "rangeindex.h"
+
+/**
+ * @brief Builds the prefix-sum index over a completed process table.
+ *
+ * @param processes An array of Process structures with start and finish times set.
+ * @param n The number of processes in the array.
+ * @param index The index to fill. Release it with freeRangeIndex.
+ *
+ * @details
+ * Turnaround, response and waiting time are derived and accumulated in one
+ * fused pass, so the table is streamed through the cache only once. The loop
+ * body has no branches other than the id order check, which the compiler turns
+ * into a conditional move.
+ */
+void buildRangeIndex(const Process processes[], int n, RangeIndex *index) {
+    index->n = n;
+    index->tat = malloc((n + 1) * sizeof(long long));
+    index->rt = malloc((n + 1) * sizeof(long long));
+    index->wait = malloc((n + 1) * sizeof(long long));
+    if (!index->tat || !index->rt || !index->wait) {
+        perror("Error allocating range index");
+        exit(EXIT_FAILURE);
+    }
+
+    long long tat = 0, rt = 0, wait = 0;
+    int unsorted = 0;
+    index->tat[0] = index->rt[0] = index->wait[0] = 0;
+
+    for (int i = 0; i < n; i++) {
+        int t = processes[i].finish_time - processes[i].arrival;
+        tat += t;
+        rt += processes[i].start_time - processes[i].arrival;
+        wait += t - processes[i].burst; // Waiting Time = TAT - burst
+        index->tat[i + 1] = tat;
+        index->rt[i + 1] = rt;
+        index->wait[i + 1] = wait;
+        unsorted |= (i > 0 && processes[i].id <= processes[i - 1].id);
+    }
+    index->ids_sorted = !unsorted;
+}
+
+/**
+ * @brief Releases the arrays owned by a range index.
+ *
+ * @param index The index to release.
+ */
+void freeRangeIndex(RangeIndex *index) {
+    free(index->tat);
+    free(index->rt);
+    free(index->wait);
+    memset(index, 0, sizeof(*index));
+}
+
+/**
+ * @brief Computes the average metrics of the table positions [lo, hi) in O(1).
+ *
+ * @param index A built range index.
+ * @param lo First position of the range (inclusive).
+ * @param hi Last position of the range (exclusive).
+ * @param avg_tat A pointer to store the average turnaround time.
+ * @param avg_rt A pointer to store the average response time.
+ * @param avg_wait A pointer to store the average waiting time.
+ * @return The number of processes in the range, 0 if the range is empty.
+ */
+int rangeMetrics(const RangeIndex *index, int lo, int hi, float *avg_tat, float *avg_rt, float *avg_wait) {
+    if (lo < 0)
+        lo = 0;
+    if (hi > index->n)
+        hi = index->n;
+    if (hi <= lo) {
+        *avg_tat = *avg_rt = *avg_wait = 0;
+        return 0;
+    }
+
+    int count = hi - lo;
+    *avg_tat = (float)(index->tat[hi] - index->tat[lo]) / count;
+    *avg_rt = (float)(index->rt[hi] - index->rt[lo]) / count;
+    *avg_wait = (float)(index->wait[hi] - index->wait[lo]) / count;
+    return count;
+}
+
+/**
+ * @brief Returns the first position whose key is >= value (or > value if upper is set).
+ */
+static int searchKey(const Process processes[], int n, int by_id, int value, int upper) {
+    int lo = 0, hi = n;
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        int key = by_id ? processes[mid].id : processes[mid].arrival;
+        if (key < value || (upper && key == value))
+            lo = mid + 1;
+        else
+            hi = mid;
+    }
+    return lo;
+}
+
+/**
+ * @brief Answers a file of range queries against a built index.
+ *
+ * @param filename The name of the file containing the queries.
+ * @param processes The table the index was built from.
+ * @param index A built range index.
+ * @param out The stream the answers are written to.
+ * @return The number of queries answered.
+ *
+ * @details
+ * Each line holds "kind lo hi" with inclusive bounds, where kind is one of:
+ *  - index: positions in the process table (0-based);
+ *  - id: process ids, which must be increasing in table order;
+ *  - arrival: an arrival time window, relying on the table being sorted by arrival.
+ * Id and arrival bounds are mapped to positions with a binary search, after which
+ * the query costs O(1). Blank lines and lines starting with '#' are ignored.
+ */
+int runRangeQueries(const char *filename, const Process processes[], const RangeIndex *index, FILE *out) {
+    FILE *file = fopen(filename, "r");
+    if (!file) {
+        perror("Error opening query file");
+        exit(EXIT_FAILURE);
+    }
+
+    char line[256];
+    int answered = 0;
+
+    while (fgets(line, sizeof(line), file)) {
+        char kind[16];
+        int lo, hi, first, last;
+        if (line[0] == '#' || sscanf(line, "%15s %d %d", kind, &lo, &hi) != 3)
+            continue;
+
+        if (strcmp(kind, "index") == 0) {
+            first = lo;
+            last = hi < index->n ? hi + 1 : index->n; // hi + 1 would overflow at INT_MAX.
+        } else if (strcmp(kind, "id") == 0) {
+            if (!index->ids_sorted) {
+                fprintf(out, "id %d %d: ids are not increasing, query skipped\n", lo, hi);
+                continue;
+            }
+            first = searchKey(processes, index->n, 1, lo, 0);
+            last = searchKey(processes, index->n, 1, hi, 1);
+        } else if (strcmp(kind, "arrival") == 0) {
+            first = searchKey(processes, index->n, 0, lo, 0);
+            last = searchKey(processes, index->n, 0, hi, 1);
+        } else {
+            fprintf(out, "%s %d %d: unknown query kind\n", kind, lo, hi);
+            continue;
+        }
+
+        float tat, rt, wait;
+        int count = rangeMetrics(index, first, last, &tat, &rt, &wait);
+        fprintf(out, "%s %d %d: n=%d TAT=%.2f RT=%.2f WT=%.2f\n", kind, lo, hi, count, tat, rt, wait);
+        answered++;
+    }
+
+    fclose(file);
+    return answered;
+}
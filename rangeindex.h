@@ -0,0 +1,26 @@
+#ifndef RANGEINDEX_H
+#define RANGEINDEX_H
+
+#include <stdio.h>
+#include "process.h"
+
+/**
+ * @brief Prefix sums of per-process metrics over a completed process table.
+ *
+ * Entry i of each array holds the sum over processes [0, i), so every array
+ * has n + 1 entries and the sum over [lo, hi) is a single subtraction.
+ */
+typedef struct {
+    int n;               ///< Number of processes covered by the index.
+    int ids_sorted;      ///< Non-zero if ids are strictly increasing in table order.
+    long long *tat;      ///< Prefix sums of turnaround time.
+    long long *rt;       ///< Prefix sums of response time.
+    long long *wait;     ///< Prefix sums of waiting time.
+} RangeIndex;
+
+void buildRangeIndex(const Process processes[], int n, RangeIndex *index);
+void freeRangeIndex(RangeIndex *index);
+int rangeMetrics(const RangeIndex *index, int lo, int hi, float *avg_tat, float *avg_rt, float *avg_wait);
+int runRangeQueries(const char *filename, const Process processes[], const RangeIndex *index, FILE *out);
+
+#endif
@@ -0,0 +1,14 @@
+#include "rng.h"
+
+/**
+ * @brief xorshift64* generator: fast, and reproducible for a given seed.
+ *
+ * @param state The generator state, updated in place; must not be 0.
+ * @return The next 64-bit value of the stream.
+ */
+unsigned long long nextRandom(unsigned long long *state) {
+    *state ^= *state >> 12;
+    *state ^= *state << 25;
+    *state ^= *state >> 27;
+    return *state * 0x2545F4914F6CDD1DULL;
+}
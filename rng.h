@@ -0,0 +1,6 @@
+#ifndef RNG_H
+#define RNG_H
+
+unsigned long long nextRandom(unsigned long long *state);
+
+#endif
@@ -0,0 +1,242 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <limits.h>
+#include <string.h>
+#include <strings.h>
+#include "schema.h"
+#include "groupby.h"
+
+/**
+ * @brief Header names accepted for each field, compared case-insensitively.
+ */
+static const char *const field_aliases[FIELD_COUNT][4] = {
+    [FIELD_ID] = {"id_proceso", "id", "pid", NULL},
+    [FIELD_ARRIVAL] = {"tiempo_llegada", "llegada", "arrival", NULL},
+    [FIELD_BURST] = {"duracion", "burst", "duration", NULL},
+    [FIELD_CLASS] = {"clase", "class", NULL},
+    [FIELD_PRIORITY] = {"prioridad", "priority", NULL},
+    [FIELD_DEADLINE] = {"plazo", "deadline", NULL},
+    [FIELD_WEIGHT] = {"peso", "weight", NULL},
+    [FIELD_GROUP] = {"grupo", "group", NULL},
+    [FIELD_CORES] = {"nucleos", "cores", NULL},
+};
+
+static int isBlank(char c) {
+    return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+/**
+ * @brief Returns the canonical (English) name of a field.
+ */
+const char *fieldName(TraceField field) {
+    static const char *const names[FIELD_COUNT] = {"id", "arrival", "burst", "class",
+                                                   "priority", "deadline", "weight", "group", "cores"};
+    return names[field];
+}
+
+/**
+ * @brief Returns the field named by the header token [s, s + len), or -1.
+ */
+static int lookupField(const char *s, size_t len) {
+    for (int f = 0; f < FIELD_COUNT; f++)
+        for (int a = 0; field_aliases[f][a]; a++)
+            if (strlen(field_aliases[f][a]) == len && strncasecmp(field_aliases[f][a], s, len) == 0)
+                return f;
+    return -1;
+}
+
+/**
+ * @brief Builds the positional schema "id arrival burst [class]" of headerless traces.
+ *
+ * @param needed Bitmask of FIELD_BIT values the run uses.
+ * @param schema Receives the schema.
+ */
+void defaultSchema(unsigned needed, TraceSchema *schema) {
+    memset(schema->field_of, -1, sizeof(schema->field_of));
+    schema->field_of[0] = FIELD_ID;
+    schema->field_of[1] = FIELD_ARRIVAL;
+    schema->field_of[2] = FIELD_BURST;
+    schema->last_column = 2;
+    schema->present = FIELDS_REQUIRED | FIELD_BIT(FIELD_CLASS);
+    if (needed & FIELD_BIT(FIELD_CLASS)) {
+        schema->field_of[3] = FIELD_CLASS;
+        schema->last_column = 3;
+    }
+}
+
+/**
+ * @brief Builds the column map of a trace from its header line [header, end).
+ *
+ * @param header The header line.
+ * @param end One past its last character.
+ * @param needed Bitmask of FIELD_BIT values the run uses.  Required fields are
+ *               always read.
+ * @param schema Receives the schema.
+ * @return 1 if the header names the columns, 0 if it does not and the positional
+ *         schema of defaultSchema is used instead.
+ *
+ * @details
+ * Columns may appear in any order and unknown names are ignored.  A header that
+ * names some columns but lacks id, arrival or burst, or that names a field twice,
+ * is a fatal error.
+ */
+int parseSchema(const char *header, const char *end, unsigned needed, TraceSchema *schema) {
+    signed char field_of[SCHEMA_MAX_COLUMNS];
+    unsigned present = 0;
+    int columns = 0, named = 0;
+
+    memset(field_of, -1, sizeof(field_of));
+    for (const char *s = header; s < end;) {
+        while (s < end && isBlank(*s))
+            s++;
+        if (s == end)
+            break;
+        const char *token = s;
+        while (s < end && !isBlank(*s))
+            s++;
+
+        int field = lookupField(token, (size_t)(s - token));
+        if (field >= 0) {
+            named = 1;
+            if (present & FIELD_BIT(field)) {
+                fprintf(stderr, "Invalid trace header: column '%s' appears twice\n", fieldName(field));
+                exit(EXIT_FAILURE);
+            }
+            if (columns >= SCHEMA_MAX_COLUMNS) {
+                fprintf(stderr, "Invalid trace header: column '%.*s' is past the first %d columns\n",
+                        (int)(s - token), token, SCHEMA_MAX_COLUMNS);
+                exit(EXIT_FAILURE);
+            }
+            present |= FIELD_BIT(field);
+            field_of[columns] = (signed char)field;
+        }
+        columns++;
+    }
+
+    if (!named) {
+        defaultSchema(needed, schema);
+        return 0;
+    }
+    for (int f = FIELD_ID; f <= FIELD_BURST; f++) {
+        if (!(present & FIELD_BIT(f))) {
+            fprintf(stderr, "Invalid trace header: no %s column\n", fieldName(f));
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    needed |= FIELDS_REQUIRED;
+    schema->present = present;
+    schema->last_column = 0;
+    for (int c = 0; c < SCHEMA_MAX_COLUMNS; c++) {
+        if (field_of[c] >= 0 && (needed & FIELD_BIT(field_of[c])))
+            schema->last_column = c;
+        else
+            field_of[c] = -1;
+    }
+    memcpy(schema->field_of, field_of, sizeof(field_of));
+    return 1;
+}
+
+/**
+ * @brief Parses a decimal int at *s, skipping leading blanks.
+ *
+ * @return 1 on success, 0 if no number starts there, -1 if the number does not fit in an int.
+ */
+static int parseInt(const char **s, const char *end, int *value) {
+    const char *p = *s;
+    while (p < end && isBlank(*p))
+        p++;
+    int negative = p < end && *p == '-';
+    if (p < end && (*p == '-' || *p == '+'))
+        p++;
+    if (p == end || *p < '0' || *p > '9')
+        return 0;
+    long long v = 0, limit = negative ? -(long long)INT_MIN : INT_MAX;
+    int overflow = 0;
+    while (p < end && *p >= '0' && *p <= '9') {
+        v = v * 10 + (*p++ - '0');
+        if (v > limit) {
+            overflow = 1;
+            v = limit; // Keeps v small while the rest of the digits are skipped.
+        }
+    }
+    *s = p;
+    if (overflow)
+        return -1;
+    *value = (int)(negative ? -v : v);
+    return 1;
+}
+
+/**
+ * @brief Parses one trace line [s, end) according to a schema.
+ *
+ * @param schema The column map of the trace.
+ * @param s The line.
+ * @param end One past its last character.
+ * @param line_number The number of the line in its trace, for error messages.
+ * @param process The Process structure to fill.
+ * @return 1 if the line holds a process, 0 if it should be skipped.
+ *
+ * @details
+ * Only the columns up to schema->last_column are looked at; skipped columns are
+ * stepped over without conversion.  A line missing a required field is skipped,
+ * a missing optional field keeps its default, and an invalid class or a number
+ * outside the range of int is a fatal error.  The remaining field is initialized to the burst time, and start_time
+ * and finish_time are initialized to -1.
+ */
+int parseRecord(const TraceSchema *schema, const char *s, const char *end, int line_number, Process *process) {
+    int values[FIELD_COUNT] = {[FIELD_PRIORITY] = DEFAULT_PRIORITY, [FIELD_DEADLINE] = NO_DEADLINE,
+                               [FIELD_WEIGHT] = DEFAULT_WEIGHT, [FIELD_CORES] = DEFAULT_CORES};
+    unsigned found = 0;
+
+    for (int c = 0; c <= schema->last_column; c++) {
+        int field = schema->field_of[c];
+        if (field < 0 || field == FIELD_CLASS) {
+            while (s < end && isBlank(*s))
+                s++;
+            if (s == end)
+                break;
+            const char *token = s;
+            while (s < end && !isBlank(*s))
+                s++;
+            if (field == FIELD_CLASS) {
+                char name[32];
+                size_t len = (size_t)(s - token) < sizeof(name) - 1 ? (size_t)(s - token) : sizeof(name) - 1;
+                memcpy(name, token, len);
+                name[len] = '\0';
+                if ((values[FIELD_CLASS] = parseClass(name)) < 0) {
+                    fprintf(stderr, "Invalid job class '%s' for process %d\n", name, values[FIELD_ID]);
+                    exit(EXIT_FAILURE);
+                }
+                found |= FIELD_BIT(FIELD_CLASS);
+            }
+        } else {
+            int parsed = parseInt(&s, end, &values[field]);
+            if (parsed < 0) {
+                fprintf(stderr, "Invalid trace line %d: %s is out of range\n", line_number,
+                        fieldName((TraceField)field));
+                exit(EXIT_FAILURE);
+            }
+            if (!parsed)
+                break;
+            found |= FIELD_BIT(field);
+        }
+    }
+
+    if ((found & FIELDS_REQUIRED) != FIELDS_REQUIRED)
+        return 0;
+
+    process->id = values[FIELD_ID];
+    process->arrival = values[FIELD_ARRIVAL];
+    process->burst = values[FIELD_BURST];
+    process->remaining = values[FIELD_BURST];
+    process->start_time = -1;
+    process->finish_time = -1;
+    process->cls = values[FIELD_CLASS];
+    process->priority = values[FIELD_PRIORITY];
+    process->deadline = values[FIELD_DEADLINE];
+    process->weight = values[FIELD_WEIGHT];
+    process->group = values[FIELD_GROUP];
+    process->cores = values[FIELD_CORES];
+    return 1;
+}
@@ -0,0 +1,49 @@
+#ifndef SCHEMA_H
+#define SCHEMA_H
+
+#include "process.h"
+
+/**
+ * @brief The process attributes a trace column can hold.
+ */
+typedef enum {
+    FIELD_ID,       ///< Process id (required).
+    FIELD_ARRIVAL,  ///< Arrival time (required).
+    FIELD_BURST,    ///< Burst time (required).
+    FIELD_CLASS,    ///< Job class, a name or number accepted by parseClass.
+    FIELD_PRIORITY, ///< Priority, lower is more urgent.
+    FIELD_DEADLINE, ///< Absolute deadline.
+    FIELD_WEIGHT,   ///< Share weight.
+    FIELD_GROUP,    ///< Group id.
+    FIELD_CORES,    ///< Cores used at once.
+    FIELD_COUNT
+} TraceField;
+
+#define FIELD_BIT(field) (1u << (field))
+#define FIELDS_REQUIRED (FIELD_BIT(FIELD_ID) | FIELD_BIT(FIELD_ARRIVAL) | FIELD_BIT(FIELD_BURST))
+#define FIELDS_ALL ((1u << FIELD_COUNT) - 1)
+#define SCHEMA_MAX_COLUMNS 32 ///< Columns past this one are never read.
+
+#define DEFAULT_PRIORITY 0  ///< Priority of processes without a priority column.
+#define NO_DEADLINE (-1)    ///< Deadline of processes without a deadline column.
+#define DEFAULT_WEIGHT 1    ///< Weight of processes without a weight column.
+#define DEFAULT_CORES 1     ///< Cores of processes without a cores column.
+
+/**
+ * @brief Column map of a trace, built from its header line.
+ *
+ * Columns whose field is not needed by the run are mapped to -1 and skipped
+ * without being converted; the fields they hold keep their defaults.
+ */
+typedef struct TraceSchema {
+    signed char field_of[SCHEMA_MAX_COLUMNS]; ///< Field read from each column, -1 to skip it.
+    int last_column;  ///< Last column that is read; the rest of each line is ignored.
+    unsigned present; ///< Fields that have a column in the trace.
+} TraceSchema;
+
+void defaultSchema(unsigned needed, TraceSchema *schema);
+int parseSchema(const char *header, const char *end, unsigned needed, TraceSchema *schema);
+int parseRecord(const TraceSchema *schema, const char *s, const char *end, int line_number, Process *process);
+const char *fieldName(TraceField field);
+
+#endif
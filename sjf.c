@@ -0,0 +1,134 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "sjf.h"
+#include "heap.h"
+#include "groupby.h"
+
+/**
+ * @brief Non-preemptive Shortest Job First with the true bursts known in advance.
+ *
+ * @param processes An array of Process structures sorted by arrival.
+ * @param n The number of processes in the array.
+ *
+ * @details
+ * The oracle baseline: arrived processes wait in a heap keyed by burst (ties go
+ * to the earlier arrival), so every dispatch costs O(log n).
+ */
+void computeSJF(Process processes[], int n) {
+    MinHeap ready;
+    heapInit(&ready, n);
+    int current_time = 0, idx = 0;
+
+    for (int completed = 0; completed < n; completed++) {
+        if (ready.size == 0 && processes[idx].arrival > current_time)
+            current_time = processes[idx].arrival;
+        while (idx < n && processes[idx].arrival <= current_time) {
+            heapPush(&ready, processes[idx].burst, idx);
+            idx++;
+        }
+
+        Process *p = &processes[heapPop(&ready).value];
+        p->start_time = current_time;
+        current_time += p->burst;
+        p->finish_time = current_time;
+        p->remaining = 0;
+    }
+
+    heapFree(&ready);
+}
+
+/**
+ * @brief Non-preemptive SJF that only sees predicted bursts.
+ *
+ * @param processes An array of Process structures sorted by arrival.
+ * @param n The number of processes in the array.
+ * @param alpha Weight of the latest burst: tau' = alpha * burst + (1 - alpha) * tau.
+ * @param stats Receives the prediction error.
+ *
+ * @details
+ * A process's burst is revealed only when it completes, and then updates the
+ * exponential average of its class.  Every waiting process of a class has the
+ * same prediction, so each class keeps a FIFO of arrived processes and a
+ * dispatch picks the non-empty class with the smallest prediction (ties go to
+ * the earlier head arrival): O(MAX_CLASSES) per decision however long the queues
+ * get, and a revised prediction applies to the queued processes at once.  A
+ * class with no completed process yet is predicted by the average over all
+ * classes, which starts at 0, so the first dispatches are FCFS.
+ */
+void computeSJFPredicted(Process processes[], int n, double alpha, PredictionStats *stats) {
+    int *next = malloc(n * sizeof(int));
+    if (n > 0 && !next) {
+        perror("Error allocating SJF queues");
+        exit(EXIT_FAILURE);
+    }
+    int head[MAX_CLASSES], tail[MAX_CLASSES], seen[MAX_CLASSES] = {0};
+    double estimate[MAX_CLASSES], global = 0, abs_error = 0, error = 0;
+    for (int c = 0; c < MAX_CLASSES; c++)
+        head[c] = tail[c] = -1;
+
+    int current_time = 0, idx = 0, queued = 0;
+    for (int completed = 0; completed < n; completed++) {
+        if (queued == 0 && processes[idx].arrival > current_time)
+            current_time = processes[idx].arrival;
+        while (idx < n && processes[idx].arrival <= current_time) {
+            int c = processes[idx].cls;
+            next[idx] = -1;
+            if (tail[c] >= 0)
+                next[tail[c]] = idx;
+            else
+                head[c] = idx;
+            tail[c] = idx++;
+            queued++;
+        }
+
+        int best = -1;
+        double best_estimate = 0;
+        for (int c = 0; c < MAX_CLASSES; c++) {
+            if (head[c] < 0)
+                continue;
+            double e = seen[c] ? estimate[c] : global;
+            if (best < 0 || e < best_estimate || (e == best_estimate && head[c] < head[best])) {
+                best = c;
+                best_estimate = e;
+            }
+        }
+
+        int i = head[best];
+        head[best] = next[i];
+        if (head[best] < 0)
+            tail[best] = -1;
+        queued--;
+
+        Process *p = &processes[i];
+        p->start_time = current_time;
+        current_time += p->burst;
+        p->finish_time = current_time;
+        p->remaining = 0;
+
+        abs_error += best_estimate > p->burst ? best_estimate - p->burst : p->burst - best_estimate;
+        error += best_estimate - p->burst;
+        estimate[best] = seen[best] ? alpha * p->burst + (1 - alpha) * estimate[best] : p->burst;
+        seen[best] = 1;
+        global = completed ? alpha * p->burst + (1 - alpha) * global : p->burst;
+    }
+
+    stats->alpha = alpha;
+    stats->mean_abs_error = n ? abs_error / n : 0;
+    stats->mean_error = n ? error / n : 0;
+    free(next);
+}
+
+/**
+ * @brief Prints how much turnaround the predictions cost against oracle SJF.
+ *
+ * @param stats The prediction error of the predicted run.
+ * @param oracle_tat Average turnaround time of computeSJF.
+ * @param predicted_tat Average turnaround time of computeSJFPredicted.
+ * @param out Where to print.
+ */
+void printPredictionImpact(const PredictionStats *stats, float oracle_tat, float predicted_tat, FILE *out) {
+    fprintf(out, "\nBurst Prediction (alpha=%.2f):\n", stats->alpha);
+    fprintf(out, "Turnaround vs Oracle SJF: %.2f vs %.2f (%+.1f%%)\n", predicted_tat, oracle_tat,
+            oracle_tat > 0 ? 100.0 * (predicted_tat - oracle_tat) / oracle_tat : 0.0);
+    fprintf(out, "Mean Absolute Prediction Error: %.2f (bias %+.2f)\n", stats->mean_abs_error, stats->mean_error);
+}
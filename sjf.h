@@ -0,0 +1,22 @@
+#ifndef SJF_H
+#define SJF_H
+
+#include <stdio.h>
+#include "process.h"
+
+#define SJF_DEFAULT_ALPHA 0.5 ///< Weight of the latest burst in the exponential average.
+
+/**
+ * @brief How far the burst predictions of computeSJFPredicted were off.
+ */
+typedef struct {
+    double alpha;           ///< Smoothing factor used.
+    double mean_abs_error;  ///< Mean |prediction - burst| at dispatch time.
+    double mean_error;      ///< Mean prediction - burst (negative: bursts underestimated).
+} PredictionStats;
+
+void computeSJF(Process processes[], int n);
+void computeSJFPredicted(Process processes[], int n, double alpha, PredictionStats *stats);
+void printPredictionImpact(const PredictionStats *stats, float oracle_tat, float predicted_tat, FILE *out);
+
+#endif
@@ -0,0 +1,81 @@
+#!/usr/bin/env python3
+"""Checks the Arrow IPC dump against the CSV dump of the same run.
+
+Usage: check_arrow.py PROCESOS [TRACE]
+
+Without TRACE a random trace long enough to span several record batches is
+generated.  Both dumps are read back, the Arrow one with the installed
+pyarrow, and every row must agree, including the derived turnaround, response
+and wait columns.  Exits with 77 (skipped) when pyarrow is not installed.
+"""
+import csv
+import os
+import random
+import subprocess
+import sys
+import tempfile
+
+try:
+    import pyarrow.ipc
+except ImportError:
+    print("pyarrow is not installed, skipping")
+    sys.exit(77)
+
+COLUMNS = ["algorithm", "id", "arrival", "burst", "start", "finish", "turnaround", "response", "wait"]
+
+
+def writeTrace(path, n):
+    rng = random.Random(86)
+    arrival = 0
+    with open(path, "w") as f:
+        f.write("id arrival burst\n")
+        for i in range(n):
+            arrival += rng.choice([0, 0, 1, 2, 5])
+            f.write("%d %d %d\n" % (i + 1, arrival, rng.randint(1, 20)))
+
+
+def dump(procesos, trace, fmt, path):
+    subprocess.run([procesos, "-S", "-d", path, "--dump-format", fmt, trace], check=True,
+                   stdout=subprocess.DEVNULL, stderr=subprocess.DEVNULL)
+
+
+def main():
+    if len(sys.argv) not in (2, 3):
+        print(__doc__.strip().splitlines()[2], file=sys.stderr)
+        return 2
+    procesos = sys.argv[1]
+    with tempfile.TemporaryDirectory() as tmp:
+        trace = sys.argv[2] if len(sys.argv) == 3 else os.path.join(tmp, "trace.txt")
+        if len(sys.argv) == 2:
+            writeTrace(trace, 70000)
+        dump(procesos, trace, "csv", os.path.join(tmp, "dump.csv"))
+        dump(procesos, trace, "arrow", os.path.join(tmp, "dump.arrow"))
+
+        with open(os.path.join(tmp, "dump.csv")) as f:
+            expected = [[row[0]] + [int(v) for v in row[1:]] for row in list(csv.reader(f))[1:]]
+        for row in expected:
+            arrival, burst, start, finish = row[2:6]
+            row += [finish - arrival, start - arrival, finish - arrival - burst]
+
+        with pyarrow.ipc.open_stream(os.path.join(tmp, "dump.arrow")) as reader:
+            table = reader.read_all()
+            batches = len(table.to_batches())
+        if table.schema.names != COLUMNS:
+            print("Arrow columns %s, expected %s" % (table.schema.names, COLUMNS), file=sys.stderr)
+            return 1
+        columns = [table.column(name).to_pylist() for name in COLUMNS]
+        actual = [list(row) for row in zip(*columns)]
+
+    if len(actual) != len(expected):
+        print("Arrow dump has %d rows, CSV dump %d" % (len(actual), len(expected)), file=sys.stderr)
+        return 1
+    for number, (got, want) in enumerate(zip(actual, expected), 1):
+        if got != want:
+            print("Row %d: Arrow %s, CSV %s" % (number, got, want), file=sys.stderr)
+            return 1
+    print("%d rows in %d record batches match the CSV dump" % (len(actual), batches))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,366 @@
+#include "testutil.h"
+#include <limits.h>
+#include "bandwidth.h"
+
+#define CASES 300
+#define FAIR_SCALE 1024 ///< FAIR_WEIGHT_SCALE of bandwidth.c.
+
+static const int quanta[] = {1, 2, 5, 16};
+
+/**
+ * @brief Runs computeBandwidth with the given limits and policy.
+ */
+static void runBandwidth(Process p[], int n, GroupLimit *limits, int count, GroupPolicy policy, int quantum,
+                         BandwidthStats *stats) {
+    BandwidthConfig config = {limits, count, {0, 0, 1}, policy, quantum};
+    computeBandwidth(p, n, &config, stats);
+}
+
+/**
+ * @brief Checks that groups without a quota are plain RR, whether the trace
+ *        is one group or every process is a group of its own.
+ */
+static int checkUnlimited(void) {
+    int failures = 0;
+    for (int seed = 1; seed <= CASES; seed++) {
+        seedTest(seed);
+        int n = randomInt(1, 200);
+        int quantum = quanta[seed % 4];
+        Process *trace = randomTrace(n, randomInt(0, 1) ? 3 : 40, 30, 1);
+        Process *rr = copyTrace(trace, n);
+        computeRR(rr, n, quantum);
+
+        BandwidthStats stats;
+        Process *actual = copyTrace(trace, n);
+        runBandwidth(actual, n, NULL, 0, GROUP_RR, quantum, &stats);
+        failures += !sameSchedule(rr, actual, n, "one group without quota", seed);
+        free(actual);
+
+        for (int i = 0; i < n; i++)
+            trace[i].group = i;
+        actual = copyTrace(trace, n);
+        runBandwidth(actual, n, NULL, 0, GROUP_RR, quantum, &stats);
+        failures += !sameSchedule(rr, actual, n, "a group per process without quota", seed);
+        failures += !hasCount(stats.throttles, 0, "throttles without quota");
+        free(actual);
+
+        free(rr);
+        free(trace);
+    }
+    return failures;
+}
+
+/**
+ * @brief Group 1 (3 per 10) throttled mid-period against unlimited group 2, quantum 2.
+ *
+ * @details
+ * A and B alternate: A 0-2, B 2-4, A 4-5 (cut at the runtime left), and A is
+ * throttled at 5 until 10.  B runs alone 5-7 and finishes; the CPU idles
+ * 7-10.  At 10 A runs its 3 units in one batched step to 13, is throttled
+ * again until the period boundary at 20, and finishes 20-22.
+ */
+static int checkThrottled(void) {
+    Process p[] = {{.id = 1, .arrival = 0, .burst = 8, .group = 1}, {.id = 2, .arrival = 0, .burst = 4, .group = 2}};
+    GroupLimit limits[] = {{1, 3, 10}};
+    BandwidthStats stats;
+    runBandwidth(p, 2, limits, 1, GROUP_RR, 2, &stats);
+    int failures = !hasTimes(p, 2, (const int[]){0, 2}, (const int[]){22, 7}, "throttled mid-period");
+    failures += !hasCount(stats.throttles, 2, "throttles");
+    failures += !hasCount(stats.throttled_time, 12, "throttled time");
+    failures += !hasCount(stats.idle_throttled, 10, "idle while throttled");
+    failures += !hasCount(stats.decisions, 6, "turns");
+    failures += !hasCount(stats.throttled_groups, 1, "throttled groups");
+    return failures;
+}
+
+/**
+ * @brief Group 1 (2 per 3) whose throttling ends inside another group's turn, quantum 2.
+ *
+ * @details
+ * A runs 0-2, spending its quota, and is throttled until the boundary at 3.
+ * B's turn 2-4 is not cut by the unthrottle, so A is back in the rotation at
+ * 4, ahead of B, with 1 unit of throttled time.  A runs 4-6; at 6 a new period
+ * refills it, so A is not throttled again and both alternate to the end.
+ */
+static int checkBoundary(void) {
+    Process p[] = {{.id = 1, .arrival = 0, .burst = 6, .group = 1}, {.id = 2, .arrival = 0, .burst = 6, .group = 2}};
+    GroupLimit limits[] = {{1, 2, 3}};
+    BandwidthStats stats;
+    runBandwidth(p, 2, limits, 1, GROUP_RR, 2, &stats);
+    int failures = !hasTimes(p, 2, (const int[]){0, 2}, (const int[]){10, 12}, "unthrottled at a period boundary");
+    failures += !hasCount(stats.throttles, 1, "throttles at a boundary");
+    failures += !hasCount(stats.throttled_time, 1, "throttled time at a boundary");
+    failures += !hasCount(stats.idle_throttled, 0, "idle at a boundary");
+    return failures;
+}
+
+/**
+ * @brief Fair share within a group: weight 3 gets three times the turns of weight 1, quantum 2.
+ *
+ * @details
+ * X (weight 1) and Y (weight 3) join at 0.  X wins the tie and runs 0-2,
+ * reaching 2048; Y gains 682 per turn and keeps the CPU while it is behind,
+ * from 2 until it finishes at 10 with 2046.  X finishes 10-12.
+ */
+static int checkFairShare(void) {
+    Process p[] = {{.id = 1, .arrival = 0, .burst = 4, .weight = 1}, {.id = 2, .arrival = 0, .burst = 8, .weight = 3}};
+    BandwidthStats stats;
+    runBandwidth(p, 2, NULL, 0, GROUP_FAIR, 2, &stats);
+    return !hasTimes(p, 2, (const int[]){0, 2}, (const int[]){12, 10}, "fair share by weight");
+}
+
+typedef enum { BRUTE_IDLE, BRUTE_QUEUED, BRUTE_RUNNING, BRUTE_THROTTLED } BruteState;
+
+/**
+ * @brief One group of bruteBandwidth.
+ */
+typedef struct {
+    int quota, period;
+    long long runtime, period_index, until, throttled_at, vclock;
+    long long rotation;  ///< Position in the rotation, smallest first.
+    BruteState state;
+} BruteGroup;
+
+/**
+ * @brief State of bruteBandwidth: every choice is a scan.
+ */
+typedef struct {
+    const BandwidthConfig *config;
+    Process *p;
+    int n;
+    BruteGroup *groups;
+    int *group_of;
+    long long *enqueued;  ///< GROUP_RR: when each process joined its group's queue, -1 if not waiting.
+    long long *vruntime;  ///< GROUP_FAIR: virtual time of each process.
+    long long sequence;   ///< Counter ordering the queues and the rotation.
+    BandwidthStats *stats;
+} Brute;
+
+static void bruteRefresh(BruteGroup *g, long long now) {
+    if (g->quota > 0 && now / g->period != g->period_index) {
+        g->period_index = now / g->period;
+        g->runtime = g->quota;
+    }
+}
+
+static void bruteAppend(Brute *b, int g) {
+    b->groups[g].state = BRUTE_QUEUED;
+    b->groups[g].rotation = b->sequence++;
+}
+
+static void bruteRequeue(Brute *b, int g, long long now) {
+    BruteGroup *group = &b->groups[g];
+    bruteRefresh(group, now);
+    if (group->quota == 0 || group->runtime > 0) {
+        bruteAppend(b, g);
+        return;
+    }
+    group->state = BRUTE_THROTTLED;
+    group->throttled_at = now;
+    group->until = (group->period_index + 1) * group->period;
+    b->stats->throttles++;
+}
+
+static int bruteWaiting(const Brute *b, int g) {
+    int count = 0;
+    for (int i = 0; i < b->n; i++)
+        count += b->group_of[i] == g && b->enqueued[i] >= 0;
+    return count;
+}
+
+/**
+ * @brief Takes the process whose turn it is in group g: the longest waiting, or the least virtual time.
+ */
+static int brutePick(Brute *b, int g) {
+    int pick = -1;
+    for (int i = 0; i < b->n; i++) {
+        if (b->group_of[i] != g || b->enqueued[i] < 0)
+            continue;
+        if (pick < 0 || (b->config->policy == GROUP_FAIR ? b->vruntime[i] < b->vruntime[pick]
+                                                         : b->enqueued[i] < b->enqueued[pick]))
+            pick = i;
+    }
+    b->enqueued[pick] = -1;
+    return pick;
+}
+
+/**
+ * @brief Bandwidth-limited RR among groups by brute force, one turn at a time.
+ *
+ * @details
+ * Follows the rules documented at computeBandwidth, with every queue, the
+ * rotation and the throttled groups scanned instead of linked or kept in
+ * heaps, and no batching: each turn is at most one quantum, charged to its
+ * period and, under GROUP_FAIR, to the virtual time of its process.
+ */
+static void bruteBandwidth(Process p[], int n, const BandwidthConfig *config, BandwidthStats *stats) {
+    int *ids = malloc(n * sizeof(int)), count = 0;
+    for (int i = 0; i < n; i++) {
+        int k = 0;
+        while (k < count && ids[k] != p[i].group)
+            k++;
+        if (k == count)
+            ids[count++] = p[i].group;
+    }
+    for (int a = 1; a < count; a++)
+        for (int k = a; k > 0 && ids[k - 1] > ids[k]; k--) {
+            int t = ids[k];
+            ids[k] = ids[k - 1];
+            ids[k - 1] = t;
+        }
+    Brute b = {config, p, n, calloc(count, sizeof(BruteGroup)), malloc(n * sizeof(int)), malloc(n * sizeof(long long)),
+               calloc(n, sizeof(long long)), 0, stats};
+    for (int g = 0; g < count; g++) {
+        GroupLimit limit = groupLimit(config, ids[g]);
+        b.groups[g] = (BruteGroup){limit.quota, limit.period, 0, -1, 0, 0, 0, 0, BRUTE_IDLE};
+    }
+    for (int i = 0; i < n; i++) {
+        for (int g = 0; g < count; g++)
+            if (ids[g] == p[i].group)
+                b.group_of[i] = g;
+        b.enqueued[i] = -1;
+    }
+    *stats = (BandwidthStats){0};
+    long long *throttled_time = calloc(count, sizeof(long long));
+
+    int idx = 0, done = 0, current = -1, quantum = config->quantum;
+    long long now = 0;
+    while (done < n) {
+        for (;;) {
+            int first = -1;
+            for (int g = 0; g < count; g++)
+                if (b.groups[g].state == BRUTE_THROTTLED && b.groups[g].until <= now &&
+                    (first < 0 || b.groups[g].until < b.groups[first].until))
+                    first = g;
+            if (first < 0)
+                break;
+            throttled_time[first] += b.groups[first].until - b.groups[first].throttled_at;
+            bruteRefresh(&b.groups[first], b.groups[first].until);
+            bruteAppend(&b, first);
+        }
+        for (; idx < n && p[idx].arrival <= now; idx++) {
+            int g = b.group_of[idx];
+            b.vruntime[idx] = b.groups[g].vclock;
+            b.enqueued[idx] = b.sequence++;
+            if (b.groups[g].state == BRUTE_IDLE)
+                bruteRequeue(&b, g, now);
+        }
+        if (current >= 0) {
+            int g = b.group_of[current];
+            if (p[current].remaining > 0)
+                b.enqueued[current] = b.sequence++;
+            if (bruteWaiting(&b, g) > 0)
+                bruteRequeue(&b, g, now);
+            else
+                b.groups[g].state = BRUTE_IDLE;
+            current = -1;
+        }
+
+        int g = -1, throttled = 0;
+        long long next = idx < n ? p[idx].arrival : LLONG_MAX;
+        for (int k = 0; k < count; k++) {
+            if (b.groups[k].state == BRUTE_QUEUED && (g < 0 || b.groups[k].rotation < b.groups[g].rotation))
+                g = k;
+            if (b.groups[k].state == BRUTE_THROTTLED) {
+                throttled = 1;
+                if (b.groups[k].until < next)
+                    next = b.groups[k].until;
+            }
+        }
+        if (g < 0) {
+            if (throttled)
+                stats->idle_throttled += next - now;
+            now = next;
+            continue;
+        }
+
+        BruteGroup *group = &b.groups[g];
+        group->state = BRUTE_RUNNING;
+        bruteRefresh(group, now);
+        int i = brutePick(&b, g);
+        long long run = p[i].remaining < quantum ? p[i].remaining : quantum;
+        if (group->quota > 0 && group->runtime < run)
+            run = group->runtime;
+        if (p[i].start_time < 0)
+            p[i].start_time = (int)now;
+        now += run;
+        p[i].remaining -= (int)run;
+        if (group->quota > 0)
+            group->runtime -= run;
+        if (p[i].remaining == 0) {
+            p[i].finish_time = (int)now;
+            done++;
+        }
+        if (config->policy == GROUP_FAIR) {
+            b.vruntime[i] += run * FAIR_SCALE / p[i].weight;
+            long long least = p[i].remaining > 0 ? b.vruntime[i] : LLONG_MAX;
+            for (int k = 0; k < n; k++)
+                if (b.group_of[k] == g && b.enqueued[k] >= 0 && b.vruntime[k] < least)
+                    least = b.vruntime[k];
+            if (least != LLONG_MAX && least > group->vclock)
+                group->vclock = least;
+        }
+        current = i;
+    }
+    for (int k = 0; k < count; k++)
+        stats->throttled_time += throttled_time[k];
+
+    free(throttled_time);
+    free(b.vruntime);
+    free(b.enqueued);
+    free(b.group_of);
+    free(b.groups);
+    free(ids);
+}
+
+/**
+ * @brief Checks computeBandwidth against bruteBandwidth on random groups, limits, weights and policies.
+ */
+static int checkOracle(void) {
+    int failures = 0;
+    for (int seed = 1; seed <= CASES; seed++) {
+        seedTest(seed);
+        int n = randomInt(1, 120), quantum = randomInt(1, 6), groups = randomInt(1, 5);
+        Process *trace = randomTrace(n, randomInt(0, 1) ? 3 : 30, 30, 1);
+        for (int i = 0; i < n; i++) {
+            trace[i].group = randomInt(1, groups);
+            trace[i].weight = randomInt(1, 5);
+        }
+        GroupLimit limits[5];
+        int count = 0;
+        for (int g = 1; g <= groups; g++) {
+            if (randomInt(0, 2) == 0)
+                continue;
+            int period = randomInt(1, 20);
+            limits[count++] = (GroupLimit){g, randomInt(1, period), period};
+        }
+        BandwidthConfig config = {limits, count, {0, 0, 1}, (GroupPolicy)(seed % 2), quantum};
+        if (seed % 5 == 0)
+            config.fallback = (GroupLimit){0, randomInt(1, 4), randomInt(4, 12)};
+
+        Process *expected = copyTrace(trace, n), *actual = copyTrace(trace, n);
+        BandwidthStats brute, stats;
+        bruteBandwidth(expected, n, &config, &brute);
+        computeBandwidth(actual, n, &config, &stats);
+        if (!sameSchedule(expected, actual, n, config.policy == GROUP_FAIR ? "fair bandwidth" : "rr bandwidth", seed) ||
+            !hasCount(stats.throttles, brute.throttles, "throttles against brute force") ||
+            !hasCount(stats.throttled_time, brute.throttled_time, "throttled time against brute force") ||
+            !hasCount(stats.idle_throttled, brute.idle_throttled, "idle while throttled against brute force"))
+            failures++;
+        free(actual);
+        free(expected);
+        free(trace);
+    }
+    return failures;
+}
+
+/**
+ * @brief Checks computeBandwidth against RR without quotas, against hand-computed
+ *        throttling and fair share, and against the turn-by-turn simulation.
+ */
+int main(void) {
+    int failures = checkUnlimited() + checkThrottled() + checkBoundary() + checkFairShare() + checkOracle();
+    if (failures)
+        fprintf(stderr, "%d bandwidth checks failed\n", failures);
+    return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
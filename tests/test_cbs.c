@@ -0,0 +1,92 @@
+#include "testutil.h"
+#include "cbs.h"
+
+/**
+ * @brief Runs computeCBS with the given servers and best-effort quantum.
+ */
+static void runCBS(Process p[], int n, GroupLimit *limits, int count, int quantum, CBSStats *stats) {
+    BandwidthConfig config = {limits, count, {0, 0, 1}, GROUP_RR, quantum};
+    computeCBS(p, n, &config, stats);
+}
+
+/**
+ * @brief A server (2 per 6) with periodic jobs of 2 every 6 beside an overrunning server (4 per 6).
+ *
+ * @details
+ * Both deadlines start at 6 and the tie goes to the first server, whose job
+ * runs 0-2; the other runs 2-6 and is postponed to 12.  At 6 and 12 the job
+ * arrives to a budget of 2 that would not fit before the old deadline, so the
+ * server is reset to deadline now + 6, ties again and runs first.  Each job
+ * gets exactly its 2 units in its own period, and the overrunning job takes
+ * the rest, postponed every 4 units, until 36.
+ */
+static int checkIsolation(void) {
+    Process p[] = {{.id = 1, .arrival = 0, .burst = 2, .group = 1}, {.id = 2, .arrival = 0, .burst = 30, .group = 2},
+                   {.id = 3, .arrival = 6, .burst = 2, .group = 1}, {.id = 4, .arrival = 12, .burst = 2, .group = 1}};
+    GroupLimit limits[] = {{1, 2, 6}, {2, 4, 6}};
+    CBSStats stats;
+    runCBS(p, 4, limits, 2, 4, &stats);
+    int failures = !hasTimes(p, 4, (const int[]){0, 2, 6, 12}, (const int[]){2, 36, 8, 14},
+                             "Q per T beside an overrun");
+    failures += !hasCount(stats.replenishments, 4, "replenishments beside an overrun");
+    failures += !hasCount(stats.postponements, 10, "postponements beside an overrun");
+    failures += !hasCount(stats.preemptions, 0, "preemptions beside an overrun");
+    failures += !hasCount(stats.reserved_time, 36, "reserved time beside an overrun");
+    return failures;
+}
+
+/**
+ * @brief The deadline of an idle server is kept while its budget fits, c_s * T_s < (d_s - t) * Q_s.
+ *
+ * @details
+ * The first server (4 per 10) runs a job 0-1 and idles with budget 3 and
+ * deadline 10.  When its next job and a job of the second server (5 per 9)
+ * arrive at 2, 3 * 10 < (10 - 2) * 4, so it keeps deadline 10 and runs first,
+ * before the other's 11.  Arriving at 5 instead, 3 * 10 >= (10 - 5) * 4 resets
+ * it to deadline 15, and the other server's 14 goes first.
+ */
+static int checkDeadlineRule(void) {
+    GroupLimit limits[] = {{1, 4, 10}, {2, 5, 9}};
+    CBSStats stats;
+    Process kept[] = {{.id = 1, .arrival = 0, .burst = 1, .group = 1}, {.id = 2, .arrival = 2, .burst = 3, .group = 1},
+                      {.id = 3, .arrival = 2, .burst = 3, .group = 2}};
+    runCBS(kept, 3, limits, 2, 4, &stats);
+    int failures = !hasTimes(kept, 3, (const int[]){0, 2, 5}, (const int[]){1, 5, 8}, "deadline kept");
+    failures += !hasCount(stats.replenishments, 2, "replenishments with the deadline kept");
+
+    Process reset[] = {{.id = 1, .arrival = 0, .burst = 1, .group = 1}, {.id = 2, .arrival = 5, .burst = 3, .group = 1},
+                       {.id = 3, .arrival = 5, .burst = 3, .group = 2}};
+    runCBS(reset, 3, limits, 2, 4, &stats);
+    failures += !hasTimes(reset, 3, (const int[]){0, 8, 5}, (const int[]){1, 11, 8}, "deadline reset");
+    failures += !hasCount(stats.replenishments, 3, "replenishments with the deadline reset");
+    return failures;
+}
+
+/**
+ * @brief A best-effort process preempted by a server resumes at the head of the ring, quantum 4.
+ *
+ * @details
+ * E1 and E2 arrive at 0 and E1 starts a slice.  The server's job arrives at 2
+ * and preempts E1, which goes back to the front: after the job (2-4) E1 gets
+ * a new slice 4-8 ahead of E2, then E2 8-12, E1 12-16 and E2 16-22.
+ */
+static int checkResume(void) {
+    Process p[] = {{.id = 1, .arrival = 0, .burst = 10}, {.id = 2, .arrival = 0, .burst = 10},
+                   {.id = 3, .arrival = 2, .burst = 2, .group = 1}};
+    GroupLimit limits[] = {{1, 2, 10}};
+    CBSStats stats;
+    runCBS(p, 3, limits, 1, 4, &stats);
+    int failures = !hasTimes(p, 3, (const int[]){0, 8, 2}, (const int[]){16, 22, 4}, "best effort resumes first");
+    failures += !hasCount(stats.preemptions, 1, "best-effort preemptions");
+    return failures;
+}
+
+/**
+ * @brief Checks computeCBS against hand-computed schedules.
+ */
+int main(void) {
+    int failures = checkIsolation() + checkDeadlineRule() + checkResume();
+    if (failures)
+        fprintf(stderr, "%d CBS checks failed\n", failures);
+    return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,73 @@
+#include <math.h>
+#include "testutil.h"
+#include "closedloop.h"
+
+#define CLOSED_TRACE 64      ///< Processes whose bursts are the demands.
+#define CLOSED_THINK_TIME 30 ///< Mean think time Z of the runs.
+#define CLOSED_RUN 20000     ///< Completions per run.
+#define BOUND_SLACK 0.02     ///< Relative excess over the bound allowed to the sampled think times.
+#define LAW_TOLERANCE 0.01   ///< Relative gap allowed between N / X and R + Z.
+
+/**
+ * @brief Runs one population and checks it against the asymptotic bound and the response time law.
+ *
+ * @details
+ * X may not exceed min(N / (D + Z), 1 / D): the CPU does at most one unit of
+ * demand per time unit, and each user needs at least D + Z per job.  The
+ * think times are sampled, so their mean is only close to Z and the first
+ * term gets a small slack.  By the interactive response time law N / X must
+ * be R + Z, up to the jobs still in the loop when the run stops.  Past the
+ * saturation point N* = (D + Z) / D the CPU never idles, so X must also reach
+ * the bound there.
+ */
+static int checkPopulation(const Process trace[], int n, double demand, int users, int quantum) {
+    ClosedLoopConfig config = {users, users, 1, CLOSED_THINK_TIME, CLOSED_RUN, quantum, 1, 12345};
+    ClosedLoopPoint point;
+    simulateClosedLoop(trace, n, users, &config, &point);
+    double bound = fmin(users / (demand + config.think), 1.0 / demand);
+    double cycle = users / point.throughput;
+    int failures = 0;
+
+    if (point.completed != CLOSED_RUN) {
+        fprintf(stderr, "N=%d, quantum %d: %lld jobs completed, expected %d\n", users, quantum, point.completed,
+                CLOSED_RUN);
+        failures++;
+    }
+    if (point.throughput > bound * (1 + BOUND_SLACK)) {
+        fprintf(stderr, "N=%d, quantum %d: X = %.4f above the bound %.4f\n", users, quantum, point.throughput,
+                bound);
+        failures++;
+    }
+    if (users > 2 * (demand + config.think) / demand && point.throughput < bound * (1 - BOUND_SLACK)) {
+        fprintf(stderr, "N=%d, quantum %d: X = %.4f below the saturated bound %.4f\n", users, quantum,
+                point.throughput, bound);
+        failures++;
+    }
+    if (fabs(cycle - point.response - config.think) > LAW_TOLERANCE * cycle) {
+        fprintf(stderr, "N=%d, quantum %d: N/X - Z = %.2f but R = %.2f\n", users, quantum, cycle - config.think,
+                point.response);
+        failures++;
+    }
+    return failures;
+}
+
+/**
+ * @brief Checks simulateClosedLoop on a fixed trace, from one user to well past saturation.
+ */
+int main(void) {
+    seedTest(7);
+    Process *trace = randomTrace(CLOSED_TRACE, 3, 20, 1);
+    double demand = 0;
+    for (int i = 0; i < CLOSED_TRACE; i++)
+        demand += trace[i].burst;
+    demand /= CLOSED_TRACE;
+
+    int failures = 0;
+    for (int quantum = 1; quantum <= 8; quantum *= 2)
+        for (int users = 1; users <= 60; users += 7)
+            failures += checkPopulation(trace, CLOSED_TRACE, demand, users, quantum);
+    free(trace);
+    if (failures)
+        fprintf(stderr, "%d closed-loop checks failed\n", failures);
+    return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,88 @@
+#include "testutil.h"
+#include "o1.h"
+
+/**
+ * @brief Checks the counters of an O(1) run against hand-computed values.
+ */
+static int hasO1Stats(const O1Stats *stats, long long decisions, long long preemptions, long long expirations,
+                      long long requeued, long long switches, const char *what) {
+    long long actual[] = {stats->decisions, stats->preemptions, stats->expirations, stats->requeued, stats->switches};
+    long long expected[] = {decisions, preemptions, expirations, requeued, switches};
+    static const char *const names[] = {"decisions", "preemptions", "expirations", "requeued", "switches"};
+    for (int k = 0; k < 5; k++) {
+        if (actual[k] != expected[k]) {
+            fprintf(stderr, "%s: %lld %s, expected %lld\n", what, actual[k], names[k], expected[k]);
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * @brief An arrival of better priority preempts, and the preempted process resumes its slice first.
+ *
+ * @details
+ * Quantum 10, so the sleep average tops out at 100 and a new process starts
+ * at 95, a bonus of 4.  P1 (nice 0, priority 116, slice 10) runs 0-3; P2
+ * (nice -5, priority 111) arrives and preempts it, running 3-7.  P1 finishes
+ * its slice 7-14 and, its bonus down to 3, is still interactive and stays
+ * active; the same at 24 with a bonus of 2.  It finishes at 34.
+ */
+static int checkPreemption(void) {
+    Process p[] = {{.id = 1, .arrival = 0, .burst = 30, .priority = 0},
+                   {.id = 2, .arrival = 3, .burst = 4, .priority = -5}};
+    O1Stats stats;
+    computeO1(p, 2, 10, &stats);
+    int failures = !hasTimes(p, 2, (const int[]){0, 3}, (const int[]){34, 7}, "O(1) preemption");
+    failures += !hasO1Stats(&stats, 5, 1, 2, 2, 0, "O(1) preemption");
+    return failures;
+}
+
+/**
+ * @brief Interactive requeues until the bonus runs out, then expiry and an array switch.
+ *
+ * @details
+ * Two CPU-bound nice-0 processes alternate slices of 10.  After their first
+ * and second slices the bonus is 3, then 2, so they go back to the active
+ * array; after the third it is 1, no longer interactive, and both expire.
+ * The active array empties at 60, the arrays switch, and A and B finish
+ * their last slices 60-70 and 70-80.
+ */
+static int checkExpiry(void) {
+    Process p[] = {{.id = 1, .arrival = 0, .burst = 40}, {.id = 2, .arrival = 0, .burst = 40}};
+    O1Stats stats;
+    computeO1(p, 2, 10, &stats);
+    int failures = !hasTimes(p, 2, (const int[]){0, 10}, (const int[]){70, 80}, "O(1) expiry");
+    failures += !hasO1Stats(&stats, 8, 0, 6, 4, 1, "O(1) expiry");
+    return failures;
+}
+
+/**
+ * @brief An interactive process expires anyway when the expired array holds a better static priority.
+ *
+ * @details
+ * C (nice -5, slice 50) runs 0-50 and expires with a bonus of -1.  D (nice 0)
+ * runs 50-60 and is still interactive, but C's static priority 115 in the
+ * expired array is better than its 120, so it expires too.  After the switch
+ * C runs 60-110 and D 110-120, both expiring again; after the next switch D,
+ * now ahead, finishes 120-130 and C, after one more switch, at 230.
+ */
+static int checkStarving(void) {
+    Process p[] = {{.id = 1, .arrival = 0, .burst = 200, .priority = -5},
+                   {.id = 2, .arrival = 0, .burst = 30, .priority = 0}};
+    O1Stats stats;
+    computeO1(p, 2, 10, &stats);
+    int failures = !hasTimes(p, 2, (const int[]){0, 50}, (const int[]){230, 130}, "O(1) starving expired array");
+    failures += !hasO1Stats(&stats, 7, 0, 5, 0, 3, "O(1) starving expired array");
+    return failures;
+}
+
+/**
+ * @brief Checks computeO1 against hand-computed schedules for each of its paths.
+ */
+int main(void) {
+    int failures = checkPreemption() + checkExpiry() + checkStarving();
+    if (failures)
+        fprintf(stderr, "%d O(1) checks failed\n", failures);
+    return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
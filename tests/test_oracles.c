@@ -0,0 +1,543 @@
+#include <math.h>
+#include "testutil.h"
+#include "backfill.h"
+#include "gang.h"
+#include "eevdf.h"
+#include "sjf.h"
+#include "groupby.h"
+#include "admission.h"
+#include "schema.h"
+
+#define EASY_CASES 300
+#define GANG_CASES 500
+#define EEVDF_CASES 400
+#define SJF_CASES 300
+#define ADMISSION_CASES 500
+
+static int compareByEnd(const void *a, const void *b) {
+    const int *x = a, *y = b;
+    return (x[0] > y[0]) - (x[0] < y[0]);
+}
+
+/**
+ * @brief EASY backfilling by brute force: every decision rescans the queue and the running set.
+ *
+ * @details
+ * At each event the processes finishing then release their cores and the
+ * arrivals join the queue.  The head starts while its cores are free.  A
+ * blocked head reserves the shadow time, when enough running processes have
+ * finished; the cores left over at that time are the extra cores.  Then each
+ * later process that fits now starts if it ends by the shadow time or fits in
+ * the extra cores, which it then uses up.
+ */
+static void bruteEASY(Process p[], int n, int cores) {
+    int *waiting = malloc(n * sizeof(int)), *running = malloc(n * sizeof(int));
+    int (*ends)[2] = malloc(n * sizeof(*ends));
+    long long *end = malloc(n * sizeof(long long));
+    int waiting_count = 0, running_count = 0, idx = 0, done = 0, idle = cores;
+    long long now = 0;
+    while (done < n) {
+        long long next = idx < n ? p[idx].arrival : -1;
+        for (int r = 0; r < running_count; r++)
+            if (next < 0 || end[running[r]] < next)
+                next = end[running[r]];
+        now = next;
+        for (int r = 0; r < running_count; r++) {
+            int i = running[r];
+            if (end[i] == now) {
+                p[i].finish_time = (int)now;
+                idle += p[i].cores;
+                done++;
+                running[r--] = running[--running_count];
+            }
+        }
+        for (; idx < n && p[idx].arrival <= now; idx++)
+            waiting[waiting_count++] = idx;
+
+        while (waiting_count > 0) {
+            int h = waiting[0];
+            if (p[h].cores <= idle) {
+                p[h].start_time = (int)now;
+                end[h] = now + p[h].burst;
+                running[running_count++] = h;
+                idle -= p[h].cores;
+                memmove(waiting, waiting + 1, --waiting_count * sizeof(int));
+                continue;
+            }
+            for (int r = 0; r < running_count; r++) {
+                ends[r][0] = (int)end[running[r]];
+                ends[r][1] = p[running[r]].cores;
+            }
+            qsort(ends, running_count, sizeof(*ends), compareByEnd);
+            long long shadow = 0;
+            for (int r = 0, freed = idle; r < running_count; r++) {
+                freed += ends[r][1];
+                if (freed >= p[h].cores) {
+                    shadow = ends[r][0];
+                    break;
+                }
+            }
+            int extra = idle - p[h].cores;
+            for (int r = 0; r < running_count; r++)
+                if (ends[r][0] <= shadow)
+                    extra += ends[r][1];
+            for (int w = 1; w < waiting_count; w++) {
+                int j = waiting[w];
+                if (p[j].cores <= idle && (now + p[j].burst <= shadow || p[j].cores <= extra)) {
+                    p[j].start_time = (int)now;
+                    end[j] = now + p[j].burst;
+                    running[running_count++] = j;
+                    idle -= p[j].cores;
+                    if (now + p[j].burst > shadow)
+                        extra -= p[j].cores;
+                    memmove(waiting + w, waiting + w + 1, (waiting_count - w - 1) * sizeof(int));
+                    waiting_count--;
+                    w--;
+                }
+            }
+            break;
+        }
+    }
+    free(end);
+    free(ends);
+    free(running);
+    free(waiting);
+}
+
+/**
+ * @brief Gang scheduling by brute force on an explicit rows x cpus matrix.
+ *
+ * @details
+ * Queued processes take, in arrival order, the first run of free columns
+ * wide enough in the first row that has one, until one does not fit.  The
+ * non-empty rows then run in turn, each for the quantum or until its longest
+ * remaining process is done.
+ */
+static void bruteGang(Process p[], int n, int cpus, int rows, int quantum) {
+    int *matrix = malloc((size_t)rows * cpus * sizeof(int));
+    int *members = calloc(rows, sizeof(int));
+    for (int c = 0; c < rows * cpus; c++)
+        matrix[c] = -1;
+    int idx = 0, head = 0, done = 0, turn = 0;
+    long long now = 0;
+    while (done < n) {
+        for (; idx < n && p[idx].arrival <= now; idx++)
+            ;
+        for (; head < idx; head++) {
+            int placed = 0;
+            for (int r = 0; r < rows && !placed; r++) {
+                for (int c = 0, run = 0; c < cpus && !placed; c++) {
+                    run = matrix[r * cpus + c] < 0 ? run + 1 : 0;
+                    if (run == p[head].cores) {
+                        for (int x = c - run + 1; x <= c; x++)
+                            matrix[r * cpus + x] = head;
+                        members[r]++;
+                        placed = 1;
+                    }
+                }
+            }
+            if (!placed)
+                break;
+        }
+        int busy_rows = 0;
+        for (int r = 0; r < rows; r++)
+            busy_rows += members[r] > 0;
+        if (busy_rows == 0) {
+            now = p[idx].arrival;
+            continue;
+        }
+        while (members[turn] == 0)
+            turn = (turn + 1) % rows;
+        int r = turn;
+        turn = (turn + 1) % rows;
+
+        int longest = 0;
+        for (int c = 0; c < cpus; c++) {
+            int i = matrix[r * cpus + c];
+            if (i >= 0 && p[i].remaining > longest)
+                longest = p[i].remaining;
+        }
+        int slice = longest < quantum ? longest : quantum;
+        for (int c = 0; c < cpus; c++) {
+            int i = matrix[r * cpus + c];
+            if (i < 0 || (c > 0 && matrix[r * cpus + c - 1] == i))
+                continue;
+            int run = p[i].remaining < slice ? p[i].remaining : slice;
+            if (p[i].start_time < 0)
+                p[i].start_time = (int)now;
+            p[i].remaining -= run;
+            if (p[i].remaining == 0) {
+                p[i].finish_time = (int)(now + run);
+                done++;
+                members[r]--;
+                for (int x = c; x < cpus && matrix[r * cpus + x] == i; x++)
+                    matrix[r * cpus + x] = -1;
+            }
+        }
+        now += slice;
+    }
+    free(members);
+    free(matrix);
+}
+
+/**
+ * @brief EEVDF by brute force: one slice per decision, V recomputed from every runnable process.
+ *
+ * @details
+ * Same rules as computeEEVDF without the timeline or the batching of a lone
+ * process: at each decision the arrivals join at V rounded down, and the
+ * eligible process (w * v <= the weighted sum, scaled by the total weight)
+ * of earliest virtual deadline, then lowest index, runs for one quantum.
+ */
+static void bruteEEVDF(Process p[], int n, int quantum) {
+    long long *vruntime = malloc(n * sizeof(long long)), *deadline = malloc(n * sizeof(long long));
+    char *runnable = calloc(n, 1);
+    int idx = 0, done = 0, count = 0;
+    long long now = 0, base = 0;
+    while (done < n) {
+        if (count == 0 && p[idx].arrival > now)
+            now = p[idx].arrival;
+        long long sum_weight = 0, sum = 0;
+        for (int i = 0; i < idx; i++) {
+            if (runnable[i]) {
+                sum_weight += p[i].weight;
+                sum += p[i].weight * vruntime[i];
+            }
+        }
+        if (sum_weight > 0)
+            base = sum / sum_weight - (sum % sum_weight < 0);
+        for (; idx < n && p[idx].arrival <= now; idx++) {
+            vruntime[idx] = base;
+            deadline[idx] = base + quantum * (long long)EEVDF_WEIGHT_SCALE / p[idx].weight;
+            runnable[idx] = 1;
+            count++;
+            sum_weight += p[idx].weight;
+            sum += p[idx].weight * base;
+        }
+
+        int pick = -1;
+        for (int i = 0; i < idx; i++)
+            if (runnable[i] && vruntime[i] * sum_weight <= sum && (pick < 0 || deadline[i] < deadline[pick]))
+                pick = i;
+        int run = p[pick].remaining < quantum ? p[pick].remaining : quantum;
+        if (p[pick].start_time < 0)
+            p[pick].start_time = (int)now;
+        now += run;
+        p[pick].remaining -= run;
+        if (p[pick].remaining == 0) {
+            p[pick].finish_time = (int)now;
+            runnable[pick] = 0;
+            count--;
+            done++;
+        } else {
+            vruntime[pick] += run * (long long)EEVDF_WEIGHT_SCALE / p[pick].weight;
+            deadline[pick] = vruntime[pick] + quantum * (long long)EEVDF_WEIGHT_SCALE / p[pick].weight;
+        }
+    }
+    free(runnable);
+    free(deadline);
+    free(vruntime);
+}
+
+/**
+ * @brief SJF by brute force: every decision scans the arrived processes for the shortest prediction.
+ *
+ * @param alpha Weight of the latest burst, or a negative value to use the true bursts.
+ * @param stats Receives the prediction error when alpha is not negative.
+ *
+ * @details
+ * With the true bursts this is computeSJF without the heap.  Otherwise each
+ * process is predicted from scratch: the exponential average is replayed over
+ * the completed processes of its class, or over all completed processes when
+ * its class has none, instead of the per-class FIFOs and running averages of
+ * computeSJFPredicted.  Ties go to the earlier arrival.
+ */
+static void bruteSJF(Process p[], int n, double alpha, PredictionStats *stats) {
+    int *order = malloc((n > 0 ? n : 1) * sizeof(int));
+    int idx = 0, now = 0;
+    double abs_error = 0, error = 0;
+    for (int done = 0; done < n; done++) {
+        int waiting = 0;
+        for (int i = 0; i < idx; i++)
+            waiting += p[i].finish_time < 0;
+        if (waiting == 0 && p[idx].arrival > now)
+            now = p[idx].arrival;
+        while (idx < n && p[idx].arrival <= now)
+            idx++;
+
+        int pick = -1;
+        double best = 0;
+        for (int i = 0; i < idx; i++) {
+            if (p[i].finish_time >= 0)
+                continue;
+            double predicted = p[i].burst;
+            if (alpha >= 0) {
+                int seen = 0;
+                for (int k = 0; k < done; k++)
+                    seen += p[order[k]].cls == p[i].cls;
+                predicted = 0;
+                for (int k = 0, first = 1; k < done; k++) {
+                    if (seen && p[order[k]].cls != p[i].cls)
+                        continue;
+                    predicted = first ? p[order[k]].burst : alpha * p[order[k]].burst + (1 - alpha) * predicted;
+                    first = 0;
+                }
+            }
+            if (pick < 0 || predicted < best) {
+                pick = i;
+                best = predicted;
+            }
+        }
+        p[pick].start_time = now;
+        now += p[pick].burst;
+        p[pick].finish_time = now;
+        order[done] = pick;
+        abs_error += best > p[pick].burst ? best - p[pick].burst : p[pick].burst - best;
+        error += best - p[pick].burst;
+    }
+    if (alpha >= 0) {
+        stats->mean_abs_error = n ? abs_error / n : 0;
+        stats->mean_error = n ? error / n : 0;
+    }
+    free(order);
+}
+
+/**
+ * @brief The admission check of computeRRAdmission with the system state summed from scratch.
+ *
+ * @return 1 if admitted, -1 if dropped for its deadline, -2 if over the cap, -3 if over the wait threshold.
+ */
+static int bruteAdmit(const Process p[], int n, const char admitted[], const int remaining[], int i, int now,
+                      const AdmissionPolicy *policy) {
+    long long backlog = 0;
+    int in_system = 0;
+    for (int j = 0; j < n; j++) {
+        if (admitted[j] && p[j].finish_time < 0) {
+            backlog += remaining[j];
+            in_system++;
+        }
+    }
+    if (policy->deadlines && p[i].deadline != NO_DEADLINE && now + backlog + p[i].burst > p[i].deadline)
+        return -1;
+    if (policy->max_in_system > 0 && in_system >= policy->max_in_system)
+        return -2;
+    if (policy->max_wait > 0 && backlog > policy->max_wait)
+        return -3;
+    return 1;
+}
+
+/**
+ * @brief RR under admission control by brute force: every check rescans the admitted processes.
+ *
+ * @details
+ * The queue discipline of computeRR on plain arrays, with the deferred
+ * processes in a list in arrival order.  Instead of the running backlog and
+ * count of computeRRAdmission, each check sums the remaining work of the
+ * admitted processes that have not finished.
+ */
+static void bruteAdmission(Process p[], int n, int quantum, const AdmissionPolicy *policy, AdmissionStats *stats) {
+    int *queue = malloc((n > 0 ? n : 1) * sizeof(int)), *deferred = malloc((n > 0 ? n : 1) * sizeof(int));
+    int *remaining = malloc((n > 0 ? n : 1) * sizeof(int));
+    char *admitted = calloc(n > 0 ? n : 1, 1);
+    for (int i = 0; i < n; i++)
+        remaining[i] = p[i].burst;
+    *stats = (AdmissionStats){.offered = n};
+    int size = 0, waiting = 0, idx = 0, now = 0, running = -1;
+
+    for (;;) {
+        // Deferred processes first, then the arrivals, then the preempted process.
+        while (waiting > 0) {
+            int outcome = bruteAdmit(p, n, admitted, remaining, deferred[0], now, policy);
+            if (outcome < -1)
+                break;
+            if (outcome > 0) {
+                admitted[deferred[0]] = 1;
+                queue[size++] = deferred[0];
+                stats->deferred++;
+            } else {
+                stats->rejected_deadline++;
+            }
+            memmove(deferred, deferred + 1, --waiting * sizeof(int));
+        }
+        for (; idx < n && p[idx].arrival <= now; idx++) {
+            int outcome = waiting > 0 ? -2 : bruteAdmit(p, n, admitted, remaining, idx, now, policy);
+            if (outcome > 0) {
+                admitted[idx] = 1;
+                queue[size++] = idx;
+            } else if (outcome < -1 && policy->action == ADMIT_DEFER) {
+                deferred[waiting++] = idx;
+            } else {
+                stats->rejected_deadline += outcome == -1;
+                stats->rejected_queue += outcome == -2;
+                stats->rejected_wait += outcome == -3;
+            }
+        }
+        if (running >= 0)
+            queue[size++] = running;
+        running = -1;
+        if (size == 0) {
+            if (idx == n)
+                break;
+            now = p[idx].arrival;
+            continue;
+        }
+
+        int i = queue[0];
+        memmove(queue, queue + 1, --size * sizeof(int));
+        if (p[i].start_time < 0)
+            p[i].start_time = now;
+        int run = remaining[i] < quantum ? remaining[i] : quantum;
+        remaining[i] -= run;
+        now += run;
+        if (remaining[i] > 0) {
+            running = i;
+            continue;
+        }
+        p[i].finish_time = now;
+        stats->admitted++;
+        stats->on_time += p[i].deadline == NO_DEADLINE || now <= p[i].deadline;
+        stats->makespan = now;
+    }
+    free(admitted);
+    free(remaining);
+    free(deferred);
+    free(queue);
+}
+
+/**
+ * @brief Checks the backfilling, gang, EEVDF, SJF and admission schedulers against brute-force simulations.
+ *
+ * @details
+ * With equal weights and a common arrival EEVDF must also give computeRR's
+ * schedule; later arrivals join at V with a fresh deadline, which can put
+ * them ahead of RR's queue order.  The weighted EEVDF traces alternate dense
+ * arrivals with long gaps, so a lone process often runs its slices batched
+ * up to the next arrival, which bruteEEVDF does one slice at a time.
+ */
+int main(void) {
+    int failures = 0;
+    for (int seed = 1; seed <= EASY_CASES; seed++) {
+        seedTest(seed);
+        int n = randomInt(1, 300), cores = randomInt(1, 16);
+        Process *trace = randomTrace(n, 5, 20, cores);
+        Process *expected = copyTrace(trace, n), *actual = copyTrace(trace, n);
+        BackfillStats stats;
+        bruteEASY(expected, n, cores);
+        computeEASY(actual, n, cores, &stats);
+        failures += !sameSchedule(expected, actual, n, "EASY backfilling", seed);
+        free(actual);
+        free(expected);
+        free(trace);
+    }
+    for (int seed = 1; seed <= GANG_CASES; seed++) {
+        seedTest(seed);
+        int n = randomInt(1, 120);
+        GangConfig config = {randomInt(1, 130), randomInt(1, 5), randomInt(1, 6)};
+        Process *trace = randomTrace(n, 20, 30, config.cpus);
+        Process *expected = copyTrace(trace, n), *actual = copyTrace(trace, n);
+        GangStats stats;
+        bruteGang(expected, n, config.cpus, config.rows, config.quantum);
+        computeGang(actual, n, &config, &stats);
+        failures += !sameSchedule(expected, actual, n, "gang scheduling", seed);
+        free(actual);
+        free(expected);
+        free(trace);
+    }
+    for (int seed = 1; seed <= EEVDF_CASES; seed++) {
+        seedTest(seed);
+        int n = randomInt(1, 150), quantum = randomInt(1, 6), equal = seed % 2;
+        Process *trace = randomTrace(n, seed % 3 ? 4 : 200, seed % 4 ? 20 : 300, 1);
+        for (int i = 1; i < n && equal; i++)
+            trace[i].arrival = trace[0].arrival;
+        for (int i = 0; i < n && !equal; i++)
+            trace[i].weight = randomInt(0, 9) ? randomInt(1, 12) : randomInt(1, quantum * EEVDF_WEIGHT_SCALE);
+        Process *expected = copyTrace(trace, n), *actual = copyTrace(trace, n);
+        EEVDFStats stats;
+        bruteEEVDF(expected, n, quantum);
+        computeEEVDF(actual, n, quantum, &stats);
+        failures += !sameSchedule(expected, actual, n, "EEVDF", seed);
+        if (equal) {
+            computeRR(expected, n, quantum);
+            failures += !sameSchedule(expected, actual, n, "EEVDF with equal weights", seed);
+        }
+        free(actual);
+        free(expected);
+        free(trace);
+    }
+
+    for (int seed = 1; seed <= SJF_CASES; seed++) {
+        seedTest(seed);
+        int n = randomInt(1, 200), classes = randomInt(1, MAX_CLASSES);
+        double alpha = randomInt(0, 8) / 8.0;
+        Process *trace = randomTrace(n, seed % 3 ? 3 : 60, 20, 1);
+        for (int i = 0; i < n; i++)
+            trace[i].cls = randomInt(0, classes - 1);
+        Process *expected = copyTrace(trace, n), *actual = copyTrace(trace, n);
+        PredictionStats stats, brute;
+        bruteSJF(expected, n, -1, NULL);
+        computeSJF(actual, n);
+        failures += !sameSchedule(expected, actual, n, "oracle SJF", seed);
+        free(actual);
+        free(expected);
+        expected = copyTrace(trace, n);
+        actual = copyTrace(trace, n);
+        bruteSJF(expected, n, alpha, &brute);
+        computeSJFPredicted(actual, n, alpha, &stats);
+        failures += !sameSchedule(expected, actual, n, "predicted SJF", seed);
+        if (fabs(stats.mean_abs_error - brute.mean_abs_error) > 1e-9 ||
+            fabs(stats.mean_error - brute.mean_error) > 1e-9) {
+            fprintf(stderr, "predicted SJF, case %d: prediction error %.6f (bias %.6f), expected %.6f (bias %.6f)\n",
+                    seed, stats.mean_abs_error, stats.mean_error, brute.mean_abs_error, brute.mean_error);
+            failures++;
+        }
+        free(actual);
+        free(expected);
+        free(trace);
+    }
+
+    for (int seed = 1; seed <= ADMISSION_CASES; seed++) {
+        seedTest(seed);
+        int n = randomInt(1, 200), quantum = randomInt(1, 6);
+        AdmissionPolicy policy = {randomInt(0, 1) ? randomInt(1, 8) : 0, randomInt(0, 1) ? randomInt(1, 80) : 0,
+                                  seed % 3 == 0, seed % 2 ? ADMIT_DEFER : ADMIT_DROP};
+        Process *trace = randomTrace(n, seed % 4 ? 3 : 30, 20, 1);
+        for (int i = 0; i < n; i++)
+            if (randomInt(0, 1))
+                trace[i].deadline = trace[i].arrival + trace[i].burst + randomInt(0, 60);
+        Process *expected = copyTrace(trace, n), *actual = copyTrace(trace, n);
+        AdmissionStats stats, brute;
+        bruteAdmission(expected, n, quantum, &policy, &brute);
+        computeRRAdmission(actual, n, quantum, &policy, &stats);
+        failures += !sameSchedule(expected, actual, n, "admission control", seed);
+        if (memcmp(&stats, &brute, sizeof(stats)) != 0) {
+            fprintf(stderr, "admission control, case %d: %d admitted (%d deferred), %d/%d/%d rejected, "
+                    "expected %d (%d), %d/%d/%d\n", seed, stats.admitted, stats.deferred, stats.rejected_queue,
+                    stats.rejected_wait, stats.rejected_deadline, brute.admitted, brute.deferred,
+                    brute.rejected_queue, brute.rejected_wait, brute.rejected_deadline);
+            failures++;
+        }
+        free(actual);
+        free(expected);
+        free(trace);
+    }
+
+    // A lone process of weight 3 (1024 / 3 is not whole) runs 40 units batched before the arrival at 37.
+    Process lone[] = {{.id = 1, .arrival = 0, .burst = 100, .weight = 3},
+                      {.id = 2, .arrival = 37, .burst = 5, .weight = 1}};
+    Process *expected = copyTrace(lone, 2), *actual = copyTrace(lone, 2);
+    EEVDFStats stats;
+    bruteEEVDF(expected, 2, 4);
+    computeEEVDF(actual, 2, 4, &stats);
+    failures += !sameSchedule(expected, actual, 2, "EEVDF lone process", 0);
+    if (stats.decisions >= 100 / 4) {
+        fprintf(stderr, "EEVDF lone process: %lld decisions, the slices before the arrival were not batched\n",
+                stats.decisions);
+        failures++;
+    }
+    free(actual);
+    free(expected);
+
+    if (failures)
+        fprintf(stderr, "%d oracle checks failed\n", failures);
+    return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
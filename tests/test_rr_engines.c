@@ -0,0 +1,63 @@
+#include "testutil.h"
+#include "engines.h"
+#include "busyperiod.h"
+#include "multicpu.h"
+
+#define CASES 400
+
+static const int quanta[] = {1, 2, 5, 16};
+
+/**
+ * @brief Checks the event, closed-form and parallel RR engines, and the
+ *        one-CPU shared-queue simulator, against computeRR and computeFCFS.
+ */
+int main(void) {
+    int failures = 0;
+    for (int seed = 1; seed <= CASES; seed++) {
+        seedTest(seed);
+        int n = randomInt(1, 200);
+        int quantum = quanta[seed % 4];
+        Process *trace = randomTrace(n, randomInt(0, 1) ? 3 : 40, 30, 1);
+
+        Process *expected = copyTrace(trace, n);
+        computeRR(expected, n, quantum);
+
+        Process *actual = copyTrace(trace, n);
+        computeRREvent(actual, n, quantum);
+        failures += !sameSchedule(expected, actual, n, "event RR", seed);
+        free(actual);
+
+        actual = copyTrace(trace, n);
+        computeByBusyPeriods(actual, n, quantum, 4, computeRREvent);
+        failures += !sameSchedule(expected, actual, n, "parallel RR", seed);
+        free(actual);
+
+        actual = copyTrace(trace, n);
+        computeMultiRR(actual, n, 1, quantum);
+        failures += !sameSchedule(expected, actual, n, "RR on one shared CPU", seed);
+        free(actual);
+
+        computeFCFS(expected, n);
+        actual = copyTrace(trace, n);
+        computeMultiFCFS(actual, n, 1);
+        failures += !sameSchedule(expected, actual, n, "FCFS on one shared CPU", seed);
+        free(actual);
+
+        // The closed form only applies when every process arrives at the same time.
+        for (int i = 1; i < n; i++)
+            trace[i].arrival = trace[0].arrival;
+        free(expected);
+        expected = copyTrace(trace, n);
+        computeRR(expected, n, quantum);
+        actual = copyTrace(trace, n);
+        computeRRClosedForm(actual, n, quantum);
+        failures += !sameSchedule(expected, actual, n, "closed-form RR", seed);
+        free(actual);
+
+        free(expected);
+        free(trace);
+    }
+    if (failures)
+        fprintf(stderr, "%d RR engine checks failed\n", failures);
+    return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
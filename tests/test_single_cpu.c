@@ -0,0 +1,95 @@
+#include "testutil.h"
+#include "multicpu.h"
+#include "autoscale.h"
+#include "dispatch.h"
+#include "backfill.h"
+#include "topology.h"
+#include "balance.h"
+
+#define CASES 300
+
+static const int quanta[] = {1, 2, 5, 16};
+
+/**
+ * @brief Checks that the machine models reduce to FCFS and RR on one CPU:
+ *        autoscaling from 1 to 1 CPU, one dispatched server, EASY on one
+ *        core, and the topology and balancing runs on a one-core machine.
+ *        Also checks that naive placement without penalties is the shared
+ *        queue of computeMultiRR on any machine.
+ */
+int main(void) {
+    int failures = 0;
+    for (int seed = 1; seed <= CASES; seed++) {
+        seedTest(seed);
+        int n = randomInt(1, 200);
+        int quantum = quanta[seed % 4];
+        Process *trace = randomTrace(n, randomInt(0, 1) ? 3 : 40, 30, 1);
+        Process *rr = copyTrace(trace, n), *fcfs = copyTrace(trace, n), *actual;
+        computeRR(rr, n, quantum);
+        computeFCFS(fcfs, n);
+
+        AutoscalePolicy scaling = {1, 1, AUTOSCALE_SCALE_UP, AUTOSCALE_SCALE_DOWN, AUTOSCALE_DELAY,
+                                   AUTOSCALE_COOLDOWN};
+        AutoscaleStats scaled;
+        actual = copyTrace(trace, n);
+        computeAutoscaledRR(actual, n, quantum, &scaling, &scaled);
+        failures += !sameSchedule(rr, actual, n, "--autoscale 1:1", seed);
+        free(actual);
+
+        DispatchConfig dispatch = {1, (DispatchPolicy)(seed % 4), 2, MULTI_RR, quantum, DISPATCH_DEFAULT_SEED};
+        DispatchStats spread;
+        actual = copyTrace(trace, n);
+        computeDispatched(actual, n, &dispatch, &spread);
+        failures += !sameSchedule(rr, actual, n, "--servers 1 (rr)", seed);
+        free(actual);
+        dispatch.local = MULTI_FCFS;
+        actual = copyTrace(trace, n);
+        computeDispatched(actual, n, &dispatch, &spread);
+        failures += !sameSchedule(fcfs, actual, n, "--servers 1 (fcfs)", seed);
+        free(actual);
+
+        BackfillStats backfill;
+        actual = copyTrace(trace, n);
+        computeEASY(actual, n, 1, &backfill);
+        failures += !sameSchedule(fcfs, actual, n, "--cores 1", seed);
+        free(actual);
+
+        Topology one = {1, 1, 1, {randomInt(0, 5), randomInt(0, 5), randomInt(0, 5)},
+                        {TOPOLOGY_INTERVAL_CORE, TOPOLOGY_INTERVAL_LLC, TOPOLOGY_INTERVAL_SOCKET},
+                        TOPOLOGY_IMBALANCE_PCT};
+        TopologyStats placed;
+        BalanceStats balanced;
+        for (int placement = PLACE_NAIVE; placement <= PLACE_AFFINITY; placement++) {
+            actual = copyTrace(trace, n);
+            computeTopologyRR(actual, n, quantum, &one, (Placement)placement, &placed);
+            failures += !sameSchedule(rr, actual, n, placement == PLACE_NAIVE ? "topo-naive on one core" :
+                                      "topo-affinity on one core", seed);
+            free(actual);
+        }
+        for (int mode = BALANCE_PERIODIC; mode <= BALANCE_STEAL; mode++) {
+            actual = copyTrace(trace, n);
+            computeBalancedRR(actual, n, quantum, &one, (BalanceMode)mode, &balanced);
+            failures += !sameSchedule(rr, actual, n, mode == BALANCE_PERIODIC ? "lb-periodic on one core" :
+                                      "lb-steal on one core", seed);
+            free(actual);
+        }
+
+        Topology machine = {randomInt(1, 3), randomInt(1, 3), randomInt(1, 4), {0, 0, 0},
+                            {TOPOLOGY_INTERVAL_CORE, TOPOLOGY_INTERVAL_LLC, TOPOLOGY_INTERVAL_SOCKET},
+                            TOPOLOGY_IMBALANCE_PCT};
+        Process *shared = copyTrace(trace, n);
+        computeMultiRR(shared, n, topologyCpus(&machine), quantum);
+        actual = copyTrace(trace, n);
+        computeTopologyRR(actual, n, quantum, &machine, PLACE_NAIVE, &placed);
+        failures += !sameSchedule(shared, actual, n, "topo-naive without penalties", seed);
+        free(actual);
+        free(shared);
+
+        free(fcfs);
+        free(rr);
+        free(trace);
+    }
+    if (failures)
+        fprintf(stderr, "%d single-CPU checks failed\n", failures);
+    return failures ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,116 @@
+#ifndef TESTUTIL_H
+#define TESTUTIL_H
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "process.h"
+
+/**
+ * @brief Deterministic generator of the random traces, seeded per case.
+ */
+static unsigned long long test_state;
+
+static void seedTest(unsigned long long seed) {
+    test_state = seed * 0x9E3779B97F4A7C15ULL + 1;
+}
+
+/**
+ * @brief Returns a uniform integer in [lo, hi].
+ */
+static int randomInt(int lo, int hi) {
+    test_state ^= test_state >> 12;
+    test_state ^= test_state << 25;
+    test_state ^= test_state >> 27;
+    return lo + (int)((test_state * 0x2545F4914F6CDD1DULL >> 33) % (unsigned long long)(hi - lo + 1));
+}
+
+/**
+ * @brief Builds a random trace sorted by arrival, with the defaults of an untyped trace.
+ *
+ * @param n Number of processes.
+ * @param max_gap Largest gap between consecutive arrivals; gaps of 0 are frequent.
+ * @param max_burst Largest burst (bursts start at 0).
+ * @param max_cores Largest cores column (1 for an ordinary trace).
+ * @return A heap-allocated trace, released with free().
+ */
+static Process *randomTrace(int n, int max_gap, int max_burst, int max_cores) {
+    Process *p = calloc(n > 0 ? n : 1, sizeof(Process));
+    if (!p) {
+        perror("Error allocating test trace");
+        exit(EXIT_FAILURE);
+    }
+    int arrival = randomInt(0, max_gap);
+    for (int i = 0; i < n; i++) {
+        if (i > 0 && randomInt(0, 2) > 0)
+            arrival += randomInt(0, max_gap);
+        p[i] = (Process){.id = i + 1, .arrival = arrival, .burst = randomInt(0, max_burst),
+                         .start_time = -1, .finish_time = -1, .deadline = -1, .weight = 1,
+                         .cores = randomInt(1, max_cores)};
+        p[i].remaining = p[i].burst;
+    }
+    return p;
+}
+
+/**
+ * @brief Returns a fresh copy of a trace, with the schedule cleared.
+ */
+static Process *copyTrace(const Process trace[], int n) {
+    Process *p = malloc((n > 0 ? n : 1) * sizeof(Process));
+    if (!p) {
+        perror("Error allocating test trace");
+        exit(EXIT_FAILURE);
+    }
+    memcpy(p, trace, n * sizeof(Process));
+    for (int i = 0; i < n; i++) {
+        p[i].remaining = p[i].burst;
+        p[i].start_time = -1;
+        p[i].finish_time = -1;
+    }
+    return p;
+}
+
+/**
+ * @brief Compares two schedules of the same trace and reports the first difference.
+ *
+ * @return 1 if every process starts and finishes at the same time, 0 otherwise.
+ */
+static int sameSchedule(const Process expected[], const Process actual[], int n, const char *what, int seed) {
+    for (int i = 0; i < n; i++) {
+        if (expected[i].start_time != actual[i].start_time || expected[i].finish_time != actual[i].finish_time) {
+            fprintf(stderr, "%s, case %d: process %d runs %d-%d, expected %d-%d\n", what, seed, expected[i].id,
+                    actual[i].start_time, actual[i].finish_time, expected[i].start_time, expected[i].finish_time);
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * @brief Compares a schedule with hand-computed start and finish times and reports the first difference.
+ *
+ * @return 1 if every process starts and finishes as expected, 0 otherwise.
+ */
+static int hasTimes(const Process actual[], int n, const int start[], const int finish[], const char *what) {
+    for (int i = 0; i < n; i++) {
+        if (actual[i].start_time != start[i] || actual[i].finish_time != finish[i]) {
+            fprintf(stderr, "%s: process %d runs %d-%d, expected %d-%d\n", what, actual[i].id, actual[i].start_time,
+                    actual[i].finish_time, start[i], finish[i]);
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/**
+ * @brief Compares a counter with its hand-computed value and reports a difference.
+ *
+ * @return 1 if they are equal, 0 otherwise.
+ */
+static int hasCount(long long actual, long long expected, const char *what) {
+    if (actual != expected)
+        fprintf(stderr, "%s: %lld, expected %lld\n", what, actual, expected);
+    return actual == expected;
+}
+
+#endif
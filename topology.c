@@ -0,0 +1,315 @@
+#include <stdlib.h>
+#include <string.h>
+#include "topology.h"
+#include "heap.h"
+
+static const char *const level_names[MIGRATE_LEVELS] = {"core", "llc", "socket"};
+
+/**
+ * @brief Reads a topology file.
+ *
+ * @param filename The file to read.
+ * @param topology Receives the topology.
+ *
+ * @details
+ * One "key value" pair per line, '#' starting a comment:
+ *  - sockets N: sockets of the machine (default 1).
+ *  - llcs N: last-level cache domains per socket (default 1).
+ *  - cores N: cores per LLC domain (default 1).
+ *  - penalty core|llc|socket T: time a process loses when it resumes on another
+ *    core of its LLC domain, another LLC domain of its socket, or another
+ *    socket (default 0).
+ *  - interval core|llc|socket T: period of load balancing among the cores of
+ *    each LLC domain, the LLC domains of each socket, and the sockets (default
+ *    4, 16 and 64).
+ *  - imbalance P: balance only when the busiest load exceeds P percent of the
+ *    idlest (default 125).
+ * An unknown key or an invalid value is a fatal error.
+ */
+void loadTopology(const char *filename, Topology *topology) {
+    FILE *file = fopen(filename, "r");
+    if (!file) {
+        perror("Error opening topology file");
+        exit(EXIT_FAILURE);
+    }
+
+    *topology = (Topology){1, 1, 1, {0, 0, 0},
+                           {TOPOLOGY_INTERVAL_CORE, TOPOLOGY_INTERVAL_LLC, TOPOLOGY_INTERVAL_SOCKET},
+                           TOPOLOGY_IMBALANCE_PCT};
+    char line[256], key[32], level[32];
+    int value, line_number = 0;
+    while (fgets(line, sizeof(line), file)) {
+        line_number++;
+        line[strcspn(line, "#\r\n")] = '\0';
+        if (sscanf(line, "%31s", key) != 1)
+            continue;
+
+        int valid = 0;
+        if (strcmp(key, "penalty") == 0 || strcmp(key, "interval") == 0) {
+            int *per_level = key[0] == 'p' ? topology->penalty : topology->interval;
+            if (sscanf(line, "%*s %31s %d", level, &value) == 2 && value >= (key[0] == 'p' ? 0 : 1)) {
+                for (int l = 0; l < MIGRATE_LEVELS; l++) {
+                    if (strcmp(level, level_names[l]) == 0) {
+                        per_level[l] = value;
+                        valid = 1;
+                    }
+                }
+            }
+        } else if (sscanf(line, "%*s %d", &value) == 1 && value >= 1) {
+            int *count = strcmp(key, "sockets") == 0 ? &topology->sockets :
+                         strcmp(key, "llcs") == 0 ? &topology->llcs :
+                         strcmp(key, "cores") == 0 ? &topology->cores :
+                         strcmp(key, "imbalance") == 0 ? &topology->imbalance_pct : NULL;
+            if (count) {
+                *count = value;
+                valid = 1;
+            }
+        }
+        if (!valid) {
+            fprintf(stderr, "Invalid topology file %s, line %d: %s\n", filename, line_number, line);
+            exit(EXIT_FAILURE);
+        }
+    }
+    fclose(file);
+}
+
+/**
+ * @brief Returns the number of cores of a topology.
+ */
+int topologyCpus(const Topology *topology) {
+    return topology->sockets * topology->llcs * topology->cores;
+}
+
+/**
+ * @brief Returns the level of a migration between two different cores: the
+ *        closest domain they share.
+ */
+MigrationLevel migrationLevel(const Topology *topology, int from, int to) {
+    int from_llc = from / topology->cores, to_llc = to / topology->cores;
+    if (from_llc == to_llc)
+        return MIGRATE_CORE;
+    return from_llc / topology->llcs == to_llc / topology->llcs ? MIGRATE_LLC : MIGRATE_SOCKET;
+}
+
+/**
+ * @brief Idle cores of the machine, indexed by domain.
+ *
+ * Three levels of sparse sets (a dense array plus the position of each
+ * member): the idle cores of each LLC domain, the LLC domains of each socket
+ * with an idle core, and the sockets with an idle core.  Adding, removing and
+ * picking a member are O(1), so the nearest idle core is found in O(1).
+ */
+typedef struct {
+    const Topology *topology;
+    int *core_dense, *core_where, *core_count;      ///< Idle cores of each LLC domain.
+    int *llc_dense, *llc_where, *llc_count;         ///< LLC domains with idle cores, per socket.
+    int *socket_dense, *socket_where, socket_count; ///< Sockets with idle cores.
+    char *idle;                                     ///< Whether each core is idle.
+} IdleCores;
+
+static void setAdd(int *dense, int *where, int base, int *count, int item) {
+    where[item] = base + *count;
+    dense[base + (*count)++] = item;
+}
+
+static void setRemove(int *dense, int *where, int base, int *count, int item) {
+    int last = dense[base + --(*count)];
+    dense[where[item]] = last;
+    where[last] = where[item];
+}
+
+static void markIdle(IdleCores *cores, int core) {
+    const Topology *t = cores->topology;
+    int llc = core / t->cores, socket = llc / t->llcs;
+    cores->idle[core] = 1;
+    setAdd(cores->core_dense, cores->core_where, llc * t->cores, &cores->core_count[llc], core);
+    if (cores->core_count[llc] == 1) {
+        setAdd(cores->llc_dense, cores->llc_where, socket * t->llcs, &cores->llc_count[socket], llc);
+        if (cores->llc_count[socket] == 1)
+            setAdd(cores->socket_dense, cores->socket_where, 0, &cores->socket_count, socket);
+    }
+}
+
+static void markBusy(IdleCores *cores, int core) {
+    const Topology *t = cores->topology;
+    int llc = core / t->cores, socket = llc / t->llcs;
+    cores->idle[core] = 0;
+    setRemove(cores->core_dense, cores->core_where, llc * t->cores, &cores->core_count[llc], core);
+    if (cores->core_count[llc] == 0) {
+        setRemove(cores->llc_dense, cores->llc_where, socket * t->llcs, &cores->llc_count[socket], llc);
+        if (cores->llc_count[socket] == 0)
+            setRemove(cores->socket_dense, cores->socket_where, 0, &cores->socket_count, socket);
+    }
+}
+
+/**
+ * @brief Returns the idle core nearest to `last`: itself, then its LLC domain,
+ *        then its socket, then any.  There must be an idle core.
+ */
+static int nearestIdle(const IdleCores *cores, int last) {
+    const Topology *t = cores->topology;
+    int socket = cores->socket_dense[0], llc;
+    if (last >= 0) {
+        if (cores->idle[last])
+            return last;
+        llc = last / t->cores;
+        if (cores->core_count[llc] > 0)
+            return cores->core_dense[llc * t->cores];
+        if (cores->llc_count[llc / t->llcs] > 0)
+            socket = llc / t->llcs;
+    }
+    llc = cores->llc_dense[socket * t->llcs];
+    return cores->core_dense[llc * t->cores];
+}
+
+/**
+ * @brief Round Robin on a machine with a cache and NUMA topology.
+ *
+ * @param processes An array of Process structures sorted by arrival.
+ * @param n The number of processes in the array.
+ * @param quantum The time quantum.
+ * @param topology The machine.
+ * @param placement How the head of the queue picks among the idle cores.
+ * @param stats Receives the migrations per level.
+ *
+ * @details
+ * The event loop of computeMultiRR on the cores of the topology, which it
+ * reproduces with naive placement and no penalties.  A process that resumes
+ * on another core than its last one first pays the penalty of the level the
+ * two cores share: the core stays busy for that time without progress.
+ * Affinity placement keeps the queue order and only changes the core, found
+ * in O(1) in per-domain sets of idle cores (see IdleCores).  Slices ending
+ * together are still requeued by core number, so the core a process gets can
+ * reorder simultaneous requeues.
+ */
+void computeTopologyRR(Process processes[], int n, int quantum, const Topology *topology, Placement placement,
+                       TopologyStats *stats) {
+    int cpus = topologyCpus(topology), llcs = topology->sockets * topology->llcs;
+    int *remaining = malloc(n * sizeof(int));
+    int *last = malloc(n * sizeof(int));
+    int *queue = malloc(n * sizeof(int));
+    int *running = malloc(cpus * sizeof(int));
+    int *stack = malloc(cpus * sizeof(int));
+    IdleCores idle = {topology, malloc(cpus * sizeof(int)), malloc(cpus * sizeof(int)), calloc(llcs, sizeof(int)),
+                      malloc(llcs * sizeof(int)), malloc(llcs * sizeof(int)), calloc(topology->sockets, sizeof(int)),
+                      malloc(topology->sockets * sizeof(int)), malloc(topology->sockets * sizeof(int)), 0,
+                      malloc(cpus)};
+    if ((n > 0 && (!remaining || !last || !queue)) || !running || !stack || !idle.core_dense || !idle.core_where ||
+        !idle.core_count || !idle.llc_dense || !idle.llc_where || !idle.llc_count || !idle.socket_dense ||
+        !idle.socket_where || !idle.idle) {
+        perror("Error allocating topology state");
+        exit(EXIT_FAILURE);
+    }
+    for (int i = 0; i < n; i++) {
+        remaining[i] = processes[i].burst;
+        last[i] = -1;
+        processes[i].start_time = -1;
+        processes[i].finish_time = -1;
+    }
+    // Naive placement pops the idle stack of computeMultiRR; affinity uses the sets.
+    int stack_size = cpus;
+    for (int c = 0; c < cpus; c++) {
+        stack[c] = cpus - 1 - c;
+        markIdle(&idle, c);
+    }
+
+    *stats = (TopologyStats){0};
+    MinHeap slice_end;
+    heapInit(&slice_end, cpus);
+    int front = 0, rear = -1, size = 0, idx = 0, completed = 0;
+    long long now = 0;
+
+    while (completed < n) {
+        now = slice_end.size > 0 ? slice_end.items[0].key : processes[idx].arrival;
+        if (idx < n && processes[idx].arrival < now)
+            now = processes[idx].arrival;
+
+        while (idx < n && processes[idx].arrival <= now) {
+            rear = (rear + 1) % n;
+            queue[rear] = idx++;
+            size++;
+        }
+        while (slice_end.size > 0 && slice_end.items[0].key == now) {
+            int cpu = heapPop(&slice_end).value;
+            int proc_idx = running[cpu];
+            if (remaining[proc_idx] > 0) {
+                rear = (rear + 1) % n;
+                queue[rear] = proc_idx;
+                size++;
+            } else {
+                processes[proc_idx].finish_time = (int)now;
+                completed++;
+            }
+            stack[stack_size++] = cpu;
+            markIdle(&idle, cpu);
+        }
+
+        while (stack_size > 0 && size > 0) {
+            int proc_idx = queue[front];
+            front = (front + 1) % n;
+            size--;
+
+            int cpu;
+            if (placement == PLACE_NAIVE) {
+                cpu = stack[--stack_size];
+            } else {
+                cpu = nearestIdle(&idle, last[proc_idx]);
+                stack_size--;
+            }
+            markBusy(&idle, cpu);
+
+            long long penalty = 0;
+            if (last[proc_idx] >= 0) {
+                stats->resumes++;
+                if (last[proc_idx] != cpu) {
+                    MigrationLevel level = migrationLevel(topology, last[proc_idx], cpu);
+                    stats->migrations[level]++;
+                    penalty = topology->penalty[level];
+                    stats->penalty_time += penalty;
+                }
+            }
+            last[proc_idx] = cpu;
+
+            if (processes[proc_idx].start_time == -1)
+                processes[proc_idx].start_time = (int)now;
+            int exec_time = remaining[proc_idx] < quantum ? remaining[proc_idx] : quantum;
+            remaining[proc_idx] -= exec_time;
+            running[cpu] = proc_idx;
+            heapPush(&slice_end, now + penalty + exec_time, cpu);
+        }
+    }
+    stats->makespan = (int)now;
+
+    heapFree(&slice_end);
+    free(idle.idle);
+    free(idle.socket_where);
+    free(idle.socket_dense);
+    free(idle.llc_count);
+    free(idle.llc_where);
+    free(idle.llc_dense);
+    free(idle.core_count);
+    free(idle.core_where);
+    free(idle.core_dense);
+    free(stack);
+    free(running);
+    free(queue);
+    free(last);
+    free(remaining);
+}
+
+/**
+ * @brief Prints the migrations of naive and affinity-aware placement side by side.
+ */
+void printTopologyStats(const Topology *topology, const TopologyStats *naive, const TopologyStats *affinity,
+                        FILE *out) {
+    const TopologyStats *runs[2] = {naive, affinity};
+    const char *names[2] = {"naive", "affinity"};
+    fprintf(out, "\nMigrations (%d sockets x %d LLCs x %d cores, penalties %d/%d/%d):\n", topology->sockets,
+            topology->llcs, topology->cores, topology->penalty[MIGRATE_CORE], topology->penalty[MIGRATE_LLC],
+            topology->penalty[MIGRATE_SOCKET]);
+    fprintf(out, "%-10s %12s %12s %12s %12s %14s\n", "Placement", "Resumes", "Core", "LLC", "Socket", "Penalty Time");
+    for (int r = 0; r < 2; r++)
+        fprintf(out, "%-10s %12lld %12lld %12lld %12lld %14lld\n", names[r], runs[r]->resumes,
+                runs[r]->migrations[MIGRATE_CORE], runs[r]->migrations[MIGRATE_LLC],
+                runs[r]->migrations[MIGRATE_SOCKET], runs[r]->penalty_time);
+}
@@ -0,0 +1,62 @@
+#ifndef TOPOLOGY_H
+#define TOPOLOGY_H
+
+#include <stdio.h>
+#include "process.h"
+
+#define TOPOLOGY_INTERVAL_CORE 4     ///< Default balancing interval among the cores of an LLC domain.
+#define TOPOLOGY_INTERVAL_LLC 16     ///< Default balancing interval among the LLC domains of a socket.
+#define TOPOLOGY_INTERVAL_SOCKET 64  ///< Default balancing interval among sockets.
+#define TOPOLOGY_IMBALANCE_PCT 125   ///< Default busiest-to-idlest load ratio, in percent, worth balancing.
+
+/**
+ * @brief How far a process moved when it resumes on another core.
+ */
+typedef enum {
+    MIGRATE_CORE,   ///< Another core sharing the last-level cache.
+    MIGRATE_LLC,    ///< Another last-level cache domain of the same socket.
+    MIGRATE_SOCKET, ///< Another socket (NUMA node).
+    MIGRATE_LEVELS
+} MigrationLevel;
+
+/**
+ * @brief A symmetric machine: sockets of LLC domains of cores.
+ *
+ * Core c belongs to LLC domain c / cores and socket c / (cores * llcs).
+ */
+typedef struct {
+    int sockets;                  ///< Sockets of the machine.
+    int llcs;                     ///< LLC domains per socket.
+    int cores;                    ///< Cores per LLC domain.
+    int penalty[MIGRATE_LEVELS];  ///< Time lost refilling caches after a migration.
+    int interval[MIGRATE_LEVELS]; ///< Period of load balancing within each level's domains.
+    int imbalance_pct;            ///< Balance only if busiest load * 100 > idlest load * this.
+} Topology;
+
+/**
+ * @brief How an idle core is chosen for the process at the head of the queue.
+ */
+typedef enum {
+    PLACE_NAIVE,    ///< Whichever core went idle last.
+    PLACE_AFFINITY  ///< The last core of the process if idle, else the nearest idle one.
+} Placement;
+
+/**
+ * @brief Migrations of a run on a topology.
+ */
+typedef struct {
+    long long resumes;                     ///< Slices of processes that had run before.
+    long long migrations[MIGRATE_LEVELS];  ///< Resumes on another core, by distance.
+    long long penalty_time;                ///< Time lost to migration penalties.
+    int makespan;                          ///< Finish time of the last process.
+} TopologyStats;
+
+void loadTopology(const char *filename, Topology *topology);
+int topologyCpus(const Topology *topology);
+MigrationLevel migrationLevel(const Topology *topology, int from, int to);
+void computeTopologyRR(Process processes[], int n, int quantum, const Topology *topology, Placement placement,
+                       TopologyStats *stats);
+void printTopologyStats(const Topology *topology, const TopologyStats *naive, const TopologyStats *affinity,
+                        FILE *out);
+
+#endif
@@ -0,0 +1,46 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include "treap.h"
+
+/**
+ * @brief Hashes a node index into a treap priority (lowbias32).
+ */
+unsigned mixIndex(unsigned x) {
+    x ^= x >> 16;
+    x *= 0x7feb352dU;
+    x ^= x >> 15;
+    x *= 0x846ca68bU;
+    x ^= x >> 16;
+    return x;
+}
+
+/**
+ * @brief Initializes an empty treap over the nodes 0..capacity-1.
+ */
+void treapInit(IndexTreap *treap, int capacity) {
+    treap->root = -1;
+    treap->links = malloc((capacity > 0 ? capacity : 1) * sizeof(TreapLink));
+    if (!treap->links) {
+        perror("Error allocating treap");
+        exit(EXIT_FAILURE);
+    }
+}
+
+/**
+ * @brief Releases the links of a treap.
+ */
+void treapFree(IndexTreap *treap) {
+    free(treap->links);
+    treap->links = NULL;
+    treap->root = -1;
+}
+
+/**
+ * @brief Returns the first node in order, or -1 if the treap is empty.
+ */
+int treapFirst(const IndexTreap *treap) {
+    int t = treap->root;
+    while (t >= 0 && treap->links[t].left >= 0)
+        t = treap->links[t].left;
+    return t;
+}
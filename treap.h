@@ -0,0 +1,125 @@
+#ifndef TREAP_H
+#define TREAP_H
+
+/**
+ * @brief Links of one node of an IndexTreap.
+ */
+typedef struct {
+    int left, right;   ///< Children, -1 if none.
+    unsigned priority; ///< Heap priority, a hash of the node's index.
+} TreapLink;
+
+/**
+ * @brief Returns non-zero if node a comes before node b; must be a strict total order.
+ */
+typedef int (*TreapBefore)(const void *context, int a, int b);
+
+/**
+ * @brief Recomputes the subtree summary of node t from its own data and its children's.
+ */
+typedef void (*TreapPull)(void *context, int t);
+
+/**
+ * @brief A treap whose nodes are the indices 0..capacity-1, so nothing is allocated per node.
+ *
+ * The order of the nodes and what each node summarizes of its subtree are up
+ * to the user, through the TreapOps passed to every update: before compares
+ * two nodes and pull, called bottom-up on every node whose children change,
+ * refreshes the summary.  The updates are static inline so that each user
+ * gets them specialized to its own order and summary, without an indirect
+ * call per node visited.
+ */
+typedef struct {
+    int root;         ///< Root node, -1 when empty.
+    TreapLink *links; ///< Links of each node.
+} IndexTreap;
+
+/**
+ * @brief Order and subtree summary of an IndexTreap, and their shared context.
+ */
+typedef struct {
+    TreapBefore before; ///< Order of the nodes.
+    TreapPull pull;     ///< Summary of a subtree.
+    void *context;      ///< Passed to before and pull.
+} TreapOps;
+
+unsigned mixIndex(unsigned x);
+void treapInit(IndexTreap *treap, int capacity);
+void treapFree(IndexTreap *treap);
+int treapFirst(const IndexTreap *treap);
+
+/**
+ * @brief Splits subtree t into the nodes before node k and the rest.
+ */
+static inline void treapSplit(TreapLink *links, TreapOps ops, int t, int k, int *l, int *r) {
+    if (t < 0) {
+        *l = *r = -1;
+        return;
+    }
+    if (ops.before(ops.context, t, k)) {
+        treapSplit(links, ops, links[t].right, k, &links[t].right, r);
+        *l = t;
+    } else {
+        treapSplit(links, ops, links[t].left, k, l, &links[t].left);
+        *r = t;
+    }
+    ops.pull(ops.context, t);
+}
+
+/**
+ * @brief Joins two subtrees, every node of a coming before every node of b.
+ */
+static inline int treapMerge(TreapLink *links, TreapOps ops, int a, int b) {
+    if (a < 0)
+        return b;
+    if (b < 0)
+        return a;
+    if (links[a].priority > links[b].priority) {
+        links[a].right = treapMerge(links, ops, links[a].right, b);
+        ops.pull(ops.context, a);
+        return a;
+    }
+    links[b].left = treapMerge(links, ops, a, links[b].left);
+    ops.pull(ops.context, b);
+    return b;
+}
+
+/**
+ * @brief Removes the first node of subtree t and returns the new subtree.
+ */
+static inline int treapCutFirst(TreapLink *links, TreapOps ops, int t) {
+    if (links[t].left < 0)
+        return links[t].right;
+    links[t].left = treapCutFirst(links, ops, links[t].left);
+    ops.pull(ops.context, t);
+    return t;
+}
+
+/**
+ * @brief Inserts node i, whose order keys must already be set.
+ */
+static inline void treapInsert(IndexTreap *treap, TreapOps ops, int i) {
+    int l, r;
+    treap->links[i] = (TreapLink){-1, -1, mixIndex((unsigned)i)};
+    ops.pull(ops.context, i);
+    treapSplit(treap->links, ops, treap->root, i, &l, &r);
+    treap->root = treapMerge(treap->links, ops, treapMerge(treap->links, ops, l, i), r);
+}
+
+/**
+ * @brief Removes node i, which must be in the treap with unchanged order keys.
+ */
+static inline void treapRemove(IndexTreap *treap, TreapOps ops, int i) {
+    int l, r;
+    treapSplit(treap->links, ops, treap->root, i, &l, &r);
+    treap->root = treapMerge(treap->links, ops, l, treapCutFirst(treap->links, ops, r));
+}
+
+/**
+ * @brief Removes the first node in order; the treap must not be empty.
+ */
+static inline void treapRemoveFirst(IndexTreap *treap, TreapOps ops) {
+    treap->root = treapCutFirst(treap->links, ops, treap->root);
+}
+
+#endif
@@ -0,0 +1,334 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <sys/inotify.h>
+#include "watch.h"
+#include "schema.h"
+
+/**
+ * @brief Appends a process index to the ready queue, doubling it when full.
+ */
+static void queuePush(ReadyQueue *queue, int proc_idx) {
+    if (queue->size == queue->capacity) {
+        int capacity = queue->capacity ? queue->capacity * 2 : 1024;
+        int *slots = malloc(capacity * sizeof(int));
+        if (!slots) {
+            perror("Error allocating ready queue");
+            exit(EXIT_FAILURE);
+        }
+        for (int i = 0; i < queue->size; i++)
+            slots[i] = queue->slots[(queue->front + i) % queue->capacity];
+        free(queue->slots);
+        queue->slots = slots;
+        queue->capacity = capacity;
+        queue->front = 0;
+    }
+    queue->slots[(queue->front + queue->size) % queue->capacity] = proc_idx;
+    queue->size++;
+}
+
+/**
+ * @brief Removes and returns the oldest process index of the ready queue.
+ */
+static int queuePop(ReadyQueue *queue) {
+    int proc_idx = queue->slots[queue->front];
+    queue->front = (queue->front + 1) % queue->capacity;
+    queue->size--;
+    return proc_idx;
+}
+
+/**
+ * @brief Initializes an empty incremental simulation.
+ *
+ * @param sim The simulation to initialize.
+ * @param quantum The RR time quantum.
+ */
+void initIncrementalSim(IncrementalSim *sim, int quantum) {
+    memset(sim, 0, sizeof(*sim));
+    sim->quantum = quantum;
+    sim->rr_running = -1;
+}
+
+/**
+ * @brief Releases the memory owned by an incremental simulation.
+ */
+void freeIncrementalSim(IncrementalSim *sim) {
+    free(sim->processes);
+    free(sim->rr_start);
+    free(sim->rr_finish);
+    free(sim->queue.slots);
+}
+
+/**
+ * @brief Adds a newly read process and schedules it under FCFS right away.
+ *
+ * @param sim The simulation.
+ * @param process The parsed process.
+ *
+ * @details
+ * FCFS needs nothing but the CPU's free time to place a new arrival, so its
+ * schedule is always complete.  A process arriving before the previous one is
+ * moved to the previous arrival time, since the RR state may already be past it.
+ */
+void addProcess(IncrementalSim *sim, const Process *process) {
+    if (sim->n == sim->capacity) {
+        sim->capacity = sim->capacity ? sim->capacity * 2 : 1024;
+        sim->processes = realloc(sim->processes, sim->capacity * sizeof(Process));
+        sim->rr_start = realloc(sim->rr_start, sim->capacity * sizeof(int));
+        sim->rr_finish = realloc(sim->rr_finish, sim->capacity * sizeof(int));
+        if (!sim->processes || !sim->rr_start || !sim->rr_finish) {
+            perror("Error allocating process table");
+            exit(EXIT_FAILURE);
+        }
+    }
+
+    Process *p = &sim->processes[sim->n];
+    *p = *process;
+    if (sim->n > 0 && p->arrival < sim->processes[sim->n - 1].arrival) {
+        fprintf(stderr, "Process %d arrives out of order, delayed to %d\n",
+                p->id, sim->processes[sim->n - 1].arrival);
+        p->arrival = sim->processes[sim->n - 1].arrival;
+    }
+
+    if (p->arrival > sim->fcfs_time)
+        sim->fcfs_time = p->arrival;
+    p->start_time = sim->fcfs_time;
+    p->finish_time = sim->fcfs_time + p->burst;
+    sim->fcfs_time = p->finish_time;
+    sim->fcfs_tat += p->finish_time - p->arrival;
+    sim->fcfs_rt += p->start_time - p->arrival;
+
+    sim->rr_start[sim->n] = -1;
+    sim->rr_finish[sim->n] = -1;
+    sim->n++;
+}
+
+/**
+ * @brief Queues every known process that has arrived by the RR clock.
+ */
+static void queueArrivals(IncrementalSim *sim) {
+    while (sim->rr_next < sim->n && sim->processes[sim->rr_next].arrival <= sim->rr_time)
+        queuePush(&sim->queue, sim->rr_next++);
+}
+
+/**
+ * @brief Advances the RR schedule as far as the processes read so far determine it.
+ *
+ * @param sim The simulation.
+ *
+ * @details
+ * Follows computeRR step by step, except that idle time is skipped in one jump.
+ * A slice is executed as soon as the queue is non-empty, but requeuing the
+ * preempted process waits until an arrival after the end of the slice is known.
+ */
+void advanceSimulation(IncrementalSim *sim) {
+    if (sim->n == 0)
+        return;
+    int last_arrival = sim->processes[sim->n - 1].arrival;
+
+    for (;;) {
+        if (sim->rr_running >= 0) {
+            if (sim->rr_time >= last_arrival)
+                break;
+            queueArrivals(sim);
+            if (sim->processes[sim->rr_running].remaining > 0)
+                queuePush(&sim->queue, sim->rr_running);
+            sim->rr_running = -1;
+        }
+
+        if (sim->queue.size == 0) {
+            if (sim->rr_next == sim->n)
+                break;
+            if (sim->processes[sim->rr_next].arrival > sim->rr_time)
+                sim->rr_time = sim->processes[sim->rr_next].arrival;
+            queueArrivals(sim);
+        }
+
+        int proc_idx = queuePop(&sim->queue);
+        Process *p = &sim->processes[proc_idx];
+        if (sim->rr_start[proc_idx] == -1)
+            sim->rr_start[proc_idx] = sim->rr_time;
+
+        int exec_time = (p->remaining < sim->quantum) ? p->remaining : sim->quantum;
+        p->remaining -= exec_time;
+        sim->rr_time += exec_time;
+        sim->rr_running = proc_idx;
+
+        if (p->remaining == 0) {
+            sim->rr_finish[proc_idx] = sim->rr_time;
+            sim->rr_completed++;
+            sim->rr_tat += sim->rr_time - p->arrival;
+            sim->rr_rt += sim->rr_start[proc_idx] - p->arrival;
+            if (sim->rr_time > sim->rr_max_finish)
+                sim->rr_max_finish = sim->rr_time;
+        }
+    }
+}
+
+/**
+ * @brief Writes the metrics of the processes completed so far under FCFS and RR.
+ *
+ * @param sim The simulation.
+ * @param format The output format (text or CSV).
+ */
+void writeIncrementalMetrics(const IncrementalSim *sim, OutputFormat format) {
+    int n = sim->n, done = sim->rr_completed;
+    writeMetrics(stdout, format, "fcfs", 0, n,
+                 n ? (float)sim->fcfs_tat / n : 0, n ? (float)sim->fcfs_rt / n : 0,
+                 sim->fcfs_time ? (float)n / sim->fcfs_time : 0, NULL);
+    writeMetrics(stdout, format, "rr", sim->quantum, done,
+                 done ? (float)sim->rr_tat / done : 0, done ? (float)sim->rr_rt / done : 0,
+                 sim->rr_max_finish ? (float)done / sim->rr_max_finish : 0, NULL);
+    if (format == FORMAT_TEXT)
+        printf("(%d processes read, RR clock at %d)\n", n, sim->rr_time);
+    fflush(stdout);
+}
+
+/**
+ * @brief Publishes the metrics of the processes completed so far and an RR progress sample.
+ */
+static void publishIncrementalMetrics(const IncrementalSim *sim, Publisher *publisher) {
+    int n = sim->n, done = sim->rr_completed;
+    float rr_tat = done ? (float)sim->rr_tat / done : 0, rr_rt = done ? (float)sim->rr_rt / done : 0;
+    publishMetrics(publisher, "fcfs", 0, n, n ? (float)sim->fcfs_tat / n : 0,
+                   n ? (float)sim->fcfs_rt / n : 0, sim->fcfs_time ? (float)n / sim->fcfs_time : 0);
+    publishMetrics(publisher, "rr", sim->quantum, done, rr_tat, rr_rt,
+                   sim->rr_max_finish ? (float)done / sim->rr_max_finish : 0);
+    publishSample(publisher, "rr", sim->rr_time, done, rr_tat, rr_rt);
+}
+
+/**
+ * @brief Feeds every complete line of buf[0, len) to the simulation; the first one is the header.
+ *
+ * @param lines The lines of the trace fed so far, updated.
+ * @return The number of bytes consumed; the rest is a partial line.
+ */
+static size_t feedLines(IncrementalSim *sim, char *buf, size_t len, TraceSchema *schema, int *lines) {
+    size_t begin = 0;
+    for (;;) {
+        char *newline = memchr(buf + begin, '\n', len - begin);
+        if (!newline)
+            return begin;
+        *newline = '\0';
+
+        Process process;
+        if ((*lines)++ == 0)
+            parseSchema(buf + begin, newline, FIELDS_REQUIRED, schema);
+        else if (parseProcessLine(schema, buf + begin, *lines, &process))
+            addProcess(sim, &process);
+        begin = (size_t)(newline - buf) + 1;
+    }
+}
+
+/**
+ * @brief Returns non-zero if a batch of inotify events says the file is gone.
+ */
+static int traceGone(const char *events, ssize_t len) {
+    const char *e = events;
+    while (e < events + len) {
+        const struct inotify_event *event = (const struct inotify_event *)e;
+        if (event->mask & (IN_DELETE_SELF | IN_MOVE_SELF | IN_IGNORED))
+            return 1;
+        e += sizeof(struct inotify_event) + event->len;
+    }
+    return 0;
+}
+
+/**
+ * @brief Follows a growing trace file and refreshes the metrics on every append.
+ *
+ * @param filename The trace file to follow.
+ * @param quantum The RR time quantum.
+ * @param format The output format (text or CSV).
+ * @param publisher Where to publish every refresh, or NULL.
+ * @return EXIT_SUCCESS when the file is removed or replaced, EXIT_FAILURE on errors.
+ *
+ * @details
+ * The file is read once up to its current end, then inotify reports every
+ * modification and only the bytes appended since the last read are parsed.
+ * A partial last line is kept until its newline arrives.  The FCFS and RR
+ * states continue from where they stopped, so each refresh costs time
+ * proportional to the new data, not to the whole trace.
+ */
+int watchTrace(const char *filename, int quantum, OutputFormat format, Publisher *publisher) {
+    int fd = open(filename, O_RDONLY);
+    if (fd < 0) {
+        perror("Error opening file");
+        return EXIT_FAILURE;
+    }
+    int notify_fd = inotify_init1(IN_CLOEXEC);
+    if (notify_fd < 0 || inotify_add_watch(notify_fd, filename,
+                                           IN_MODIFY | IN_DELETE_SELF | IN_MOVE_SELF) < 0) {
+        perror("Error watching file");
+        close(fd);
+        return EXIT_FAILURE;
+    }
+
+    IncrementalSim sim;
+    initIncrementalSim(&sim, quantum);
+    size_t capacity = 1 << 16, len = 0;
+    char *buf = malloc(capacity);
+    char events[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+    off_t offset = 0;
+    TraceSchema schema;
+    int lines = 0, status = EXIT_SUCCESS;
+
+    writeMetricsBegin(stdout, format);
+    for (;;) {
+        struct stat st;
+        if (fstat(fd, &st) == 0 && st.st_size < offset) {
+            fprintf(stderr, "Trace file was truncated, stopping\n");
+            status = EXIT_FAILURE;
+            break;
+        }
+
+        int before = sim.n;
+        ssize_t got;
+        for (;;) {
+            if (len == capacity) {
+                capacity *= 2;
+                buf = realloc(buf, capacity);
+            }
+            if (!buf) {
+                perror("Error allocating read buffer");
+                exit(EXIT_FAILURE);
+            }
+            got = read(fd, buf + len, capacity - len);
+            if (got <= 0)
+                break;
+            offset += got;
+            len += (size_t)got;
+            size_t used = feedLines(&sim, buf, len, &schema, &lines);
+            memmove(buf, buf + used, len - used);
+            len -= used;
+        }
+        if (got < 0) {
+            perror("Error reading file");
+            status = EXIT_FAILURE;
+            break;
+        }
+
+        if (sim.n > before) {
+            advanceSimulation(&sim);
+            writeIncrementalMetrics(&sim, format);
+            if (publisher)
+                publishIncrementalMetrics(&sim, publisher);
+        }
+
+        ssize_t event_len = read(notify_fd, events, sizeof(events));
+        if (event_len <= 0)
+            break;
+        if (traceGone(events, event_len))
+            break;
+    }
+    writeMetricsEnd(stdout, format);
+
+    free(buf);
+    freeIncrementalSim(&sim);
+    close(notify_fd);
+    close(fd);
+    return status;
+}
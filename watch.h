@@ -0,0 +1,56 @@
+#ifndef WATCH_H
+#define WATCH_H
+
+#include "process.h"
+#include "output.h"
+#include "publish.h"
+
+/**
+ * @brief Ready queue that grows as processes arrive (a ring buffer).
+ */
+typedef struct {
+    int *slots;    ///< Queued process indices.
+    int capacity;  ///< Number of slots.
+    int front;     ///< Position of the oldest entry.
+    int size;      ///< Number of queued entries.
+} ReadyQueue;
+
+/**
+ * @brief FCFS and RR simulation state that can be advanced as a trace grows.
+ *
+ * Arrivals are assumed to be non-decreasing in file order.  The RR engine only
+ * advances as far as the known arrivals determine the schedule: after a slice
+ * ending at time t it waits until an arrival later than t has been read, since
+ * a process arriving at or before t would have to be queued ahead of the
+ * preempted one.
+ */
+typedef struct {
+    Process *processes;   ///< Every process read so far; start/finish hold the FCFS schedule.
+    int n;                ///< Number of processes read so far.
+    int capacity;         ///< Capacity of processes and of the RR arrays.
+    int quantum;          ///< RR time quantum.
+
+    int fcfs_time;        ///< Time at which the FCFS CPU becomes free.
+    long long fcfs_tat;   ///< Sum of FCFS turnaround times.
+    long long fcfs_rt;    ///< Sum of FCFS response times.
+
+    int *rr_start;        ///< RR start time of every process, -1 if not started.
+    int *rr_finish;       ///< RR finish time of every process, -1 if not finished.
+    ReadyQueue queue;     ///< RR ready queue.
+    int rr_time;          ///< RR clock.
+    int rr_next;          ///< First process not yet queued by RR.
+    int rr_running;       ///< Process whose slice ended at rr_time, -1 if none.
+    int rr_completed;     ///< Number of processes RR has completed.
+    int rr_max_finish;    ///< Latest RR finish time.
+    long long rr_tat;     ///< Sum of RR turnaround times of completed processes.
+    long long rr_rt;      ///< Sum of RR response times of completed processes.
+} IncrementalSim;
+
+void initIncrementalSim(IncrementalSim *sim, int quantum);
+void freeIncrementalSim(IncrementalSim *sim);
+void addProcess(IncrementalSim *sim, const Process *process);
+void advanceSimulation(IncrementalSim *sim);
+void writeIncrementalMetrics(const IncrementalSim *sim, OutputFormat format);
+int watchTrace(const char *filename, int quantum, OutputFormat format, Publisher *publisher);
+
+#endif